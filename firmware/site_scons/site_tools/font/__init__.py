@@ -58,6 +58,9 @@ def build_function(target, source, env):
         '-m'
     ]
 
+    if env.get('COMPRESSED_FONT', False):
+        generator_options.append('-c')
+
     # Since SCons does not support python 3 subproces is used as a workaround.
     subprocess.check_call(generator_options)
 
@@ -66,7 +69,8 @@ def build_function(target, source, env):
 
 def _get_font_builder():
     return SCons.Builder.Builder(
-        action=SCons.Action.Action(build_function, '${FONT_COMSTR}')
+        action=SCons.Action.Action(build_function, '${FONT_COMSTR}',
+                                   varlist=['COMPRESSED_FONT'])
     )
 
 
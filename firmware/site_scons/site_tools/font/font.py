@@ -55,6 +55,16 @@ class Font(object):
         else:
             return None
 
+    @property
+    def ascent(self):
+        """Property for the largest number of rows a glyph reaches above the baseline."""
+        return max([g.offset + g.height for g in self._glyphs] + [0])
+
+    @property
+    def descent(self):
+        """Property for the largest number of rows a glyph reaches below the baseline."""
+        return max([-g.offset for g in self._glyphs] + [0])
+
     def add_chars(self, chars):
         """Create glyph objects for the added chars and add them to the font."""
         for char in chars:
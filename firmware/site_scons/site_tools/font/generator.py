@@ -16,7 +16,6 @@
 
 import os
 import sys
-import math
 import string
 import datetime
 import argparse
@@ -52,6 +51,37 @@ def byte_array_to_line(byte_array):
     return line
 
 
+def char_ranges(glyphs):
+    """Group glyphs, sorted by char value, into ranges of consecutive chars."""
+    ranges = []
+
+    for index, g in enumerate(glyphs):
+        if ranges and ord(g.char) == ranges[-1][1] + 1:
+            ranges[-1][1] = ord(g.char)
+        else:
+            ranges.append([ord(g.char), ord(g.char), index])
+
+    return ranges
+
+
+def packed_glyph_info_lines(g, offset, monospace):
+    """Glyph information for the compressed format, size and position packed in nibbles."""
+    assert 0 <= g.width < 16 and 0 <= g.height < 16, 'Glyph too large for the compressed format'
+    assert -8 <= g.offset < 8 and 0 <= g.horizontal_bearing < 16, 'Glyph position out of range'
+
+    lines = []
+    lines.append('{\n')
+    lines.append('    .data_offset = {},\n'.format(offset))
+    lines.append('    .size = 0x{:02X},\n'.format((g.width << 4) | g.height))
+    lines.append('    .position = 0x{:02X},\n'.format(((g.offset & 0x0F) << 4) | g.horizontal_bearing))
+
+    if not monospace:
+        lines.append('    .advance = {},\n'.format(int(g.advance)))
+    lines.append('},\n')
+
+    return lines
+
+
 def main(args):
     f = Font(args.font, args.size, args.monospace)
     f.add_chars(string.ascii_letters)
@@ -59,7 +89,6 @@ def main(args):
     f.add_chars(' -:%./_')
 
     offset = 0
-    index = 0
 
     now = datetime.datetime.now()
 
@@ -69,16 +98,31 @@ def main(args):
     data['brief'] = 'Font data for Ubuntu Mono.'
     data['font_name'] = 'Ubuntu Mono {}.'.format(args.size)
     data['font_advance'] = f.advance
+    data['font_ascent'] = f.ascent
+    data['font_descent'] = f.descent
     data['monospace_font'] = int(args.monospace)
+    data['compressed_font'] = int(args.compressed)
 
     glyph_data_lines = []
     glyph_info_lines = []
-    glyph_offset_lines = []
+    glyph_range_lines = []
+
+    glyphs = sorted(f, key=lambda g: ord(g.char))
 
-    for g in f:
-        l = '    ' + byte_array_to_line(g.to_byte_array()) + '// \'{}\'\n'.format(g.char)
+    for g in glyphs:
+        if args.compressed:
+            glyph_bytes = g.to_column_bitstream()
+        else:
+            glyph_bytes = g.to_page_array()
+
+        l = '    ' + byte_array_to_line(glyph_bytes) + '// \'{}\'\n'.format(g.char)
         glyph_data_lines.append(l)
 
+        if args.compressed:
+            glyph_info_lines.extend(packed_glyph_info_lines(g, offset, f.monospace))
+            offset = offset + len(glyph_bytes)
+            continue
+
         glyph_info_lines.append('{\n');
         glyph_info_lines.append('    .data = &glyph_data[{}],\n'.format(offset))
         glyph_info_lines.append('    .width = {},\n'.format(g.width))
@@ -89,17 +133,15 @@ def main(args):
         if not f.monospace:
             glyph_info_lines.append('    .advance = {},\n'.format(g.advance))
         glyph_info_lines.append('},\n');
-        glyph_offset_lines.append('        case \'{}\':\n'.format(g.char))
-        glyph_offset_lines.append('            glyph_offset = {};\n'.format(index))
-        glyph_offset_lines.append('            break;\n')
-        req_bytes = math.ceil(g.height * g.width / 8)
+        offset = offset + len(glyph_bytes)
 
-        offset = offset + req_bytes
-        index = index + 1
+    for first, last, index in char_ranges(glyphs):
+        glyph_range_lines.append('    {{0x{:02X}, 0x{:02X}, {}}}, // \'{}\' - \'{}\'\n'.format(
+            first, last, index, chr(first), chr(last)))
 
     data['glyph_data'] = to_string(glyph_data_lines)
     data['glyph_info'] = to_string(glyph_info_lines)
-    data['glyph_offset'] = to_string(glyph_offset_lines)
+    data['glyph_ranges'] = to_string(glyph_range_lines)
 
     content = generate_file(data, args.template)
     with open(args.output, 'w') as f:
@@ -118,6 +160,9 @@ if __name__ == '__main__':
 
     parser.add_argument('-m', '--monospace', help='Select if the font is monospace or not.',
         action='store_true')
+    parser.add_argument('-c', '--compressed',
+        help='Store glyphs as unpadded column bit streams with packed glyph information.',
+        action='store_true')
 
     args = parser.parse_args()
     exit(main(args))
@@ -149,3 +149,48 @@ class Glyph(object):
             array.append(data)
 
         return array
+
+    def to_column_bitstream(self):
+        """Convert the glyph bitmap into a column-major bit stream without padding.
+
+        The rows of each column follow directly after the previous column, starting with the
+        top row in the least significant bit of the first byte. Only the last byte is padded.
+        """
+        array = []
+        data = 0
+        bit_index = 0
+
+        for x_pixel in range(self.width):
+            for y_pixel in range(self.height):
+                data |= (self.data[y_pixel * self.width + x_pixel] << bit_index)
+                bit_index += 1
+
+                if bit_index == 8:
+                    array.append(data)
+                    data = 0
+                    bit_index = 0
+
+        if bit_index > 0:
+            array.append(data)
+
+        return array
+
+    def to_page_array(self):
+        """Convert the glyph bitmap into a column-major, page packed byte array.
+
+        Each column is stored as one byte per eight rows with the top row in the least
+        significant bit, the same layout as the display VRAM.
+        """
+        array = []
+        pages = math.ceil(self.height / 8)
+
+        for x_pixel in range(self.width):
+            for page in range(pages):
+                data = 0
+                for bit in range(8):
+                    y_pixel = page * 8 + bit
+                    if y_pixel < self.height and self.data[y_pixel * self.width + x_pixel]:
+                        data |= (1 << bit)
+                array.append(data)
+
+        return array
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import os
+import subprocess
+
+import SCons.Builder
+import SCons.Action
+
+__author__ = 'andreas.dahlberg90@gmail.com (Andreas Dahlberg)'
+__version__ = '0.1.0'
+
+
+class ThermistorGeneratorNotFound(SCons.Warnings.SConsWarning):
+    pass
+
+
+def _detect(env):
+    """Check if the thermistor table generator is available."""
+    try:
+        return env['THERMISTOR']
+    except KeyError:
+        pass
+
+    generator = env.WhereIs('thermistor.py', os.path.join('..', 'scripts'))
+    if generator:
+        return generator
+
+    raise SCons.Errors.StopError(
+        ThermistorGeneratorNotFound,
+        "Could not detect the thermistor table generator")
+
+
+def build_function(target, source, env):
+    """Call the thermistor table generator."""
+    assert len(target) == 1
+    assert len(source) == 1
+
+    generator_options = [
+        env['THERMISTOR'],
+        source[0].abspath,
+        target[0].abspath
+    ]
+
+    # Since SCons does not support python 3 subproces is used as a workaround.
+    subprocess.check_call(generator_options)
+
+    return None
+
+
+def _get_thermistor_builder():
+    return SCons.Builder.Builder(
+        action=SCons.Action.Action(build_function, '${THERMISTOR_COMSTR}')
+    )
+
+
+def generate(env):
+    """Add builders and construction variables to the environment."""
+
+    env['THERMISTOR'] = _detect(env)
+    env.Append(BUILDERS={
+        'Thermistor': _get_thermistor_builder()
+    })
+
+
+def exists(env):
+    """Check if the thermistor table generator exists."""
+    return _detect(env)
+
+
+SCons.Warnings.enableWarningClass(ThermistorGeneratorNotFound)
@@ -1,7 +1,7 @@
 /**
  * @file   ADC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2017-07-28 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of the ADC interface.
  *
  * Detailed description of file.
@@ -96,6 +96,65 @@ void ADC_Convert(struct adc_channel_t *channel, uint16_t *samples, size_t length
     return;
 }
 
+///
+/// @brief Initialize an ADC channel and add it to the scan list.
+///
+/// @param  channel Pointer to channel struct.
+/// @param  index Index of the ADC channel.
+/// @param  extra_bits Bits of resolution added by oversampling each scan 4^extra_bits times.
+/// @param  callback Called from the ADC ISR when a new result is ready, can be NULL.
+///
+/// @return None
+///
+void ADC_InitScanChannel(struct adc_channel_t *channel,
+                         uint8_t index,
+                         uint8_t extra_bits,
+                         driver_adc_callback_t callback)
+{
+    driverADC_InitChannel(channel, index, callback);
+    driverADC_AddToScan(channel, extra_bits);
+    return;
+}
+
+///
+/// @brief Start a scan of all registered channels. Does not block.
+///
+/// @param  None
+/// @return None
+///
+void ADC_StartScan(void)
+{
+    driverADC_StartScan();
+    return;
+}
+
+///
+/// @brief Get the latest scan result of a channel.
+///
+/// @param  channel Pointer to channel struct.
+/// @param  value Pointer to variable where the averaged value will be stored.
+///
+/// @return True if a new result was available, otherwise false.
+///
+bool ADC_GetScanResult(struct adc_channel_t *channel, uint16_t *value)
+{
+    return driverADC_GetScanResult(channel, value);
+}
+
+///
+/// @brief Perform an oversampled conversion with the CPU sleeping in ADC
+///        noise reduction mode. Blocks until the conversion is done.
+///
+/// @param  channel Pointer to channel struct.
+/// @param  extra_bits Bits of resolution added by oversampling 4^extra_bits times.
+///
+/// @return Result with ADC_RESOLUTION_BITS + extra_bits bits.
+///
+uint16_t ADC_ConvertQuiet(struct adc_channel_t *channel, uint8_t extra_bits)
+{
+    return driverADC_ConvertQuiet(channel, extra_bits);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
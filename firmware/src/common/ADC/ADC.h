@@ -1,7 +1,7 @@
 /**
  * @file   ADC.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2017-07-28 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header for the ADC interface.
  *
  * Detailed description of file.
@@ -48,5 +48,12 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 void ADC_Init(void);
 void ADC_InitChannel(struct adc_channel_t *channel, uint8_t index);
 void ADC_Convert(struct adc_channel_t *channel, uint16_t *samples, size_t length);
+void ADC_InitScanChannel(struct adc_channel_t *channel,
+                         uint8_t index,
+                         uint8_t extra_bits,
+                         driver_adc_callback_t callback);
+void ADC_StartScan(void);
+bool ADC_GetScanResult(struct adc_channel_t *channel, uint16_t *value);
+uint16_t ADC_ConvertQuiet(struct adc_channel_t *channel, uint8_t extra_bits);
 
 #endif
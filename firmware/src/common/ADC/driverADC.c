@@ -1,7 +1,7 @@
 /**
  * @file   driverADC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-05 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of low a level ADC driver.
  *
  * Detailed description of file.
@@ -33,9 +33,13 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
 
 #include "driverADC.h"
+#include "driverUART.h"
 #include "libDebug.h"
+#include "libSPI.h"
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
@@ -43,6 +47,11 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define MAX_ADC_CHANNEL_INDEX 8
 
+// In free running mode the conversion in progress when the channel is
+// switched still belongs to the previous channel. The first conversion
+// after enabling the ADC is discarded the same way.
+#define SETTLING_DISCARD 1
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -53,6 +62,20 @@ struct driver_adc_t
     uint16_t *buffer;
     size_t length;
     size_t index;
+    struct
+    {
+        struct adc_channel_t *first;
+        struct adc_channel_t * volatile current;
+        uint16_t sum;
+        uint8_t count;
+        uint8_t discard;
+    } scan;
+    struct
+    {
+        bool active;
+        volatile bool done;
+        volatile uint16_t value;
+    } quiet;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -65,9 +88,26 @@ static struct driver_adc_t module;
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
+static void ScanConversionDone(uint16_t value);
+
 ISR(ADC_vect)
 {
-    module.buffer[module.index] = ADCL | (ADCH << 8);
+    const uint16_t value = ADCL | (ADCH << 8);
+
+    if (module.scan.current != NULL)
+    {
+        ScanConversionDone(value);
+        return;
+    }
+
+    if (module.quiet.active)
+    {
+        module.quiet.value = value;
+        module.quiet.done = true;
+        return;
+    }
+
+    module.buffer[module.index] = value;
     ++module.index;
 
     if (module.length == module.index)
@@ -77,7 +117,7 @@ ISR(ADC_vect)
 
         if (module.channel->callback != NULL)
         {
-            module.channel->callback((uint8_t)module.index);
+            module.channel->callback(module.channel);
         }
     }
 }
@@ -89,6 +129,10 @@ ISR(ADC_vect)
 static inline void EnableADC(void);
 static inline void StartConversion(void);
 static inline void SelectChannel(uint8_t index);
+static inline uint8_t NumberOfSamples(uint8_t extra_bits);
+static inline uint16_t Decimate(uint16_t sum, uint8_t extra_bits);
+static bool IsQuietSleepAllowed(void);
+static void QuietConversion(void);
 
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
@@ -106,6 +150,9 @@ void driverADC_Init(void)
     module.buffer = NULL;
     module.length = 0;
     module.index = 0;
+    module.scan.first = NULL;
+    module.scan.current = NULL;
+    module.quiet.active = false;
 
     // Enable auto trigger, enable interrupts and set the prescaler to 128(115 KHz).
     ADCSRA = ((1 << ADATE) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0));
@@ -131,8 +178,12 @@ void driverADC_InitChannel(struct adc_channel_t *channel,
     sc_assert(channel != NULL);
     sc_assert(index <= MAX_ADC_CHANNEL_INDEX);
 
-    channel->index = index;
+    channel->next = NULL;
     channel->callback = callback;
+    channel->result = 0;
+    channel->index = index;
+    channel->extra_bits = 0;
+    channel->ready = false;
 }
 
 ///
@@ -149,6 +200,7 @@ void driverADC_Convert(struct adc_channel_t *channel, uint16_t *samples, size_t
     sc_assert(channel != NULL);
     sc_assert(samples != NULL);
     sc_assert(length > 0);
+    sc_assert(!driverADC_IsScanning());
 
     module.channel = channel;
     module.buffer = samples;
@@ -175,6 +227,141 @@ void driverADC_Wait(void)
     }
 }
 
+///
+/// @brief Add an initialized channel to the scan list.
+///
+/// Each scan oversamples the channel 4^extra_bits times and decimates the sum
+/// to a result with ADC_RESOLUTION_BITS + extra_bits bits. The channel
+/// callback is called from the ISR when the result is stored.
+///
+/// @param  channel Pointer to channel struct.
+/// @param  extra_bits Number of bits of resolution added by oversampling.
+///
+/// @return None
+///
+void driverADC_AddToScan(struct adc_channel_t *channel, uint8_t extra_bits)
+{
+    sc_assert(channel != NULL);
+    sc_assert(extra_bits <= ADC_MAX_EXTRA_BITS);
+    sc_assert(!driverADC_IsScanning());
+
+    channel->extra_bits = extra_bits;
+    channel->next = module.scan.first;
+    module.scan.first = channel;
+}
+
+///
+/// @brief Start sampling all channels in the scan list, one after another.
+///
+/// Returns immediately, the conversions are handled by the ADC ISR. Nothing
+/// happens if a scan is already running.
+///
+/// @param  None
+///
+/// @return None
+///
+void driverADC_StartScan(void)
+{
+    if (module.scan.first == NULL || driverADC_IsScanning())
+    {
+        return;
+    }
+
+    module.scan.sum = 0;
+    module.scan.count = 0;
+    module.scan.discard = SETTLING_DISCARD;
+    module.scan.current = module.scan.first;
+
+    SelectChannel(module.scan.current->index);
+    EnableADC();
+    StartConversion();
+}
+
+///
+/// @brief Check if a scan is running.
+///
+/// @param  None
+///
+/// @return True if a scan is running, otherwise false.
+///
+bool driverADC_IsScanning(void)
+{
+    return module.scan.current != NULL;
+}
+
+///
+/// @brief Get the latest scan result of a channel.
+///
+/// @param  channel Pointer to channel struct.
+/// @param  value Pointer to variable where the averaged value will be stored.
+///
+/// @return True if a new result was available since the last call.
+///
+bool driverADC_GetScanResult(struct adc_channel_t *channel, uint16_t *value)
+{
+    sc_assert(channel != NULL);
+    sc_assert(value != NULL);
+
+    bool status;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        status = channel->ready;
+        *value = channel->result;
+        channel->ready = false;
+    }
+
+    return status;
+}
+
+///
+/// @brief Perform an oversampled conversion with the CPU in ADC noise
+///        reduction sleep during each sample. Blocks until done.
+///
+/// The I/O clock is halted while sleeping, so the millisecond timer pauses
+/// for the duration of each sample. Sleep is skipped, and the conversion
+/// polled, while the UART is transmitting, an SPI transaction is queued or
+/// interrupts are disabled.
+///
+/// @param  channel Pointer to channel struct.
+/// @param  extra_bits Number of bits of resolution added by oversampling.
+///
+/// @return Result with ADC_RESOLUTION_BITS + extra_bits bits.
+///
+uint16_t driverADC_ConvertQuiet(struct adc_channel_t *channel, uint8_t extra_bits)
+{
+    sc_assert(channel != NULL);
+    sc_assert(extra_bits <= ADC_MAX_EXTRA_BITS);
+    sc_assert(!driverADC_IsScanning());
+
+    const uint8_t nr_samples = NumberOfSamples(extra_bits);
+    uint16_t sum = 0;
+
+    module.quiet.active = true;
+    SelectChannel(channel->index);
+
+    // Single conversion mode, entering the sleep mode starts the conversion.
+    ADCSRA &= ~(1 << ADATE);
+    EnableADC();
+    set_sleep_mode(SLEEP_MODE_ADC);
+
+    for (uint8_t i = 0; i < nr_samples + SETTLING_DISCARD; ++i)
+    {
+        QuietConversion();
+
+        if (i >= SETTLING_DISCARD)
+        {
+            sum += module.quiet.value;
+        }
+    }
+
+    ADCSRA &= ~(1 << ADEN);
+    ADCSRA |= (1 << ADATE);
+    module.quiet.active = false;
+
+    return Decimate(sum, extra_bits);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -201,3 +388,98 @@ static inline void SelectChannel(uint8_t index)
     new_admux |= index;
     ADMUX = new_admux;
 }
+
+static inline uint8_t NumberOfSamples(uint8_t extra_bits)
+{
+    return 1 << (2 * extra_bits);
+}
+
+/**
+ * Scale a sum of 4^extra_bits samples down to a result with extra_bits more
+ * bits than a single sample, rounded to nearest.
+ */
+static inline uint16_t Decimate(uint16_t sum, uint8_t extra_bits)
+{
+    return (sum + ((1 << extra_bits) >> 1)) >> extra_bits;
+}
+
+/**
+ * The I/O clock is stopped in noise reduction sleep, which would corrupt an
+ * ongoing UART or SPI transfer. Nothing could wake the CPU with interrupts
+ * off.
+ */
+static bool IsQuietSleepAllowed(void)
+{
+    return (SREG & (1 << SREG_I)) && driverUART_IsTxIdle() && libSPI_IsIdle();
+}
+
+/**
+ * Run one conversion, sleeping until the ADC ISR has stored the result.
+ */
+static void QuietConversion(void)
+{
+    module.quiet.done = false;
+
+    if (IsQuietSleepAllowed())
+    {
+        sleep_enable();
+        sleep_cpu();
+        sleep_disable();
+    }
+    else
+    {
+        StartConversion();
+    }
+
+    while (!module.quiet.done)
+    {
+        /* Woken by another interrupt, or polling. */
+    }
+}
+
+/**
+ * Accumulate a scan sample, switch to the next channel when enough samples
+ * have been taken and stop the ADC after the last channel. Called from the
+ * ADC ISR.
+ */
+static void ScanConversionDone(uint16_t value)
+{
+    struct adc_channel_t *channel = module.scan.current;
+
+    if (module.scan.discard > 0)
+    {
+        --module.scan.discard;
+        return;
+    }
+
+    module.scan.sum += value;
+    ++module.scan.count;
+
+    if (module.scan.count < NumberOfSamples(channel->extra_bits))
+    {
+        return;
+    }
+
+    channel->result = Decimate(module.scan.sum, channel->extra_bits);
+    channel->ready = true;
+
+    if (channel->callback != NULL)
+    {
+        channel->callback(channel);
+    }
+
+    channel = channel->next;
+    module.scan.current = channel;
+
+    if (channel == NULL)
+    {
+        // Disable the ADC, the scan is done.
+        ADCSRA &= ~(1 << ADEN);
+        return;
+    }
+
+    module.scan.sum = 0;
+    module.scan.count = 0;
+    module.scan.discard = SETTLING_DISCARD;
+    SelectChannel(channel->index);
+}
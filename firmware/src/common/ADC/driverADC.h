@@ -1,7 +1,7 @@
 /**
  * @file   driverADC.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2017-07-28 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header of ADC-library.
  *
  * Detailed description of file.
@@ -31,20 +31,36 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //INCLUDES
 //////////////////////////////////////////////////////////////////////////
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
+#define ADC_RESOLUTION_BITS 10
+
+// Each extra bit of resolution takes four times as many samples. Three extra
+// bits, 64 samples, is the most that can be summed in 16 bits.
+#define ADC_MAX_EXTRA_BITS 3
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
-typedef void (*driver_adc_callback_t)(uint8_t index);
+struct adc_channel_t;
+
+typedef void (*driver_adc_callback_t)(struct adc_channel_t *channel);
 
 struct adc_channel_t
 {
-    uint8_t index;
+    struct adc_channel_t *next;
     driver_adc_callback_t callback;
+    volatile uint16_t result;
+    uint8_t index;
+    uint8_t extra_bits;
+    volatile bool ready;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -57,5 +73,10 @@ void driverADC_InitChannel(struct adc_channel_t *channel,
                            driver_adc_callback_t callback);
 void driverADC_Convert(struct adc_channel_t *channel, uint16_t *samples, size_t length);
 void driverADC_Wait();
+void driverADC_AddToScan(struct adc_channel_t *channel, uint8_t extra_bits);
+void driverADC_StartScan(void);
+bool driverADC_IsScanning(void);
+bool driverADC_GetScanResult(struct adc_channel_t *channel, uint16_t *value);
+uint16_t driverADC_ConvertQuiet(struct adc_channel_t *channel, uint8_t extra_bits);
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   packet.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-04-23 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Definition of packet format used for battery and sensor data.
  */
 
@@ -57,6 +57,17 @@ struct __attribute__((packed)) packet_t
     struct time_t timestamp;
 };
 
+/**
+ * Channel announcement sent by the master. All nodes should move to the
+ * new channel when their clocks reach the switch timestamp, the master
+ * changes channel at the same time.
+ */
+struct __attribute__((packed)) packet_channel_t
+{
+    uint8_t channel;
+    uint32_t switch_timestamp;
+};
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
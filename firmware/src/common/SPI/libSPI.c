@@ -0,0 +1,550 @@
+/**
+ * @file   libSPI.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Driver for the ATmega328 SPI-peripheral.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include "common.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "libDebug.h"
+#include "libSPI.h"
+#include "driverTimer.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define SS      DDB2
+#define MOSI    DDB3
+#define MISO    DDB4
+#define SCK     DDB5
+
+#define CLOCK_DIVIDER_SPR_MASK  0x03
+#define CLOCK_DIVIDER_SPI2X_BIT 2
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+struct trace_counters_t
+{
+    uint16_t transactions;
+    uint32_t bytes;
+    uint32_t busy_ticks;
+    uint16_t longest_ticks;
+};
+
+struct module_t
+{
+    struct libSPI_transaction_t *head_p;
+    struct libSPI_transaction_t *tail_p;
+    size_t index;
+    bool completing;
+#ifdef DEBUG_ENABLE
+    bool trace_selected;
+    libSPI_trace_id_type trace_id;
+    uint16_t trace_start;
+    uint32_t trace_bytes;
+    struct trace_counters_t trace[LIBSPI_TRACE_NR_IDS];
+#endif
+};
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+static volatile struct module_t module;
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+static inline void InitializePins(void);
+static inline void EnableSPI(void);
+static inline void TryExecuteCallback(libSPI_callback_type callback);
+static void Transfer(libSPI_callback_type pre_callback,
+                     libSPI_callback_type post_callback,
+                     const void *tx_p,
+                     void *rx_p,
+                     size_t length);
+static void StartNextTransaction(void);
+static void FinishTransaction(void);
+static void HandleTransferComplete(void);
+static inline void TraceStart(const struct libSPI_transaction_t *transaction_p);
+static inline void TraceStop(const struct libSPI_transaction_t *transaction_p);
+#ifdef DEBUG_ENABLE
+static void TraceAccount(void);
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+//INTERUPT SERVICE ROUTINES
+//////////////////////////////////////////////////////////////////////////
+
+ISR(SPI_STC_vect)
+{
+    HandleTransferComplete();
+}
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+void libSPI_Init(uint8_t spi_mode)
+{
+    module.head_p = NULL;
+    module.tail_p = NULL;
+    module.completing = false;
+#ifdef DEBUG_ENABLE
+    module.trace_selected = false;
+    libSPI_ResetTrace();
+#endif
+
+    InitializePins();
+    SPCR = 0x00;
+    libSPI_SetClockDivider(LIBSPI_CLOCK_DIV_16);
+    libSPI_SetAsMaster();
+    libSPI_SetMode(spi_mode);
+    EnableSPI();
+
+    INFO("SPI driver initialized");
+}
+
+void libSPI_WriteByte(uint8_t data,
+                      libSPI_callback_type pre_callback,
+                      libSPI_callback_type post_callback)
+{
+    Transfer(pre_callback, post_callback, &data, NULL, 1);
+}
+
+void libSPI_Write(const void *data_p,
+                  size_t length,
+                  libSPI_callback_type pre_callback,
+                  libSPI_callback_type post_callback)
+{
+    sc_assert(data_p != NULL);
+
+    Transfer(pre_callback, post_callback, data_p, NULL, length);
+}
+
+void libSPI_ReadByte(uint8_t *data_p,
+                     libSPI_callback_type pre_callback,
+                     libSPI_callback_type post_callback)
+{
+    sc_assert(data_p != NULL);
+
+    Transfer(pre_callback, post_callback, NULL, data_p, 1);
+}
+
+void libSPI_Read(void *data_p,
+                 size_t length,
+                 libSPI_callback_type pre_callback,
+                 libSPI_callback_type post_callback)
+{
+    sc_assert(data_p != NULL);
+
+    Transfer(pre_callback, post_callback, NULL, data_p, length);
+}
+
+void libSPI_Submit(struct libSPI_transaction_t *transaction_p)
+{
+    sc_assert(transaction_p != NULL);
+
+    transaction_p->done = false;
+    transaction_p->next_p = NULL;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (module.head_p == NULL)
+        {
+            module.head_p = transaction_p;
+            module.tail_p = transaction_p;
+
+            /**
+             * A transaction submitted from a complete callback is started
+             * when the callback returns, starting it here would restart
+             * the bus in the middle of the completion handling.
+             */
+            if (!module.completing)
+            {
+                StartNextTransaction();
+            }
+        }
+        else
+        {
+            module.tail_p->next_p = transaction_p;
+            module.tail_p = transaction_p;
+        }
+    }
+}
+
+bool libSPI_IsDone(const struct libSPI_transaction_t *transaction_p)
+{
+    sc_assert(transaction_p != NULL);
+
+    return transaction_p->done;
+}
+
+void libSPI_Wait(const struct libSPI_transaction_t *transaction_p)
+{
+    sc_assert(transaction_p != NULL);
+
+    while (!transaction_p->done)
+    {
+        /**
+         * The bus must be serviced manually when the current transaction is
+         * polled or if interrupts are disabled, e.g. when called from an
+         * assert handler.
+         */
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            if (module.head_p != NULL && (SPSR & (1 << SPIF)) &&
+                    (!(SPCR & (1 << SPIE)) || !(SREG & (1 << SREG_I))))
+            {
+                HandleTransferComplete();
+            }
+        }
+    }
+}
+
+bool libSPI_IsIdle(void)
+{
+    return module.head_p == NULL;
+}
+
+void libSPI_SetAsMaster(void)
+{
+    SPCR |= (1 << MSTR);
+}
+
+void libSPI_SetMode(uint8_t mode)
+{
+    switch (mode)
+    {
+        case 0:
+            /* Clock low when idle, sample on rising edge. */
+            SPCR &= ~((1 << CPOL) | (1 << CPHA));
+            break;
+
+        case 1:
+            /* Clock low when idle, sample on falling edge. */
+            SPCR &= ~(1 << CPOL);
+            SPCR |= (1 << CPHA);
+            break;
+
+        case 2:
+            /* Clock high when idle, sample on rising edge. */
+            SPCR |= (1 << CPOL);
+            SPCR &= ~(1 << CPHA);
+            break;
+
+        case 3:
+            /* Clock high when idle, sample on falling edge. */
+            SPCR |= ((1 << CPOL) | (1 << CPHA));
+            break;
+
+        default:
+            sc_assert_fail();
+            break;
+    }
+}
+
+void libSPI_SetClockDivider(libSPI_clock_divider_type clock_divider)
+{
+    sc_assert(clock_divider <= LIBSPI_CLOCK_DIV_32);
+
+    SPCR = (SPCR & ~CLOCK_DIVIDER_SPR_MASK) | (clock_divider & CLOCK_DIVIDER_SPR_MASK);
+
+    if ((clock_divider & (1 << CLOCK_DIVIDER_SPI2X_BIT)) != 0)
+    {
+        SPSR |= (1 << SPI2X);
+    }
+    else
+    {
+        SPSR &= ~(1 << SPI2X);
+    }
+}
+
+void libSPI_SetProfile(const struct libSPI_profile_t *profile_p)
+{
+    sc_assert(profile_p != NULL);
+
+    libSPI_SetMode(profile_p->mode);
+    libSPI_SetClockDivider(profile_p->clock_divider);
+
+#ifdef DEBUG_ENABLE
+    sc_assert(profile_p->trace_id < LIBSPI_TRACE_NR_IDS);
+    module.trace_id = profile_p->trace_id;
+#endif
+}
+
+#ifdef DEBUG_ENABLE
+void libSPI_DumpTrace(void)
+{
+    for (uint8_t id = 0; id < LIBSPI_TRACE_NR_IDS; ++id)
+    {
+        struct trace_counters_t counters;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            counters = module.trace[id];
+        }
+
+        if (counters.transactions > 0)
+        {
+            INFO("SPI[%u]: %u trans, %lu B, %lu us busy, %lu us max",
+                 id,
+                 counters.transactions,
+                 counters.bytes,
+                 counters.busy_ticks * DRIVERTIMER_TICK_US,
+                 (uint32_t)counters.longest_ticks * DRIVERTIMER_TICK_US);
+        }
+    }
+}
+
+void libSPI_ResetTrace(void)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        for (uint8_t id = 0; id < LIBSPI_TRACE_NR_IDS; ++id)
+        {
+            module.trace[id] = (struct trace_counters_t) {0};
+        }
+    }
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+static inline void InitializePins(void)
+{
+    /**
+     * Always set SS as output even if not used, otherwise the device can't
+     * act as master.
+     */
+    DDRB |= ((1 << MOSI) | (1 << SCK) | (1 << SS));
+    DDRB &= ~(1 << MISO);
+}
+
+static inline void EnableSPI(void)
+{
+    SPCR |= (1 << SPE);
+}
+
+static inline void TryExecuteCallback(libSPI_callback_type callback)
+{
+    if (callback != NULL)
+    {
+        callback();
+    }
+}
+
+static void Transfer(libSPI_callback_type pre_callback,
+                     libSPI_callback_type post_callback,
+                     const void *tx_p,
+                     void *rx_p,
+                     size_t length)
+{
+    struct libSPI_transaction_t transaction =
+    {
+        .pre_callback = pre_callback,
+        .post_callback = post_callback,
+        .tx_p = (const uint8_t *)tx_p,
+        .rx_p = (uint8_t *)rx_p,
+        .length = length,
+        .polled = true
+    };
+
+    libSPI_Submit(&transaction);
+    libSPI_Wait(&transaction);
+}
+
+/**
+ * Must be called with interrupts disabled.
+ *
+ * Polled transactions are serviced from libSPI_Wait() with the SPI interrupt
+ * disabled. At the highest bus clock a byte takes 16 CPU cycles, less than
+ * entering and leaving the interrupt, so an interrupt per byte only pays off
+ * for queued transactions where the CPU has other work to do.
+ */
+static void StartNextTransaction(void)
+{
+    struct libSPI_transaction_t *transaction_p;
+
+    while ((transaction_p = module.head_p) != NULL)
+    {
+        TraceStart(transaction_p);
+        TryExecuteCallback(transaction_p->pre_callback);
+
+        if (transaction_p->length > 0)
+        {
+            module.index = 0;
+
+            if (transaction_p->polled)
+            {
+                SPCR &= ~(1 << SPIE);
+            }
+            else
+            {
+                SPCR |= (1 << SPIE);
+            }
+
+            SPDR = (transaction_p->tx_p != NULL) ? transaction_p->tx_p[0] : 0x00;
+            return;
+        }
+
+        FinishTransaction();
+    }
+
+    SPCR &= ~(1 << SPIE);
+}
+
+/**
+ * Must be called with interrupts disabled.
+ */
+static void FinishTransaction(void)
+{
+    struct libSPI_transaction_t *transaction_p = module.head_p;
+
+    TryExecuteCallback(transaction_p->post_callback);
+    TraceStop(transaction_p);
+
+    module.head_p = transaction_p->next_p;
+    if (module.head_p == NULL)
+    {
+        module.tail_p = NULL;
+    }
+
+    transaction_p->done = true;
+
+    if (transaction_p->complete_callback != NULL)
+    {
+        module.completing = true;
+        transaction_p->complete_callback(transaction_p);
+        module.completing = false;
+    }
+}
+
+/**
+ * Must be called with interrupts disabled.
+ */
+static void HandleTransferComplete(void)
+{
+    struct libSPI_transaction_t *transaction_p = module.head_p;
+    const uint8_t data = SPDR;
+
+    sc_assert(transaction_p != NULL);
+
+    if (transaction_p->rx_p != NULL)
+    {
+        transaction_p->rx_p[module.index] = data;
+    }
+
+    ++module.index;
+    if (module.index < transaction_p->length)
+    {
+        SPDR = (transaction_p->tx_p != NULL) ? transaction_p->tx_p[module.index] : 0x00;
+    }
+    else
+    {
+        FinishTransaction();
+        StartNextTransaction();
+    }
+}
+
+/**
+ * Must be called with interrupts disabled.
+ *
+ * Drivers split a chip select into several calls where only the first one
+ * has a pre callback, selecting the device and applying its profile, and
+ * only the last one has a post callback. A trace is started by a pre
+ * callback, or by a call without one if none is ongoing, and the calls in
+ * between are accounted to the same device.
+ */
+static inline void TraceStart(const struct libSPI_transaction_t *transaction_p)
+{
+#ifdef DEBUG_ENABLE
+    if (module.trace_selected == true)
+    {
+        if (transaction_p->pre_callback == NULL)
+        {
+            return;
+        }
+
+        //The previous device was never deselected.
+        TraceAccount();
+    }
+
+    module.trace_selected = true;
+    module.trace_id = LIBSPI_TRACE_ID_UNKNOWN;
+    module.trace_start = (uint16_t)driverTimer_GetTicks();
+    module.trace_bytes = 0;
+#else
+    UNUSED(transaction_p);
+#endif
+}
+
+/**
+ * Must be called with interrupts disabled.
+ */
+static inline void TraceStop(const struct libSPI_transaction_t *transaction_p)
+{
+#ifdef DEBUG_ENABLE
+    module.trace_bytes += transaction_p->length;
+
+    if (transaction_p->post_callback != NULL)
+    {
+        TraceAccount();
+    }
+#else
+    UNUSED(transaction_p);
+#endif
+}
+
+#ifdef DEBUG_ENABLE
+/**
+ * Account the ongoing trace to its device, must be called with interrupts
+ * disabled.
+ */
+static void TraceAccount(void)
+{
+    const uint16_t ticks = (uint16_t)driverTimer_GetTicks() - module.trace_start;
+    volatile struct trace_counters_t *counters_p = &module.trace[module.trace_id];
+
+    ++counters_p->transactions;
+    counters_p->bytes += module.trace_bytes;
+    counters_p->busy_ticks += ticks;
+
+    if (ticks > counters_p->longest_ticks)
+    {
+        counters_p->longest_ticks = ticks;
+    }
+
+    module.trace_selected = false;
+}
+#endif
@@ -0,0 +1,270 @@
+/**
+ * @file   libSPI.h
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Driver for the ATmega328 SPI-peripheral.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LIBSPI_H_
+#define LIBSPI_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "stddef.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+typedef void (*libSPI_callback_type)(void);
+
+/**
+ * Device IDs used to account bus usage per chip select, see libSPI_DumpTrace.
+ */
+typedef enum
+{
+    LIBSPI_TRACE_ID_UNKNOWN = 0,
+    LIBSPI_TRACE_ID_RTC,
+    LIBSPI_TRACE_ID_RFM69,
+    LIBSPI_TRACE_ID_FLASH,
+    LIBSPI_TRACE_NR_IDS
+} libSPI_trace_id_type;
+
+/**
+ * SPI clock divider relative to F_CPU.
+ *
+ * Bit 2 selects double speed(SPI2X), bits 1..0 are the SPR1..0 bits.
+ */
+typedef enum
+{
+    LIBSPI_CLOCK_DIV_4 = 0x00,
+    LIBSPI_CLOCK_DIV_16 = 0x01,
+    LIBSPI_CLOCK_DIV_64 = 0x02,
+    LIBSPI_CLOCK_DIV_128 = 0x03,
+    LIBSPI_CLOCK_DIV_2 = 0x04,
+    LIBSPI_CLOCK_DIV_8 = 0x05,
+    LIBSPI_CLOCK_DIV_32 = 0x06
+} libSPI_clock_divider_type;
+
+/**
+ * Bus settings required by a device, applied in the device pre callback.
+ */
+struct libSPI_profile_t
+{
+    uint8_t mode;
+    libSPI_clock_divider_type clock_divider;
+    libSPI_trace_id_type trace_id;
+};
+
+struct libSPI_transaction_t;
+typedef void (*libSPI_complete_callback_type)(struct libSPI_transaction_t *transaction_p);
+
+/**
+ * Descriptor for an asynchronous SPI transaction.
+ *
+ * The pre and post callbacks are typically used to select and deselect the
+ * device. All callbacks are executed from the SPI interrupt when transactions
+ * are queued, keep them short.
+ */
+struct libSPI_transaction_t
+{
+    libSPI_callback_type pre_callback;
+    libSPI_callback_type post_callback;
+    libSPI_complete_callback_type complete_callback;
+    /* Data to write, 0x00 is written if NULL. */
+    const uint8_t *tx_p;
+    /* Location where read data is stored, read data is discarded if NULL. */
+    uint8_t *rx_p;
+    size_t length;
+    /**
+     * Service the transaction from libSPI_Wait() instead of the SPI
+     * interrupt, faster for short transfers. Must be waited for.
+     */
+    bool polled;
+
+    /* Managed by the driver, don't touch. */
+    volatile bool done;
+    struct libSPI_transaction_t *next_p;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Initialize the SPI driver.
+ *
+ * @param spi_mode SPI-mode(0-3).
+ */
+void libSPI_Init(uint8_t spi_mode);
+
+
+/**
+ * Perform a blocking write of a single byte.
+ *
+ * @param data          Byte to write.
+ * @param pre_callback  Function call before writing.
+ * @param post_callback Function call after writing.
+ */
+void libSPI_WriteByte(uint8_t data,
+                      libSPI_callback_type pre_callback,
+                      libSPI_callback_type post_callback);
+
+/**
+ * Perform a blocking write.
+ *
+ * @param data_p        Pointer to data to write.
+ * @param length        Number of bytes to write.
+ * @param pre_callback  Function call before writing.
+ * @param post_callback Function call after writing.
+ */
+void libSPI_Write(const void *data_p,
+                  size_t length,
+                  libSPI_callback_type pre_callback,
+                  libSPI_callback_type post_callback);
+
+/**
+ * Perform a blocking read of a single byte.
+ *
+ * @param data_p        Pointer to location where the byte will be stored.
+ * @param pre_callback  Function call before writing.
+ * @param post_callback Function call after writing.
+ */
+void libSPI_ReadByte(uint8_t *data_p,
+                     libSPI_callback_type pre_callback,
+                     libSPI_callback_type post_callback);
+
+/**
+ * Perform a blocking read.
+ *
+ * @param data_p        Pointer to location where the data will be stored.
+ * @param length        Number of bytes to read.
+ * @param pre_callback  Function call before writing.
+ * @param post_callback Function call after writing.
+ */
+void libSPI_Read(void *data_p,
+                 size_t length,
+                 libSPI_callback_type pre_callback,
+                 libSPI_callback_type post_callback);
+
+/**
+ * Queue an asynchronous transaction.
+ *
+ * The transaction is started directly if the bus is idle, otherwise when all
+ * previously queued transactions are done. A transaction submitted from a
+ * complete callback is started when the callback returns. The descriptor and the buffers
+ * must stay valid until the transaction is done.
+ *
+ * @param transaction_p Pointer to transaction descriptor.
+ */
+void libSPI_Submit(struct libSPI_transaction_t *transaction_p);
+
+/**
+ * Check if a transaction is done.
+ *
+ * @param transaction_p Pointer to transaction descriptor.
+ *
+ * @return True if the transaction is done, otherwise false.
+ */
+bool libSPI_IsDone(const struct libSPI_transaction_t *transaction_p);
+
+/**
+ * Block until a transaction is done.
+ *
+ * @param transaction_p Pointer to transaction descriptor.
+ */
+void libSPI_Wait(const struct libSPI_transaction_t *transaction_p);
+
+/**
+ * Check if the bus is idle.
+ *
+ * @return True if no transaction is queued or in progress, otherwise false.
+ */
+bool libSPI_IsIdle(void);
+
+/**
+ * Set the driver to act as master on the SPI-bus.
+ */
+void libSPI_SetAsMaster(void);
+
+/**
+ * Set the SPI transfer mode.
+ *
+ * Mode Leading Edge        Trailing Edge
+ *  0   Sample (Rising)     Setup (Falling)
+ *  1   Setup (Rising)      Sample (Falling)
+ *  2   Sample (Falling)    Setup (Rising)
+ *  3   Setup (Falling)     Sample (Rising)
+ *
+ * The mode must not be changed by other than a pre callback while a
+ * transaction is in progress.
+ *
+ * @param mode SPI-mode.
+ */
+void libSPI_SetMode(uint8_t mode);
+
+/**
+ * Set the SPI clock divider.
+ *
+ * The same restrictions as for libSPI_SetMode applies.
+ *
+ * @param clock_divider Clock divider.
+ */
+void libSPI_SetClockDivider(libSPI_clock_divider_type clock_divider);
+
+/**
+ * Apply a device profile, SPI-mode and clock divider.
+ *
+ * Intended to be called from the device pre callback so that devices with
+ * different requirements can share the bus, each running at its own
+ * maximum rate. The profile trace ID is also used to account the bus usage
+ * until the device is deselected, i.e. until a post callback is executed.
+ *
+ * @param profile_p Pointer to profile.
+ */
+void libSPI_SetProfile(const struct libSPI_profile_t *profile_p);
+
+#ifdef DEBUG_ENABLE
+/**
+ * Print the bus usage counters for each device.
+ *
+ * Counts transactions, bytes, busy time and the longest transaction. A
+ * transaction lasts from a pre callback to the next post callback, i.e. one
+ * chip select, and may consist of several calls. Busy time is measured with
+ * the system timer with a resolution of DRIVERTIMER_TICK_US, transactions
+ * longer than 524 ms are under-reported.
+ */
+void libSPI_DumpTrace(void);
+
+/**
+ * Reset the bus usage counters.
+ */
+void libSPI_ResetTrace(void);
+#endif
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file   commonBoard.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-01-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Board support package for the main unit.
  */
 
@@ -61,6 +61,20 @@ static void StackPaint(void) __attribute__ ((naked)) __attribute__ ((
 extern uint8_t _end;
 extern uint8_t __stack;
 
+static const struct libSPI_profile_t rtc_spi_profile =
+{
+    .mode = RTC_SPI_MODE,
+    .clock_divider = RTC_SPI_CLOCK_DIVIDER,
+    .trace_id = LIBSPI_TRACE_ID_RTC
+};
+
+static const struct libSPI_profile_t rfm69_spi_profile =
+{
+    .mode = RFM69_SPI_MODE,
+    .clock_divider = RFM69_SPI_CLOCK_DIVIDER,
+    .trace_id = LIBSPI_TRACE_ID_RFM69
+};
+
 //////////////////////////////////////////////////////////////////////////
 //INTERUPT SERVICE ROUTINES
 //////////////////////////////////////////////////////////////////////////
@@ -84,7 +98,7 @@ void Board_RTC_Init(void)
 
 void Board_RTC_SPIPreCallback(void)
 {
-    libSPI_SetMode(RTC_SPI_MODE);
+    libSPI_SetProfile(&rtc_spi_profile);
     RTC_SPI_PORT &= ~(1 << RTC_SPI_SS);
 }
 
@@ -105,7 +119,7 @@ void Board_RFM69_Init(void)
 
 void Board_RFM69_SPIPreCallback(void)
 {
-    libSPI_SetMode(RFM69_SPI_MODE);
+    libSPI_SetProfile(&rfm69_spi_profile);
     RFM69_SPI_PORT &= ~(1 << RFM69_SPI_SS);
 }
 
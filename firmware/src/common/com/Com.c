@@ -1,7 +1,7 @@
 /**
  * @file   Com.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-24 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of the Communications module.
  */
 
@@ -66,6 +66,7 @@ static struct module_t module;
 //////////////////////////////////////////////////////////////////////////
 
 static bool HandlePacket(const packet_frame_type *packet);
+static transceiver_priority_type GetPriority(uint8_t packet_type);
 
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
@@ -122,7 +123,7 @@ void Com_Send(uint8_t target, uint8_t packet_type, const void *data_p, size_t si
     packet.timestamp = timestamp;
     memcpy(packet.data, data_p, packet.size);
 
-    if (Transceiver_SendPacket(target, &packet))
+    if (Transceiver_SendPacket(target, &packet, GetPriority(packet_type)))
     {
         DEBUG("Packet sent to 0x%02X. \r\n", target);
         ++module.statistics.sent;
@@ -165,3 +166,28 @@ static bool HandlePacket(const packet_frame_type *packet)
 
     return status;
 }
+
+static transceiver_priority_type GetPriority(uint8_t packet_type)
+{
+    transceiver_priority_type priority;
+
+    switch (packet_type)
+    {
+        /**
+         * ACKs, time replies and channel announcements are short and time
+         * critical, the receiver is only awake for a short while waiting
+         * for them.
+         */
+        case COM_PACKET_TYPE_ACK:
+        case COM_PACKET_TYPE_TIME:
+        case COM_PACKET_TYPE_CHANNEL:
+            priority = TR_PRIORITY_HIGH;
+            break;
+
+        default:
+            priority = TR_PRIORITY_NORMAL;
+            break;
+    }
+
+    return priority;
+}
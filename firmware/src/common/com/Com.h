@@ -1,7 +1,7 @@
 /**
  * @file   Com.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of the Communications module.
  */
 
@@ -48,6 +48,7 @@ typedef enum
     COM_PACKET_TYPE_DATA,
     COM_PACKET_TYPE_READING,
     COM_PACKET_TYPE_TIME,
+    COM_PACKET_TYPE_CHANNEL,
     COM_PACKET_NR_TYPES
 } com_packet_type_t;
 
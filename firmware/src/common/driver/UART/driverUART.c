@@ -1,7 +1,7 @@
 /**
  * @file   driverUART.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of ATmega328 UART driver.
  */
 
@@ -50,6 +50,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 static driverUART_isr_callback rx_handler;
 static driverUART_isr_callback tx_handler;
+static volatile bool tx_started;
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
@@ -74,7 +75,13 @@ ISR(USART_UDRE_vect)
 
     if (tx_handler != NULL && tx_handler(&data))
     {
+        /**
+         * Clear TXC0 by writing a one so it marks the end of this byte,
+         * U2X0 and MPCM0 are kept.
+         */
+        UCSR0A = (UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0);
         UDR0 = data;
+        tx_started = true;
     }
     else
     {
@@ -118,6 +125,13 @@ void driverUART_StartTx(void)
     UCSR0B |= (1<<UDRIE0);
 }
 
+bool driverUART_IsTxIdle(void)
+{
+    /* TXC0 is not set until the first transmission has completed. */
+    return !(UCSR0B & (1 << UDRIE0)) &&
+           (!tx_started || (UCSR0A & (1 << TXC0)));
+}
+
 bool driverUART_SetBaudRate(uint32_t baud)
 {
     bool status = false;
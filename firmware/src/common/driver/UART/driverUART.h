@@ -1,7 +1,7 @@
 /**
  * @file   driverUART.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of ATmega328 UART driver.
  */
 
@@ -70,6 +70,14 @@ void driverUART_Enable(bool enable);
  */
 void driverUART_StartTx(void);
 
+/**
+ * Check if the transmitter is idle, including the last byte in the shift
+ * register.
+ *
+ * @return True if idle, otherwise false.
+ */
+bool driverUART_IsTxIdle(void);
+
 /**
  * Set UART baud rate.
  *
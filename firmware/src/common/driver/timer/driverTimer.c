@@ -1,7 +1,7 @@
 /**
  * @file   driverTimer.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of ATmega328 timer driver.
  */
 
@@ -112,6 +112,26 @@ uint32_t driverTimer_GetMilliseconds()
     return current_timer;
 }
 
+uint32_t driverTimer_GetTicks()
+{
+    uint32_t current_timer;
+    uint8_t ticks;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        current_timer = system_timer;
+        ticks = TCNT0;
+
+        /* The counter has wrapped but the interrupt is not serviced yet. */
+        if ((TIFR0 & (1 << OCF0A)) && ticks < OCR0A)
+        {
+            ++current_timer;
+        }
+    }
+
+    return current_timer * (OCR0A + 1) + ticks;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
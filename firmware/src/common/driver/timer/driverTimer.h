@@ -1,7 +1,7 @@
 /**
  * @file   driverTimer.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of ATmega328 timer driver.
  */
 
@@ -35,6 +35,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
+//Length of a timer tick, F_CPU divided by the prescaler(64).
+#define DRIVERTIMER_TICK_US 8
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -70,4 +73,11 @@ void driverTimer_Reset(void);
  */
 uint32_t driverTimer_GetMilliseconds(void);
 
+/**
+ * Get the current time in timer ticks, for measuring short intervals.
+ *
+ * @return The current system time in ticks of DRIVERTIMER_TICK_US.
+ */
+uint32_t driverTimer_GetTicks(void);
+
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   Transceiver.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-05-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of the Transceiver interface.
  */
 
@@ -40,12 +40,20 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
+#define TX_HIGH_PRIORITY_PACKET_FIFO_SIZE 2
 #define TX_PACKET_FIFO_SIZE 3
 #define RX_PACKET_FIFO_SIZE 4
 
 #define BITRATE                         9600
 #define MIN_CHANNEL_FILTER_BANDWIDTH    (BITRATE * 2 + 1)
 
+/**
+ * The channel plan is kept inside the 868.0-868.6 MHz sub-band, channel 0
+ * uses the original carrier frequency and doubles as the rendezvous channel.
+ */
+#define CHANNEL_BASE_FREQUENCY          868000000
+#define CHANNEL_SPACING                 100000
+
 #ifdef DEBUG_ENABLE
 #define DUMPPACKET(packet) DumpPacket(packet);
 #else
@@ -86,6 +94,9 @@ struct module_t
         transceiver_sending_state_type sending;
         transceiver_listening_state_type listening;
     } state;
+    transceiver_overflow_policy_type overflow_policy;
+    struct transceiver_statistics_t statistics;
+    uint8_t channel;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -94,10 +105,11 @@ struct module_t
 
 static struct module_t module;
 
+static packet_frame_type tx_high_priority_packet_buffer[TX_HIGH_PRIORITY_PACKET_FIFO_SIZE];
 static packet_frame_type tx_packet_buffer[TX_PACKET_FIFO_SIZE];
 static packet_frame_type rx_packet_buffer[RX_PACKET_FIFO_SIZE];
 
-static struct fifo_t tx_packet_fifo;
+static struct fifo_t tx_packet_fifos[TR_NR_PRIORITIES];
 static struct fifo_t rx_packet_fifo;
 
 //////////////////////////////////////////////////////////////////////////
@@ -108,6 +120,15 @@ static transceiver_state_type SendingStateMachine(void);
 static transceiver_state_type ListeningStateMachine(void);
 static bool IsActive(void);
 static bool PacketToSend(void);
+static bool PopPacketToSend(packet_frame_type *packet_p);
+static bool Enqueue(struct fifo_t *fifo_p,
+                    const packet_frame_type *packet_p,
+                    struct transceiver_queue_statistics_t *statistics_p);
+static packet_frame_type *FindPacketWithSameRoute(const struct fifo_t *fifo_p,
+        const packet_frame_type *packet_p);
+static void UpdateHighWaterMark(struct transceiver_queue_statistics_t *statistics_p,
+                                uint8_t number_of_packets);
+static void Tune(uint8_t channel);
 
 #ifdef DEBUG_ENABLE
 static void DumpPacket(const packet_frame_type *packet_p);
@@ -119,7 +140,12 @@ static void DumpPacket(const packet_frame_type *packet_p);
 
 void Transceiver_Init(void)
 {
-    module = (struct module_t) { {.transceiver = TR_STATE_LISTENING}};
+    module = (struct module_t)
+    {
+        .state.transceiver = TR_STATE_LISTENING,
+        .overflow_policy = TR_OVERFLOW_DROP_NEWEST,
+        .channel = TR_RENDEZVOUS_CHANNEL
+    };
 
     libRFM69_Init();
     libRFM69_EnableEncryption(false);
@@ -141,7 +167,7 @@ void Transceiver_Init(void)
     libRFM69_SetChannelFilterBandwidth(MIN_CHANNEL_FILTER_BANDWIDTH);
     libRFM69_SetDcCancellationCutoffFrequency(RFM_DCC_FREQ_4);
     libRFM69_SetDataMode(RFM_PACKET_DATA);
-    libRFM69_SetCarrierFrequency(868000000);
+    Tune(module.channel);
     libRFM69_EnableSyncWordGeneration(true);
     libRFM69_SetFIFOFillCondition(RFM_FIFO_FILL_AUTO);
     libRFM69_SetRSSIThreshold(-85);
@@ -164,7 +190,8 @@ void Transceiver_Init(void)
     libRFM69_SetPowerLevel(28);
     libRFM69_SetAESKey((const uint8_t *)Config_GetAESKey());
 
-    tx_packet_fifo = FIFO_New(tx_packet_buffer);
+    tx_packet_fifos[TR_PRIORITY_NORMAL] = FIFO_New(tx_packet_buffer);
+    tx_packet_fifos[TR_PRIORITY_HIGH] = FIFO_New(tx_high_priority_packet_buffer);
     rx_packet_fifo = FIFO_New(rx_packet_buffer);
 
     INFO("Transceiver initiated");
@@ -197,13 +224,16 @@ bool Transceiver_ReceivePacket(packet_frame_type *packet_p)
     return status;
 }
 
-bool Transceiver_SendPacket(uint8_t target, const packet_content_type *content_p)
+bool Transceiver_SendPacket(uint8_t target,
+                            const packet_content_type *content_p,
+                            transceiver_priority_type priority)
 {
     sc_assert(content_p != NULL);
     sc_assert(target != 0);
+    sc_assert(priority < TR_NR_PRIORITIES);
 
     bool status = false;
-    if (content_p->size <= CONTENT_DATA_SIZE && !FIFO_IsFull(&tx_packet_fifo))
+    if (content_p->size <= CONTENT_DATA_SIZE)
     {
         packet_frame_type packet;
 
@@ -216,12 +246,92 @@ bool Transceiver_SendPacket(uint8_t target, const packet_content_type *content_p
         packet.content.size = content_p->size;
         memcpy(packet.content.data, content_p->data, content_p->size);
 
-        status = FIFO_Push(&tx_packet_fifo, &packet);
+        struct fifo_t *fifo_p = &tx_packet_fifos[priority];
+        struct transceiver_queue_statistics_t *statistics_p = &module.statistics.tx[priority];
+
+        status = Enqueue(fifo_p, &packet, statistics_p);
+        UpdateHighWaterMark(statistics_p, FIFO_Count(fifo_p));
     }
 
     return status;
 }
 
+bool Transceiver_SetChannel(uint8_t channel)
+{
+    sc_assert(channel < TR_NR_CHANNELS);
+
+    if (IsActive())
+    {
+        return false;
+    }
+
+    if (channel != module.channel)
+    {
+        INFO("Changing channel: %u -> %u", module.channel, channel);
+
+        libRFM69_SetMode(RFM_STANDBY);
+        libRFM69_WaitForModeReady();
+        Tune(channel);
+
+        module.channel = channel;
+        module.state.listening = TR_STATE_LISTENING_INIT;
+    }
+
+    return true;
+}
+
+uint8_t Transceiver_GetChannel(void)
+{
+    return module.channel;
+}
+
+bool Transceiver_MeasureRSSI(uint8_t channel, int8_t *rssi_p)
+{
+    sc_assert(channel < TR_NR_CHANNELS);
+    sc_assert(rssi_p != NULL);
+
+    if (IsActive())
+    {
+        return false;
+    }
+
+    libRFM69_SetMode(RFM_STANDBY);
+    libRFM69_WaitForModeReady();
+    Tune(channel);
+
+    libRFM69_SetMode(RFM_RECEIVER);
+    libRFM69_WaitForModeReady();
+    *rssi_p = libRFM69_GetRSSI();
+
+    libRFM69_SetMode(RFM_STANDBY);
+    libRFM69_WaitForModeReady();
+    Tune(module.channel);
+
+    // Restart the receiver on the current channel.
+    module.state.listening = TR_STATE_LISTENING_INIT;
+
+    return true;
+}
+
+void Transceiver_SetOverflowPolicy(transceiver_overflow_policy_type policy)
+{
+    sc_assert(policy <= TR_OVERFLOW_REPLACE_SAME_ROUTE);
+
+    module.overflow_policy = policy;
+}
+
+void Transceiver_GetStatistics(struct transceiver_statistics_t *statistics_p)
+{
+    sc_assert(statistics_p != NULL);
+
+    *statistics_p = module.statistics;
+}
+
+void Transceiver_ResetStatistics(void)
+{
+    module.statistics = (struct transceiver_statistics_t) {{{0}}, {0}};
+}
+
 void Transceiver_EventHandler(const event_t *event_p)
 {
     sc_assert(event_p != NULL);
@@ -265,7 +375,113 @@ static bool IsActive(void)
 
 static bool PacketToSend(void)
 {
-    return (!FIFO_IsEmpty(&tx_packet_fifo));
+    for (size_t i = 0; i < ElementsIn(tx_packet_fifos); ++i)
+    {
+        if (!FIFO_IsEmpty(&tx_packet_fifos[i]))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool PopPacketToSend(packet_frame_type *packet_p)
+{
+    /* Start with the FIFO holding the highest priority packets. */
+    for (size_t i = ElementsIn(tx_packet_fifos); i > 0; --i)
+    {
+        if (FIFO_Pop(&tx_packet_fifos[i - 1], packet_p))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool Enqueue(struct fifo_t *fifo_p,
+                    const packet_frame_type *packet_p,
+                    struct transceiver_queue_statistics_t *statistics_p)
+{
+    if (!FIFO_IsFull(fifo_p))
+    {
+        return FIFO_Push(fifo_p, packet_p);
+    }
+
+    if (statistics_p->dropped < UINT16_MAX)
+    {
+        ++statistics_p->dropped;
+    }
+
+    bool status = false;
+    packet_frame_type *queued_packet_p;
+
+    switch (module.overflow_policy)
+    {
+        case TR_OVERFLOW_DROP_NEWEST:
+            WARNING("Queue full, dropping newest packet");
+            break;
+
+        case TR_OVERFLOW_DROP_OLDEST:
+            WARNING("Queue full, dropping oldest packet");
+            FIFO_Discard(fifo_p);
+            status = FIFO_Push(fifo_p, packet_p);
+            break;
+
+        case TR_OVERFLOW_REPLACE_SAME_ROUTE:
+            queued_packet_p = FindPacketWithSameRoute(fifo_p, packet_p);
+            if (queued_packet_p != NULL)
+            {
+                WARNING("Queue full, replacing packet [%u->%u]",
+                        packet_p->header.source, packet_p->header.target);
+                *queued_packet_p = *packet_p;
+                status = true;
+            }
+            else
+            {
+                WARNING("Queue full, dropping newest packet");
+            }
+            break;
+
+        default:
+            sc_assert_fail();
+            break;
+    }
+
+    return status;
+}
+
+static packet_frame_type *FindPacketWithSameRoute(const struct fifo_t *fifo_p,
+        const packet_frame_type *packet_p)
+{
+    packet_frame_type *queued_packet_p;
+
+    for (uint8_t i = 0; (queued_packet_p = FIFO_At(fifo_p, i)) != NULL; ++i)
+    {
+        if (queued_packet_p->header.target == packet_p->header.target &&
+                queued_packet_p->header.source == packet_p->header.source)
+        {
+            return queued_packet_p;
+        }
+    }
+
+    return NULL;
+}
+
+static void UpdateHighWaterMark(struct transceiver_queue_statistics_t *statistics_p,
+                                uint8_t number_of_packets)
+{
+    if (number_of_packets > statistics_p->high_water_mark)
+    {
+        statistics_p->high_water_mark = number_of_packets;
+    }
+}
+
+static void Tune(uint8_t channel)
+{
+    libRFM69_SetCarrierFrequency(CHANNEL_BASE_FREQUENCY +
+                                 (uint32_t)channel * CHANNEL_SPACING);
 }
 
 static bool HandlePayload(void)
@@ -291,7 +507,12 @@ static bool HandlePayload(void)
     packet.header.rssi = libRFM69_GetRSSI();
 
     DUMPPACKET(&packet);
-    return FIFO_Push(&rx_packet_fifo, &packet);
+
+    bool status;
+    status = Enqueue(&rx_packet_fifo, &packet, &module.statistics.rx);
+    UpdateHighWaterMark(&module.statistics.rx, FIFO_Count(&rx_packet_fifo));
+
+    return status;
 }
 
 static transceiver_state_type ListeningStateMachine(void)
@@ -357,7 +578,7 @@ static transceiver_state_type SendingStateMachine(void)
             if (libRFM69_IsModeReady())
             {
                 packet_frame_type packet;
-                if (FIFO_Pop(&tx_packet_fifo, &packet))
+                if (PopPacketToSend(&packet))
                 {
                     DUMPPACKET(&packet);
                     libRFM69_WriteToFIFO((uint8_t *)&packet.header,
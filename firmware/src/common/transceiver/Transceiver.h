@@ -1,7 +1,7 @@
 /**
  * @file   Transceiver.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-24 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of the Transceiver interface.
  */
 
@@ -39,6 +39,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define CONTENT_DATA_SIZE 20
 _Static_assert(CONTENT_DATA_SIZE <= UINT8_MAX, "Invalid packet data size!");
 
+#define TR_NR_CHANNELS 6
+#define TR_RENDEZVOUS_CHANNEL 0
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -65,6 +68,39 @@ typedef struct
     packet_content_type content;
 } packet_frame_type;
 
+typedef enum
+{
+    TR_PRIORITY_NORMAL = 0,
+    TR_PRIORITY_HIGH,
+    TR_NR_PRIORITIES
+} transceiver_priority_type;
+
+typedef enum
+{
+    /* Discard the packet that is about to be queued. */
+    TR_OVERFLOW_DROP_NEWEST = 0,
+    /* Discard the oldest queued packet to make room. */
+    TR_OVERFLOW_DROP_OLDEST,
+    /**
+     * Overwrite a queued packet with the same source and target, if no such
+     * packet exists the new packet is discarded.
+     */
+    TR_OVERFLOW_REPLACE_SAME_ROUTE
+} transceiver_overflow_policy_type;
+
+struct transceiver_queue_statistics_t
+{
+    uint8_t high_water_mark;
+    uint16_t dropped;
+};
+
+struct transceiver_statistics_t
+{
+    /* One for each priority queue. */
+    struct transceiver_queue_statistics_t tx[TR_NR_PRIORITIES];
+    struct transceiver_queue_statistics_t rx;
+};
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -94,15 +130,74 @@ bool Transceiver_ReceivePacket(packet_frame_type *packet_p);
  * Send a packet.
  *
  * The packet is added to the send queue and is sent when the transceiver
- * is ready.
+ * is ready. Queued high priority packets are always sent before normal
+ * priority packets.
  *
  * @param target    Address of target.
  * @param content_p Pointer to packet content. A complete packet with a header
  *                  will be created from this content.
+ * @param priority  Priority of the packet.
+ *
+ * @return True if the packet was queued, otherwise false.
+ */
+bool Transceiver_SendPacket(uint8_t target,
+                            const packet_content_type *content_p,
+                            transceiver_priority_type priority);
+
+/**
+ * Change the radio channel.
+ *
+ * The channel can only be changed when the transceiver is idle, i.e. it's
+ * not sending, has no queued packets and no received payload waiting.
+ *
+ * @param channel Channel index in the channel plan, 0 to TR_NR_CHANNELS - 1.
+ *
+ * @return True if the channel was changed, otherwise false.
+ */
+bool Transceiver_SetChannel(uint8_t channel);
+
+/**
+ * Get the current radio channel.
  *
- * @return [description]
+ * @return Channel index in the channel plan.
+ */
+uint8_t Transceiver_GetChannel(void);
+
+/**
+ * Measure the received signal strength on a channel.
+ *
+ * The transceiver is briefly tuned to the channel and then returned to the
+ * current channel. The measurement is blocking and is only done when the
+ * transceiver is idle.
+ *
+ * @param channel Channel index in the channel plan.
+ * @param rssi_p  Pointer to location where the RSSI will be stored.
+ *
+ * @return True if the RSSI was measured, otherwise false.
+ */
+bool Transceiver_MeasureRSSI(uint8_t channel, int8_t *rssi_p);
+
+/**
+ * Set the policy used when a packet is added to a full queue.
+ *
+ * The policy applies to both the send and the receive queues, the default
+ * policy is TR_OVERFLOW_DROP_NEWEST.
+ *
+ * @param policy Overflow policy.
+ */
+void Transceiver_SetOverflowPolicy(transceiver_overflow_policy_type policy);
+
+/**
+ * Get the queue statistics.
+ *
+ * @param statistics_p Pointer to location where the statistics will be stored.
+ */
+void Transceiver_GetStatistics(struct transceiver_statistics_t *statistics_p);
+
+/**
+ * Reset the queue statistics.
  */
-bool Transceiver_SendPacket(uint8_t target, const packet_content_type *content_p);
+void Transceiver_ResetStatistics(void);
 
 /**
  * Handle events.
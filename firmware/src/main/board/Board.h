@@ -1,7 +1,7 @@
 /**
  * @file   Board.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Board support package for the main unit.
  */
 
@@ -39,6 +39,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define RTC_SPI_PORT    PORTB
 #define RTC_SPI_SS      DDB2
 #define RTC_SPI_MODE    1
+/* DS3234 SCLK max 4 MHz. */
+#define RTC_SPI_CLOCK_DIVIDER LIBSPI_CLOCK_DIV_2
 
 #define RTC_EXTERNAL_BATTERY true
 
@@ -46,6 +48,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define RFM69_SPI_PORT  PORTB
 #define RFM69_SPI_SS    DDB6
 #define RFM69_SPI_MODE  0
+/* RFM69 SCK max 10 MHz. */
+#define RFM69_SPI_CLOCK_DIVIDER LIBSPI_CLOCK_DIV_2
 
 #define RFM69_RESET_DDR     DDRC
 #define RFM69_RESET_PORT    PORTC
@@ -0,0 +1,245 @@
+/**
+ * @file   Channel.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Interference driven radio channel selection.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include "common.h"
+#include "libDebug.h"
+#include "Timer.h"
+#include "Time.h"
+#include "RTC.h"
+#include "Config.h"
+#include "Filter.h"
+#include "Packet.h"
+#include "Com.h"
+#include "Transceiver.h"
+#include "Channel.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define SURVEY_INTERVAL_MS      (10UL * 60UL * 1000UL)
+#define SURVEY_SAMPLES          4
+#define SWITCH_THRESHOLD_DB     6
+
+// Limits the RTC reads over SPI while waiting for a scheduled switch.
+#define SWITCH_POLL_INTERVAL_MS 1000
+
+/**
+ * Number of report intervals between the decision and the actual switch,
+ * gives all nodes a few chances to receive the announcement.
+ */
+#define SWITCH_DELAY_REPORTS    3
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+struct module_t
+{
+    struct filter_t noise_levels[TR_NR_CHANNELS];
+    uint32_t survey_timer;
+    uint8_t survey_channel;
+    struct
+    {
+        bool pending;
+        uint32_t poll_timer;
+        struct packet_channel_t announcement;
+    } change;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+static struct module_t module;
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+static bool SurveyChannel(uint8_t channel);
+static void SelectChannel(void);
+static void ScheduleSwitch(uint8_t channel);
+static bool GetTimestamp(uint32_t *timestamp_p);
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+void Channel_Init(void)
+{
+    module = (struct module_t) {0};
+    module.survey_timer = Timer_GetMilliseconds();
+}
+
+void Channel_Update(void)
+{
+    if (module.change.pending)
+    {
+        if (Timer_TimeDifference(module.change.poll_timer) >= SWITCH_POLL_INTERVAL_MS)
+        {
+            uint32_t timestamp;
+
+            module.change.poll_timer = Timer_GetMilliseconds();
+
+            if (GetTimestamp(&timestamp) &&
+                    timestamp >= module.change.announcement.switch_timestamp &&
+                    Transceiver_SetChannel(module.change.announcement.channel))
+            {
+                module.change.pending = false;
+            }
+        }
+    }
+    else if (Timer_TimeDifference(module.survey_timer) > SURVEY_INTERVAL_MS)
+    {
+        // One channel is surveyed per update to keep the main loop
+        // responsive. A busy transceiver aborts the measurement, the same
+        // channel is retried on next update.
+        if (SurveyChannel(module.survey_channel))
+        {
+            ++module.survey_channel;
+
+            if (module.survey_channel == TR_NR_CHANNELS)
+            {
+                module.survey_channel = 0;
+                SelectChannel();
+                module.survey_timer = Timer_GetMilliseconds();
+            }
+        }
+    }
+}
+
+void Channel_Announce(uint8_t target)
+{
+    if (module.change.pending)
+    {
+        Com_Send(target, COM_PACKET_TYPE_CHANNEL, &module.change.announcement,
+                 sizeof(module.change.announcement));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+static bool SurveyChannel(uint8_t channel)
+{
+    /**
+     * Interferers are often bursty, use the peak of a few samples to
+     * avoid missing them.
+     */
+    int8_t peak_rssi = INT8_MIN;
+
+    for (uint8_t i = 0; i < SURVEY_SAMPLES; ++i)
+    {
+        int8_t rssi;
+
+        if (!Transceiver_MeasureRSSI(channel, &rssi))
+        {
+            return false;
+        }
+
+        if (rssi > peak_rssi)
+        {
+            peak_rssi = rssi;
+        }
+    }
+
+    struct filter_t *noise_level_p = &module.noise_levels[channel];
+    if (Filter_IsInitialized(noise_level_p))
+    {
+        Filter_Process(noise_level_p, peak_rssi);
+    }
+    else
+    {
+        Filter_Init(noise_level_p, peak_rssi, FILTER_ALPHA(0.25));
+    }
+
+    DEBUG("Channel %u: %d dBm\r\n", channel, peak_rssi);
+
+    return true;
+}
+
+static void SelectChannel(void)
+{
+    int16_t noise_levels[TR_NR_CHANNELS];
+
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS; ++channel)
+    {
+        noise_levels[channel] = Filter_Output(&module.noise_levels[channel]);
+    }
+
+    const uint8_t current_channel = Transceiver_GetChannel();
+    uint8_t best_channel = current_channel;
+
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS; ++channel)
+    {
+        if (noise_levels[channel] < noise_levels[best_channel])
+        {
+            best_channel = channel;
+        }
+    }
+
+    // Use some hysteresis to avoid moving the network back and forth.
+    if (noise_levels[current_channel] - noise_levels[best_channel] >= SWITCH_THRESHOLD_DB)
+    {
+        ScheduleSwitch(best_channel);
+    }
+}
+
+static void ScheduleSwitch(uint8_t channel)
+{
+    uint32_t timestamp;
+
+    if (!GetTimestamp(&timestamp))
+    {
+        ERROR("Failed to schedule channel switch.");
+        return;
+    }
+
+    module.change.announcement.channel = channel;
+    module.change.announcement.switch_timestamp = timestamp +
+            SWITCH_DELAY_REPORTS * Config_GetReportInterval();
+    module.change.pending = true;
+    module.change.poll_timer = Timer_GetMilliseconds();
+
+    INFO("Channel switch scheduled: %u -> %u", Transceiver_GetChannel(), channel);
+}
+
+static bool GetTimestamp(uint32_t *timestamp_p)
+{
+    struct time_t time;
+
+    if (!RTC_GetCurrentTime(&time))
+    {
+        return false;
+    }
+
+    *timestamp_p = Time_ConvertToTimestamp(&time);
+    return true;
+}
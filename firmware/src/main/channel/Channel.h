@@ -0,0 +1,67 @@
+/**
+ * @file   Channel.h
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Interference driven radio channel selection.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CHANNEL_H_
+#define CHANNEL_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Initialize the channel selection.
+ */
+void Channel_Init(void);
+
+/**
+ * Update the channel selection.
+ *
+ * All channels in the channel plan are periodically surveyed, one channel
+ * per call, and a switch to a quieter channel is scheduled when the current
+ * channel is noisy. The switch is done when the scheduled time is reached,
+ * the RTC is checked at most once per second.
+ */
+void Channel_Update(void);
+
+/**
+ * Announce a scheduled channel switch to a node.
+ *
+ * Nothing is sent if no switch is scheduled.
+ *
+ * @param target Address of the node.
+ */
+void Channel_Announce(uint8_t target);
+
+#endif
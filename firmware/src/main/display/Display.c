@@ -1,7 +1,7 @@
 /**
  * @file   Display.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-06 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Display interface.
  */
 
@@ -28,7 +28,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "common.h"
 #include <string.h>
+#include <avr/pgmspace.h>
 #include "driverNHD223.h"
+#include "CRC.h"
 #include "Display.h"
 
 #ifdef DEBUG_ENABLE
@@ -44,14 +46,41 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define DISPLAY_HEIGHT 32
 #define DISPLAY_WIDTH 128
 
+#define SPAN_WIDTH 16
+#define SPANS_PER_PAGE (NHD223_NUMBER_OF_COLUMNS / SPAN_WIDTH)
+#define NR_SPANS (NHD223_NUMBER_OF_PAGES * SPANS_PER_PAGE)
+
+#ifdef DEBUG_ENABLE
+#define ALL_PAGES ((1 << NHD223_NUMBER_OF_PAGES) - 1)
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+enum mask_operation_t
+{
+    MASK_SET,
+    MASK_CLEAR,
+    MASK_INVERT
+};
+
+/**
+ * There is not enough RAM to retain a copy of the last flushed frame, a
+ * CRC of each span is kept instead. One span is always rewritten on each
+ * flush so that a CRC collision is healed within NR_SPANS flushes, at most
+ * 32 s with the periodic refresh of a static view.
+ */
 struct module_t
 {
     uint8_t VRAM[NHD223_NUMBER_OF_PAGES][NHD223_NUMBER_OF_COLUMNS];
+    uint16_t span_crcs[NHD223_NUMBER_OF_PAGES][SPANS_PER_PAGE];
+    uint8_t scrub_index;
+    bool invalidated;
     bool rotated;
+#ifdef DEBUG_ENABLE
+    uint8_t dirty_pages;
+#endif
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -64,6 +93,18 @@ static struct module_t module;
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
+static inline void OrColumnByte(uint8_t column, int8_t y, uint8_t data);
+static void MaskRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                          enum mask_operation_t operation);
+static void WriteSpans(uint8_t page, uint8_t first_span, uint8_t end_span);
+#ifndef DEBUG_ENABLE
+static void ConfigureController(void);
+#else
+static void DumpPages(uint8_t page_mask);
+static uint8_t EncodePage(uint8_t page, bool send);
+static void PutByte(uint8_t data);
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -72,14 +113,17 @@ void Display_Init(void)
 {
     //Do not init display hardware when debug is active, the debug
     //UART is using the same pins.
+    module.rotated = false;
+
 #ifndef DEBUG_ENABLE
     driverNHD223_Init();
-    driverNHD223_SetHorizontalAddressingMode();
+    ConfigureController();
     driverNHD223_SetColumnAddressRange(0, NHD223_NUMBER_OF_COLUMNS - 1);
     driverNHD223_SetPageAddressRange(0, NHD223_NUMBER_OF_PAGES - 1);
 #endif
 
-    module.rotated = false;
+    module.scrub_index = 0;
+    module.invalidated = true;
     Display_ClearVRAM();
 }
 
@@ -99,6 +143,7 @@ void Display_Off(void)
 
 void Display_Clear(void)
 {
+    module.invalidated = true;
     Display_ClearVRAM();
     Display_Flush();
 }
@@ -110,16 +155,50 @@ void Display_ClearVRAM()
 
 void Display_Flush(void)
 {
-#ifndef DEBUG_ENABLE
+    uint8_t span_index = 0;
+
     for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
     {
-        for (uint8_t column = 0; column < NHD223_NUMBER_OF_COLUMNS; ++column)
+        const uint8_t no_span = UINT8_MAX;
+        uint8_t first_dirty_span = no_span;
+
+        for (uint8_t span = 0; span < SPANS_PER_PAGE; ++span, ++span_index)
         {
-            driverNHD223_WriteData(module.VRAM[page][column]);
+            const uint16_t crc = CRC_16(&module.VRAM[page][span * SPAN_WIDTH], SPAN_WIDTH);
+
+            if (module.invalidated ||
+                span_index == module.scrub_index ||
+                crc != module.span_crcs[page][span])
+            {
+                module.span_crcs[page][span] = crc;
+
+                if (first_dirty_span == no_span)
+                {
+                    first_dirty_span = span;
+                }
+            }
+            else if (first_dirty_span != no_span)
+            {
+                WriteSpans(page, first_dirty_span, span);
+                first_dirty_span = no_span;
+            }
+        }
+
+        if (first_dirty_span != no_span)
+        {
+            WriteSpans(page, first_dirty_span, SPANS_PER_PAGE);
         }
     }
-#else
-    Display_DumpVRAMToUART();
+
+    module.scrub_index = (module.scrub_index + 1) % NR_SPANS;
+    module.invalidated = false;
+
+#ifdef DEBUG_ENABLE
+    if (module.dirty_pages != 0)
+    {
+        DumpPages(module.dirty_pages);
+        module.dirty_pages = 0;
+    }
 #endif
 }
 
@@ -127,6 +206,7 @@ void Display_Reset(void)
 {
 #ifndef DEBUG_ENABLE
     driverNHD223_ResetDisplay();
+    ConfigureController();
 #endif
     Display_Clear();
 }
@@ -146,12 +226,6 @@ void Display_SetPixel(uint8_t x, uint8_t y)
     uint8_t page_index;
     uint8_t page_offset;
 
-    if (module.rotated == true)
-    {
-        x = DISPLAY_WIDTH - x - 1;
-        y = DISPLAY_HEIGHT - y - 1;
-    }
-
     //Shift 3 bits to the right to divide by 8(page height) and floor value
     page_index = (y >> 3);
     page_offset = (y - (uint8_t)(page_index << 3));
@@ -162,29 +236,286 @@ void Display_SetPixel(uint8_t x, uint8_t y)
     }
 }
 
+void Display_DrawBitmap_P(uint8_t x, int8_t y, const uint8_t *data_p,
+                          uint8_t width, uint8_t height)
+{
+    sc_assert(data_p != NULL);
+
+    const uint8_t nr_pages = (height + 7) >> 3;
+
+    for (uint8_t column = 0; column < width; ++column, ++x)
+    {
+        if (x >= DISPLAY_WIDTH)
+        {
+            break;
+        }
+
+        for (uint8_t page = 0; page < nr_pages; ++page)
+        {
+            const uint8_t data = pgm_read_byte(data_p++);
+            const int8_t row = y + (int8_t)(page << 3);
+
+            if (data != 0x00)
+            {
+                OrColumnByte(x, row, data);
+            }
+        }
+    }
+}
+
+void Display_DrawColumn(uint8_t x, int8_t y, uint16_t data)
+{
+    if (x >= DISPLAY_WIDTH || data == 0x0000)
+    {
+        return;
+    }
+
+    OrColumnByte(x, y, (uint8_t)data);
+    OrColumnByte(x, y + 8, (uint8_t)(data >> 8));
+}
+
+void Display_FillRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    MaskRectangle(x, y, width, height, MASK_SET);
+}
+
+void Display_ClearRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    MaskRectangle(x, y, width, height, MASK_CLEAR);
+}
+
+void Display_InvertRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    MaskRectangle(x, y, width, height, MASK_INVERT);
+}
+
 void Display_Rotate(bool state)
 {
     module.rotated = state;
+#ifndef DEBUG_ENABLE
+    driverNHD223_SetRemap(state);
+#endif
+
+    //The controller has already remapped the old frame, rewrite all of it.
+    module.invalidated = true;
     Display_ClearVRAM();
 }
 
 #ifdef DEBUG_ENABLE
 void Display_DumpVRAMToUART(void)
 {
-    UART_Write("<VRAM>", 6);
+    DumpPages(ALL_PAGES);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * OR eight vertical pixels into VRAM, bit 0 is placed on row y. The byte is
+ * split over two pages if y is not page aligned, rows outside of the
+ * display are clipped.
+ */
+static inline void OrColumnByte(uint8_t column, int8_t y, uint8_t data)
+{
+    if (y < 0)
+    {
+        if (y > -8)
+        {
+            module.VRAM[0][column] |= (data >> -y);
+        }
+        return;
+    }
+
+    const uint8_t page = (uint8_t)y >> 3;
+    const uint8_t shift = (uint8_t)y & 0x07;
+
+    if (page < NHD223_NUMBER_OF_PAGES)
+    {
+        module.VRAM[page][column] |= (data << shift);
+
+        if (shift != 0 && page + 1 < NHD223_NUMBER_OF_PAGES)
+        {
+            module.VRAM[page + 1][column] |= (data >> (8 - shift));
+        }
+    }
+}
+
+/**
+ * Apply a row mask to each column of the rectangle, one page at a time.
+ */
+static void MaskRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+                          enum mask_operation_t operation)
+{
+    if (x >= DISPLAY_WIDTH || y >= DISPLAY_HEIGHT || width == 0 || height == 0)
+    {
+        return;
+    }
+
+    if (width > DISPLAY_WIDTH - x)
+    {
+        width = DISPLAY_WIDTH - x;
+    }
+
+    if (height > DISPLAY_HEIGHT - y)
+    {
+        height = DISPLAY_HEIGHT - y;
+    }
+
+    const uint8_t end_row = y + height;
+
+    while (y < end_row)
+    {
+        const uint8_t shift = y & 0x07;
+        uint8_t nr_rows = 8 - shift;
+
+        if (nr_rows > end_row - y)
+        {
+            nr_rows = end_row - y;
+        }
+
+        const uint8_t mask = (uint8_t)(((1 << nr_rows) - 1) << shift);
+        uint8_t *vram_p = &module.VRAM[y >> 3][x];
+
+        for (uint8_t column = 0; column < width; ++column)
+        {
+            switch (operation)
+            {
+                case MASK_CLEAR:
+                    vram_p[column] &= (uint8_t)~mask;
+                    break;
+                case MASK_INVERT:
+                    vram_p[column] ^= mask;
+                    break;
+                default:
+                    vram_p[column] |= mask;
+                    break;
+            }
+        }
+
+        y += nr_rows;
+    }
+}
+
+#ifndef DEBUG_ENABLE
+/**
+ * Configuration lost on a controller reset. Rotation is done by the
+ * controller with segment remap and reversed COM scan, the multiplex ratio
+ * must match the panel height for the reversed scan to start on the last
+ * panel row.
+ */
+static void ConfigureController(void)
+{
+    driverNHD223_SetHorizontalAddressingMode();
+    driverNHD223_SetMultiplexRatio(NHD223_NUMBER_OF_ROWS);
+    driverNHD223_SetRemap(module.rotated);
+}
+
+static void WriteSpans(uint8_t page, uint8_t first_span, uint8_t end_span)
+{
+    const uint8_t start_column = first_span * SPAN_WIDTH;
+    const uint8_t end_column = end_span * SPAN_WIDTH - 1;
+    const uint8_t column_offset = module.rotated ? NHD223_REMAPPED_COLUMN_OFFSET : 0;
+
+    driverNHD223_SetColumnAddressRange(start_column + column_offset,
+                                       end_column + column_offset);
+    driverNHD223_SetPageAddressRange(page, page);
+    driverNHD223_WriteDataBlock(&module.VRAM[page][start_column],
+                                end_column - start_column + 1);
+}
+#else
+/**
+ * The display is not used in debug builds, the pages with dirty spans are
+ * dumped to the UART after the flush instead.
+ */
+static void WriteSpans(uint8_t page, uint8_t first_span, uint8_t end_span)
+{
+    UNUSED(first_span);
+    UNUSED(end_span);
+    module.dirty_pages |= (1 << page);
+}
+
+/**
+ * The frame format is described in Display.h. The length is calculated
+ * with a first encoding pass so that the receiver can read a whole frame
+ * even if it contains line endings.
+ */
+static void DumpPages(uint8_t page_mask)
+{
+    uint16_t length = 1;
+
     for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
     {
-        uint8_t cnt = 0;
+        if (page_mask & (1 << page))
+        {
+            length += EncodePage(page, false);
+        }
+    }
+
+    UART_Write("<VRZ>", 5);
+    PutByte((uint8_t)length);
+    PutByte((uint8_t)(length >> 8));
+    PutByte(page_mask);
 
-        while (cnt != NHD223_NUMBER_OF_COLUMNS)
+    for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
+    {
+        if (page_mask & (1 << page))
         {
-            cnt += UART_Write(&(module.VRAM[page][cnt]), NHD223_NUMBER_OF_COLUMNS - cnt);
+            EncodePage(page, true);
         }
     }
+
     UART_Write("\r\n", 2);
 }
-#endif
 
-//////////////////////////////////////////////////////////////////////////
-//LOCAL FUNCTIONS
-//////////////////////////////////////////////////////////////////////////
+/**
+ * A zero byte is followed by the length of the zero run, all other bytes
+ * are sent as is.
+ */
+static uint8_t EncodePage(uint8_t page, bool send)
+{
+    const uint8_t *data_p = module.VRAM[page];
+    uint8_t length = 0;
+    uint8_t column = 0;
+
+    while (column < NHD223_NUMBER_OF_COLUMNS)
+    {
+        if (data_p[column] == 0x00)
+        {
+            uint8_t run = 0;
+
+            while (column < NHD223_NUMBER_OF_COLUMNS && data_p[column] == 0x00)
+            {
+                ++run;
+                ++column;
+            }
+
+            if (send == true)
+            {
+                PutByte(0x00);
+                PutByte(run);
+            }
+            length += 2;
+        }
+        else
+        {
+            if (send == true)
+            {
+                PutByte(data_p[column]);
+            }
+            ++length;
+            ++column;
+        }
+    }
+
+    return length;
+}
+
+static void PutByte(uint8_t data)
+{
+    while (UART_Write(&data, sizeof(data)) == 0)
+    {
+    }
+}
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file   Display.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Display interface.
  */
 
@@ -56,7 +56,7 @@ void Display_Off(void);
 /**
  * Clear the display.
  *
- * VRAM is cleared and flushed to the display.
+ * VRAM is cleared and the whole frame is flushed to the display.
  */
 void Display_Clear(void);
 
@@ -67,6 +67,8 @@ void Display_ClearVRAM(void);
 
 /**
  * Flush the VRAM to the display.
+ *
+ * Only the spans that have changed since the last flush are written.
  */
 void Display_Flush(void);
 
@@ -85,6 +87,73 @@ void Display_Reset(void);
  */
 void Display_SetPixel(uint8_t x, uint8_t y);
 
+/**
+ * Draw a bitmap stored in flash.
+ *
+ * The bitmap is stored column by column, each column as one byte per
+ * eight rows with the top row in the least significant bit. This is the
+ * same layout as VRAM so each byte is ORed in with at most two shifts.
+ * Pixels outside of the display are clipped.
+ *
+ * @param x      Left column of the bitmap.
+ * @param y      Top row of the bitmap, may be negative.
+ * @param data_p Pointer to the bitmap in flash.
+ * @param width  Bitmap width in pixels.
+ * @param height Bitmap height in pixels.
+ */
+void Display_DrawBitmap_P(uint8_t x, int8_t y, const uint8_t *data_p,
+                          uint8_t width, uint8_t height);
+
+/**
+ * Draw up to 16 vertical pixels in one column.
+ *
+ * Pixels outside of the display are clipped.
+ *
+ * @param x    Column.
+ * @param y    Top row, may be negative.
+ * @param data Pixels to set, top row in the least significant bit.
+ */
+void Display_DrawColumn(uint8_t x, int8_t y, uint16_t data);
+
+/**
+ * Set all pixels in a rectangle.
+ *
+ * VRAM is updated one byte per column and page using masks. Pixels outside
+ * of the display are clipped.
+ *
+ * @param x      Left column.
+ * @param y      Top row.
+ * @param width  Width in pixels.
+ * @param height Height in pixels.
+ */
+void Display_FillRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/**
+ * Clear all pixels in a rectangle.
+ *
+ * Same as Display_FillRectangle but the pixels are turned off, used to
+ * erase a region before it is redrawn.
+ *
+ * @param x      Left column.
+ * @param y      Top row.
+ * @param width  Width in pixels.
+ * @param height Height in pixels.
+ */
+void Display_ClearRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/**
+ * Invert all pixels in a rectangle.
+ *
+ * Same as Display_FillRectangle but the pixels are toggled, used to
+ * highlight a selection on top of already drawn content.
+ *
+ * @param x      Left column.
+ * @param y      Top row.
+ * @param width  Width in pixels.
+ * @param height Height in pixels.
+ */
+void Display_InvertRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
 /**
  * Set the display brightness.
  *
@@ -93,9 +162,11 @@ void Display_SetPixel(uint8_t x, uint8_t y);
 void Display_SetBrightness(uint8_t brightness);
 
 /**
- * Rotate display contents.
+ * Rotate display contents 180 degrees.
  *
- * The VRAM is cleared after the rotation.
+ * The rotation is done by the display controller, VRAM is always drawn in
+ * the logical orientation. The VRAM is cleared after the rotation and the
+ * next flush rewrites the whole frame.
  *
  * @param state Set to true if contents should be rotated.
  */
@@ -104,6 +175,16 @@ void Display_Rotate(bool state);
 #ifdef DEBUG_ENABLE
 /**
  * Dump the data in VRAM to debug UART.
+ *
+ * In debug builds Display_Flush only dumps the pages that have changed,
+ * using the same compressed frame format:
+ *
+ *   "<VRZ>" <length:16 LE> <page mask> <page data>... "\r\n"
+ *
+ * The length covers the page mask and page data. Bit n in the page mask is
+ * set if page n is included, pages are sent in ascending order. Each page
+ * decodes to 128 bytes: a 0x00 byte is followed by the number of zero
+ * bytes in the run, any other byte is a literal.
  */
 void Display_DumpVRAMToUART(void);
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   driverMCUTemperature.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-01-26 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  MCU temperature driver
  *
  * Driver for the internal MCU temperature sensor.
@@ -31,7 +31,6 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include "common.h"
 #include "ADC.h"
 #include "Sensor.h"
-#include "Timer.h"
 #include "Board.h"
 #include "libDebug.h"
 #include "driverMCUTemperature_Calibration.h"
@@ -42,6 +41,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 #define SAMPLE_PERIOD_MS 100
+#define EXTRA_BITS 2
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -55,7 +55,6 @@ struct mcu_sensor_t
         struct adc_channel_t channel;
         uint8_t index;
     } adc;
-    uint32_t timer;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -63,7 +62,6 @@ struct mcu_sensor_t
 //////////////////////////////////////////////////////////////////////////
 
 static void Update(struct sensor_t *super);
-static bool GetTemperature(struct mcu_sensor_t *self, int16_t *temperature);
 static int16_t ADCValueToTemperature(uint16_t adc_value);
 
 //////////////////////////////////////////////////////////////////////////
@@ -74,7 +72,8 @@ static struct mcu_sensor_t mcu_sensor =
 {
     .base =
     {
-        .Update = Update
+        .Update = Update,
+        .period_ms = SAMPLE_PERIOD_MS
     },
     .adc = {
         .index = 0x08
@@ -87,8 +86,7 @@ static struct mcu_sensor_t mcu_sensor =
 
 void driverMCUTemperature_Init(void)
 {
-    ADC_InitChannel(&mcu_sensor.adc.channel, mcu_sensor.adc.index);
-    mcu_sensor.timer = 0;
+    ADC_InitScanChannel(&mcu_sensor.adc.channel, mcu_sensor.adc.index, EXTRA_BITS, NULL);
 
     INFO("MCU temperature sensor initialized");
 }
@@ -105,23 +103,15 @@ struct sensor_t *driverMCUTemperature_GetSensor(void)
 static void Update(struct sensor_t *super)
 {
     struct mcu_sensor_t *self = (struct mcu_sensor_t *)super;
+    uint16_t adc_value;
 
-    if (Timer_TimeDifference(self->timer) > SAMPLE_PERIOD_MS)
+    if (ADC_GetScanResult(&self->adc.channel, &adc_value))
     {
-        GetTemperature(self, &self->base.value);
+        self->base.value = ADCValueToTemperature(adc_value);
         self->base.valid = true;
-        self->timer = Timer_GetMilliseconds();
     }
-}
-
-static bool GetTemperature(struct mcu_sensor_t *self, int16_t *temperature)
-{
-    uint16_t adc_value;
-
-    ADC_Convert(&self->adc.channel, &adc_value, 1);
-    *temperature = ADCValueToTemperature(adc_value);
 
-    return true;
+    ADC_StartScan();
 }
 
 static int16_t ADCValueToTemperature(uint16_t adc_value)
@@ -129,7 +119,7 @@ static int16_t ADCValueToTemperature(uint16_t adc_value)
     int32_t tmp_value;
     tmp_value = (int32_t)adc_value;
     tmp_value *= SUPPLY_VOLTAGE_mV;
-    tmp_value = tmp_value >> 10;
+    tmp_value = tmp_value >> (ADC_RESOLUTION_BITS + EXTRA_BITS);
     tmp_value -= 289; // Offset between mV and temp from Table 23-2 in datasheet.
     tmp_value = tmp_value * MCU_TEMP_SENSOR_CALIBRATION_K +
                 MCU_TEMP_SENSOR_CALIBRATION_M;
@@ -1,7 +1,7 @@
 /**
  * @file   SSD1305_Commands.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-10-16 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header with SSD1305 commands.
  */
 
@@ -47,6 +47,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define SSD1305_DISPLAYOFF          0xAE
 #define SSD1305_DISPLAYON           0xAF
 #define SSD1305_SET_PAGE            0xB0
+#define SSD1305_COMSCANINC          0xC0
 #define SSD1305_COMSCANDEC          0xC8
 #define SSD1305_SETDISPLAYOFFSET    0xD3
 #define SSD1305_SETDISPLAYCLOCKDIV  0xD5
@@ -1,7 +1,7 @@
 /**
  * @file   driverNHD223.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  NHD2.23(SSD1305) graphic OLED display driver.
  */
 
@@ -59,6 +59,9 @@ static inline void SetCommandMode(void);
 static inline void SetDataMode(void);
 static inline void SetWriteMode(void);
 static void WriteByte(uint8_t data);
+static inline void BeginDataStream(void);
+static inline void ClockByte(uint8_t data);
+static inline void EndDataStream(void);
 static void ClearDisplay(void);
 
 //////////////////////////////////////////////////////////////////////////
@@ -86,6 +89,20 @@ void driverNHD223_WriteData(uint8_t data)
     WriteByte(data);
 }
 
+void driverNHD223_WriteDataBlock(const uint8_t *data_p, size_t length)
+{
+    sc_assert(data_p != NULL);
+
+    BeginDataStream();
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        ClockByte(data_p[i]);
+    }
+
+    EndDataStream();
+}
+
 void driverNHD223_ResetDisplay(void)
 {
     /* According to the SSD1305 datasheet, the minimum reset pulse width is 3 µs. */
@@ -101,6 +118,28 @@ void driverNHD223_SetHorizontalAddressingMode(void)
     driverNHD223_WriteCommand(SSD1305_HORIZONTALADDRESSINGMODE);
 }
 
+void driverNHD223_SetMultiplexRatio(uint8_t ratio)
+{
+    sc_assert(ratio >= 16 && ratio <= 64);
+
+    driverNHD223_WriteCommand(SSD1305_SETMULTIPLEX);
+    driverNHD223_WriteCommand(ratio - 1);
+}
+
+void driverNHD223_SetRemap(bool remapped)
+{
+    if (remapped == true)
+    {
+        driverNHD223_WriteCommand(SSD1305_SEGREMAP1);
+        driverNHD223_WriteCommand(SSD1305_COMSCANDEC);
+    }
+    else
+    {
+        driverNHD223_WriteCommand(SSD1305_SEGREMAP);
+        driverNHD223_WriteCommand(SSD1305_COMSCANINC);
+    }
+}
+
 void driverNHD223_SetPageAddress(uint8_t address)
 {
     sc_assert(address < NHD223_NUMBER_OF_PAGES);
@@ -194,15 +233,46 @@ static void WriteByte(uint8_t data)
     DisableDataLatch();
 }
 
+/**
+ * Prepare the bus for a sequence of data writes, the device stays
+ * selected until EndDataStream is called.
+ */
+static inline void BeginDataStream(void)
+{
+    SetWriteMode();
+    SetDataMode();
+    SelectDevice();
+}
+
+/**
+ * The data is latched on the falling edge of E while the device is
+ * selected.
+ */
+static inline void ClockByte(uint8_t data)
+{
+    EnableDataLatch();
+    Board_NHD223_SetDataPins(data);
+    DisableDataLatch();
+}
+
+static inline void EndDataStream(void)
+{
+    ReleaseDevice();
+}
+
 static void ClearDisplay(void)
 {
     for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
     {
         driverNHD223_SetPageAddress(page);
 
+        BeginDataStream();
+
         for(uint8_t column = 0; column < NHD223_NUMBER_OF_COLUMNS; ++column)
         {
-            driverNHD223_WriteData(0x00);
+            ClockByte(0x00);
         }
+
+        EndDataStream();
     }
 }
@@ -1,7 +1,7 @@
 /**
  * @file   driverNHD223.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-26 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  NHD2.23(SSD1305) graphic OLED display driver.
  */
 
@@ -30,6 +30,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 #include "SSD1305_Commands.h"
 
 //////////////////////////////////////////////////////////////////////////
@@ -38,6 +40,13 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define NHD223_NUMBER_OF_PAGES      4
 #define NHD223_NUMBER_OF_COLUMNS    128
+#define NHD223_NUMBER_OF_ROWS       32
+
+// The SSD1305 drives 132 segments but only the first 128 are connected to the
+// panel. With the segment remap active the visible columns start at column
+// address 4 instead.
+#define NHD223_NUMBER_OF_SEGMENTS       132
+#define NHD223_REMAPPED_COLUMN_OFFSET   (NHD223_NUMBER_OF_SEGMENTS - NHD223_NUMBER_OF_COLUMNS)
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -66,6 +75,17 @@ void driverNHD223_WriteCommand(uint8_t command);
  */
 void driverNHD223_WriteData(uint8_t data);
 
+/**
+ * Write a block of data to the display.
+ *
+ * The bus direction and register select are configured once and the
+ * device is kept selected while the bytes are clocked out.
+ *
+ * @param data_p Data to write.
+ * @param length Number of bytes to write.
+ */
+void driverNHD223_WriteDataBlock(const uint8_t *data_p, size_t length);
+
 /**
  * Reset the display.
  *
@@ -81,6 +101,23 @@ void driverNHD223_ResetDisplay(void);
  */
 void driverNHD223_SetHorizontalAddressingMode(void);
 
+/**
+ * Set the number of COM lines that are scanned.
+ *
+ * @param ratio Number of rows, 16-64.
+ */
+void driverNHD223_SetMultiplexRatio(uint8_t ratio);
+
+/**
+ * Set the segment remap and COM scan direction.
+ *
+ * With remap active the image is rotated 180 degrees by the display
+ * controller, see NHD223_REMAPPED_COLUMN_OFFSET.
+ *
+ * @param remapped True to remap both columns and rows.
+ */
+void driverNHD223_SetRemap(bool remapped);
+
 /**
  * Set the active page address.
  *
@@ -1,7 +1,7 @@
 /**
  * @file   driverNTC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-12 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  NTC sensor driver
  *
  * Driver for NTC sensors.
@@ -34,24 +34,25 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include <avr/pgmspace.h>
 #include "ADC.h"
 #include "Sensor.h"
-#include "Timer.h"
 #include "Filter.h"
 #include "libDebug.h"
 #include "driverNTC.h"
+#include "ntc_table.h"
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
 #define SAMPLE_PERIOD_MS 100
-#define LUT_SIZE 819
+
+// Oversampling already removes most of the noise, keep the filter short.
+// The smoothing factor is 1/2^FILTER_SHIFT.
+#define FILTER_SHIFT 1
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
-enum lookup_table_type {GENERIC, MF52};
-
 struct ntc_sensor_t
 {
     struct sensor_t base;
@@ -60,15 +61,8 @@ struct ntc_sensor_t
         struct adc_channel_t channel;
         uint8_t index;
     } adc;
-    struct filter_t filter;
-    uint32_t timer;
-    enum lookup_table_type lut_type;
-};
-
-struct lookup_table_t
-{
-    uint16_t offset;
-    uint16_t temperatures[LUT_SIZE];
+    struct filter_shift_t filter;
+    enum ntc_type_t type;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -76,143 +70,37 @@ struct lookup_table_t
 //////////////////////////////////////////////////////////////////////////
 
 static void Update(struct sensor_t *super_p);
-static bool GetTemperature(struct ntc_sensor_t *self_p, int16_t *temperature_p);
-static bool ADCValueToTemperature(uint16_t adc_value, int16_t *temperature_p, size_t lut_index);
-static bool IsValid(uint16_t adc_value, size_t lut_index);
+static bool ADCValueToTemperature(uint16_t adc_value, int16_t *temperature_p, enum ntc_type_t type);
+static struct ntc_breakpoint_t GetBreakpoint(uint16_t index);
 static int16_t FilterTemperature(struct ntc_sensor_t *self_p, int16_t temperature);
 
 //////////////////////////////////////////////////////////////////////////
 //VARIABLES
 //////////////////////////////////////////////////////////////////////////
 
-static const struct lookup_table_t ntc_lut[2] PROGMEM =
-{
-    {
-        .offset = 120,
-        .temperatures = {
-            -201, -199, -197, -195, -194, -192, -190, -188, -187, -185, -183, -181, -180, -178,
-                -176, -175, -173, -172, -170, -168, -167, -165, -163, -162, -160, -159, -157, -156,
-                -154, -152, -151, -149, -148, -146, -145, -143, -142, -140, -139, -137, -136, -134,
-                -133, -131, -130, -129, -127, -126, -124, -123, -121, -120, -119, -117, -116, -114,
-                -113, -112, -110, -109, -107, -106, -105, -103, -102, -101, -99, -98, -97, -95, -94,
-                -93, -91, -90, -89, -87, -86, -85, -83, -82, -81, -79, -78, -77, -76, -74, -73, -72,
-                -71, -69, -68, -67, -66, -64, -63, -62, -61, -59, -58, -57, -56, -54, -53, -52, -51,
-                -50, -48, -47, -46, -45, -43, -42, -41, -40, -39, -38, -36, -35, -34, -33, -32, -30,
-                -29, -28, -27, -26, -25, -23, -22, -21, -20, -19, -18, -17, -15, -14, -13, -12, -11,
-                -10, -9, -7, -6, -5, -4, -3, -2, -1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 14, 15, 16,
-                17, 18, 19, 20, 21, 22, 23, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 39, 40,
-                41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 59, 60, 61, 62, 63,
-                64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85,
-                86, 87, 88, 89, 90, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106,
-                107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
-                124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140,
-                141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157,
-                158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174,
-                175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191,
-                192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208,
-                209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225,
-                226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242,
-                243, 244, 245, 246, 247, 248, 249, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260,
-                261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 278,
-                279, 280, 281, 282, 283, 284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 296,
-                297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 310, 311, 312, 313, 314,
-                315, 316, 317, 318, 319, 320, 321, 323, 324, 325, 326, 327, 328, 329, 330, 331, 333,
-                334, 335, 336, 337, 338, 339, 340, 341, 343, 344, 345, 346, 347, 348, 349, 351, 352,
-                353, 354, 355, 356, 357, 359, 360, 361, 362, 363, 364, 365, 367, 368, 369, 370, 371,
-                372, 374, 375, 376, 377, 378, 380, 381, 382, 383, 384, 385, 387, 388, 389, 390, 391,
-                393, 394, 395, 396, 397, 399, 400, 401, 402, 404, 405, 406, 407, 409, 410, 411, 412,
-                413, 415, 416, 417, 418, 420, 421, 422, 424, 425, 426, 427, 429, 430, 431, 432, 434,
-                435, 436, 438, 439, 440, 442, 443, 444, 445, 447, 448, 449, 451, 452, 453, 455, 456,
-                457, 459, 460, 461, 463, 464, 466, 467, 468, 470, 471, 472, 474, 475, 477, 478, 479,
-                481, 482, 484, 485, 486, 488, 489, 491, 492, 494, 495, 496, 498, 499, 501, 502, 504,
-                505, 507, 508, 510, 511, 513, 514, 516, 517, 519, 520, 522, 523, 525, 526, 528, 529,
-                531, 532, 534, 536, 537, 539, 540, 542, 543, 545, 547, 548, 550, 551, 553, 555, 556,
-                558, 560, 561, 563, 565, 566, 568, 570, 571, 573, 575, 576, 578, 580, 581, 583, 585,
-                587, 588, 590, 592, 594, 595, 597, 599, 601, 603, 604, 606, 608, 610, 612, 614, 615,
-                617, 619, 621, 623, 625, 627, 629, 631, 632, 634, 636, 638, 640, 642, 644, 646, 648,
-                650, 652, 654, 656, 658, 660, 662, 665, 667, 669, 671, 673, 675, 677, 679, 682, 684,
-                686, 688, 690, 693, 695, 697, 699, 702, 704, 706, 708, 711, 713, 715, 718, 720, 722,
-                725, 727, 730, 732, 735, 737, 740, 742, 745, 747, 750, 752, 755, 757, 760, 763, 765,
-                768, 771, 773, 776, 779, 782, 784, 787, 790, 793, 796, 798, 801, 804, 807, 810, 813,
-                816, 819, 822, 825, 828, 831, 835, 838, 841, 844, 847, 851, 854, 857, 861, 864, 867,
-                871, 874, 878, 881, 885, 888, 892, 896, 899, 903, 907, 911, 915, 918, 922, 926, 930,
-                934, 938, 942, 947, 951, 955, 959, 964, 968, 973, 977, 982, 986, 991, 995, 1000, 1005,
-                1010, 1015, 1020, 1025, 1030, 1035, 1040, 1046, 1051
-            }
-    },
-    {
-        .offset = 147,
-        .temperatures = {
-            -104, -103, -101, -100, -98, -97, -96, -94, -93, -92, -90, -89, -88, -86, -85, -84, -83,
-                -81, -80, -79, -77, -76, -75, -74, -72, -71, -70, -69, -67, -66, -65, -64, -62, -61, -60,
-                -59, -58, -56, -55, -54, -53, -52, -50, -49, -48, -47, -46, -45, -43, -42, -41, -40, -39,
-                -38, -37, -35, -34, -33, -32, -31, -30, -29, -28, -26, -25, -24, -23, -22, -21, -20, -19,
-                -18, -17, -15, -14, -13, -12, -11, -10, -9, -8, -7, -6, -5, -4, -3, -2, -1, 0, 2, 3, 4,
-                5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
-                29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 44, 45, 46, 47, 48, 49, 50,
-                51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72,
-                73, 74, 75, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 86, 87, 88, 89, 90, 91, 92, 93,
-                94, 95, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 104, 105, 106, 107, 108, 109, 110, 111,
-                112, 112, 113, 114, 115, 116, 117, 118, 119, 120, 120, 121, 122, 123, 124, 125, 126, 127,
-                127, 128, 129, 130, 131, 132, 133, 134, 134, 135, 136, 137, 138, 139, 140, 141, 141, 142,
-                143, 144, 145, 146, 147, 147, 148, 149, 150, 151, 152, 153, 154, 154, 155, 156, 157, 158,
-                159, 160, 160, 161, 162, 163, 164, 165, 166, 166, 167, 168, 169, 170, 171, 172, 172, 173,
-                174, 175, 176, 177, 178, 179, 179, 180, 181, 182, 183, 184, 185, 185, 186, 187, 188, 189,
-                190, 191, 191, 192, 193, 194, 195, 196, 197, 197, 198, 199, 200, 201, 202, 203, 203, 204,
-                205, 206, 207, 208, 209, 210, 210, 211, 212, 213, 214, 215, 216, 216, 217, 218, 219, 220,
-                221, 222, 223, 223, 224, 225, 226, 227, 228, 229, 229, 230, 231, 232, 233, 234, 235, 236,
-                236, 237, 238, 239, 240, 241, 242, 243, 243, 244, 245, 246, 247, 248, 249, 250, 250, 251,
-                252, 253, 254, 255, 256, 257, 257, 258, 259, 260, 261, 262, 263, 264, 265, 265, 266, 267,
-                268, 269, 270, 271, 272, 273, 274, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 283,
-                284, 285, 286, 287, 288, 289, 290, 291, 292, 293, 293, 294, 295, 296, 297, 298, 299, 300,
-                301, 302, 303, 304, 304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317,
-                318, 318, 319, 320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334,
-                335, 336, 337, 338, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351,
-                352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367, 368, 369,
-                370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 383, 384, 385, 386, 387, 388,
-                389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399, 400, 402, 403, 404, 405, 406, 407,
-                408, 409, 410, 411, 412, 414, 415, 416, 417, 418, 419, 420, 421, 422, 423, 425, 426, 427,
-                428, 429, 430, 431, 433, 434, 435, 436, 437, 438, 439, 441, 442, 443, 444, 445, 446, 448,
-                449, 450, 451, 452, 454, 455, 456, 457, 458, 460, 461, 462, 463, 464, 466, 467, 468, 469,
-                471, 472, 473, 474, 476, 477, 478, 479, 481, 482, 483, 485, 486, 487, 488, 490, 491, 492,
-                494, 495, 496, 498, 499, 500, 502, 503, 504, 506, 507, 508, 510, 511, 512, 514, 515, 516,
-                518, 519, 521, 522, 523, 525, 526, 528, 529, 531, 532, 533, 535, 536, 538, 539, 541, 542,
-                544, 545, 547, 548, 550, 551, 553, 554, 556, 557, 559, 560, 562, 563, 565, 567, 568, 570,
-                571, 573, 575, 576, 578, 579, 581, 583, 584, 586, 588, 589, 591, 593, 594, 596, 598, 599,
-                601, 603, 605, 606, 608, 610, 612, 613, 615, 617, 619, 621, 623, 624, 626, 628, 630, 632,
-                634, 636, 638, 639, 641, 643, 645, 647, 649, 651, 653, 655, 657, 659, 661, 663, 665, 667,
-                670, 672, 674, 676, 678, 680, 682, 685, 687, 689, 691, 693, 696, 698, 700, 703, 705, 707,
-                709, 712, 714, 717, 719, 721, 724, 726, 729, 731, 734, 736, 739, 742, 744, 747, 749, 752,
-                755, 757, 760, 763, 766, 769, 771, 774, 777, 780, 783, 786, 789, 792, 795, 798, 801, 804,
-                807, 810, 814, 817, 820, 823, 827, 830, 833, 837, 840, 844, 847, 851, 855, 858, 862, 866,
-                869, 873, 877, 881, 885, 889, 893, 897, 901, 906, 910, 914, 919, 923, 928, 932, 937, 942,
-                946, 951, 956, 961, 966, 971, 977, 982, 987, 993, 998, 1004, 1010, 1016, 1022, 1028, 1034,
-                1040, 1047, 1053
-            }
-    }
-};
-
 static struct ntc_sensor_t ntc_sensors[] =
 {
     {
         .base =
         {
-            .Update = Update
+            .Update = Update,
+            .period_ms = SAMPLE_PERIOD_MS
         },
         .adc = {
             .index = 0x06
         },
-        .lut_type = GENERIC
+        .type = NTC_TYPE_GENERIC
     },
     {
         .base =
         {
-            .Update = Update
+            .Update = Update,
+            .period_ms = SAMPLE_PERIOD_MS
         },
         .adc = {
             .index = 0x07
         },
-        .lut_type = MF52
+        .type = NTC_TYPE_MF52
     }
 };
 
@@ -224,7 +112,10 @@ void driverNTC_Init(void)
 {
     for (size_t i = 0; i < ElementsIn(ntc_sensors); ++i)
     {
-        ADC_InitChannel(&ntc_sensors[i].adc.channel, ntc_sensors[i].adc.index);
+        ADC_InitScanChannel(&ntc_sensors[i].adc.channel,
+                            ntc_sensors[i].adc.index,
+                            NTC_TABLE_EXTRA_BITS,
+                            NULL);
     }
 
     INFO("NTC sensors initialized");
@@ -244,12 +135,13 @@ struct sensor_t *driverNTC_GetSensor(size_t id)
 static void Update(struct sensor_t *super_p)
 {
     struct ntc_sensor_t *self_p = (struct ntc_sensor_t *)super_p;
+    uint16_t adc_value;
 
-    if (Timer_TimeDifference(self_p->timer) > SAMPLE_PERIOD_MS)
+    if (ADC_GetScanResult(&self_p->adc.channel, &adc_value))
     {
         int16_t temperature;
 
-        if (GetTemperature(self_p, &temperature))
+        if (ADCValueToTemperature(adc_value, &temperature, self_p->type))
         {
             self_p->base.value = FilterTemperature(self_p, temperature);
             self_p->base.valid = true;
@@ -258,52 +150,72 @@ static void Update(struct sensor_t *super_p)
         {
             self_p->base.valid = false;
         }
-
-        self_p->timer = Timer_GetMilliseconds();
     }
-}
-
-static bool GetTemperature(struct ntc_sensor_t *self_p, int16_t *temperature_p)
-{
-    uint16_t adc_value;
 
-    ADC_Convert(&self_p->adc.channel, &adc_value, 1);
-    return ADCValueToTemperature(adc_value, temperature_p, self_p->lut_type);
+    // The result is read one period after the scan is started. The scan
+    // samples all registered channels, starting it while it is already
+    // running does nothing.
+    ADC_StartScan();
 }
 
-static bool ADCValueToTemperature(uint16_t adc_value, int16_t *temperature_p, size_t lut_index)
+/**
+ * Interpolate linearly between the two breakpoints surrounding the
+ * oversampled ADC value. Values outside of the table are invalid.
+ */
+static bool ADCValueToTemperature(uint16_t adc_value, int16_t *temperature_p, enum ntc_type_t type)
 {
-    if (IsValid(adc_value, lut_index))
-    {
-        const uint16_t offset = pgm_read_word(&ntc_lut[lut_index].offset);
+    uint16_t low = pgm_read_word(&ntc_table_first[type]);
+    uint16_t high = pgm_read_word(&ntc_table_first[type + 1]) - 1;
 
-        *temperature_p = pgm_read_word(&ntc_lut[lut_index].temperatures[adc_value - offset]);
-        return true;
-    }
-    else
+    if (adc_value < GetBreakpoint(low).adc_value || adc_value > GetBreakpoint(high).adc_value)
     {
         return false;
     }
+
+    while (high - low > 1)
+    {
+        const uint16_t middle = (low + high) / 2;
+
+        if (adc_value < GetBreakpoint(middle).adc_value)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle;
+        }
+    }
+
+    const struct ntc_breakpoint_t start = GetBreakpoint(low);
+    const struct ntc_breakpoint_t end = GetBreakpoint(high);
+    const uint16_t span = end.adc_value - start.adc_value;
+
+    // The temperatures are increasing, so the numerator is never negative.
+    *temperature_p = start.temperature +
+                     ((int32_t)(end.temperature - start.temperature) * (adc_value - start.adc_value) +
+                      span / 2) / span;
+    return true;
 }
 
-static bool IsValid(uint16_t adc_value, size_t lut_index)
+static struct ntc_breakpoint_t GetBreakpoint(uint16_t index)
 {
-    const uint16_t offset = pgm_read_word(&ntc_lut[lut_index].offset);
-
-    return (adc_value >= offset) &&
-           (adc_value - offset < ElementsIn(ntc_lut[lut_index].temperatures));
+    return (struct ntc_breakpoint_t)
+    {
+        .adc_value = pgm_read_word(&ntc_breakpoints[index].adc_value),
+        .temperature = (int16_t)pgm_read_word(&ntc_breakpoints[index].temperature)
+    };
 }
 
 static int16_t FilterTemperature(struct ntc_sensor_t *self_p, int16_t temperature)
 {
-    if (Filter_IsInitialized(&self_p->filter))
+    if (Filter_ShiftIsInitialized(&self_p->filter))
     {
-        Filter_Process(&self_p->filter, temperature);
+        Filter_ShiftProcess(&self_p->filter, temperature);
     }
     else
     {
-        Filter_Init(&self_p->filter, temperature, FILTER_ALPHA(0.1));
+        Filter_ShiftInit(&self_p->filter, temperature, FILTER_SHIFT);
     }
 
-    return Filter_Output(&self_p->filter);
+    return Filter_ShiftOutput(&self_p->filter);
 }
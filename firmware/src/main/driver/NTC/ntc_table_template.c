@@ -0,0 +1,33 @@
+/**
+ * @file   ntc_table.c
+ * @Author {author}
+ * @date   {date}
+ * @brief  {brief}
+ *
+ * Detailed description of file.
+ */
+
+/*
+ * THIS FILE IS GENERATED, DO NOT EDIT!
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#include "ntc_table.h"
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+const struct ntc_breakpoint_t ntc_breakpoints[NTC_TABLE_NR_BREAKPOINTS] PROGMEM =
+{{
+{breakpoints}}};
+
+const uint16_t ntc_table_first[NTC_NR_TYPES + 1] PROGMEM =
+{{
+{table_first}}};
@@ -0,0 +1,57 @@
+/**
+ * @file   ntc_table.h
+ * @Author {author}
+ * @date   {date}
+ * @brief  {brief}
+ *
+ * Detailed description of file.
+ */
+
+/*
+ * THIS FILE IS GENERATED, DO NOT EDIT!
+*/
+
+#ifndef NTC_TABLE_H_
+#define NTC_TABLE_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+// Bits of oversampling in the ADC values the tables are indexed with.
+#define NTC_TABLE_EXTRA_BITS {extra_bits}
+
+#define NTC_TABLE_NR_BREAKPOINTS {nr_breakpoints}
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+enum ntc_type_t
+{{
+{ntc_types}    NTC_NR_TYPES
+}};
+
+/* Temperatures in tenths of a degree, increasing with the ADC value. */
+struct ntc_breakpoint_t
+{{
+    uint16_t adc_value;
+    int16_t temperature;
+}};
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+/* The breakpoints of type t are ntc_table_first[t] to ntc_table_first[t + 1] - 1. */
+extern const struct ntc_breakpoint_t ntc_breakpoints[NTC_TABLE_NR_BREAKPOINTS] PROGMEM;
+extern const uint16_t ntc_table_first[NTC_NR_TYPES + 1] PROGMEM;
+
+#endif
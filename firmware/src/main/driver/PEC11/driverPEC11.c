@@ -1,7 +1,7 @@
 /**
  * @file   driverPEC11.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-04-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Driver for Bourns PEC11 series rotary encoder with push button.
  */
 
@@ -30,6 +30,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 
 #include "libDebug.h"
 #include "Timer.h"
@@ -42,6 +43,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define PUSH_TIME_MS 1000
 
+//Latch edges closer than this are treated as contact bounce.
+#define DEBOUNCE_TIME_MS 2
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -50,8 +54,7 @@ struct module_t
 {
     volatile struct
     {
-        uint8_t right;
-        uint8_t left;
+        int8_t rotation;
         struct
         {
             uint32_t timer;
@@ -62,6 +65,7 @@ struct module_t
     {
         bool latch;
         bool button;
+        uint32_t latch_timer;
     } states;
 };
 
@@ -97,17 +101,34 @@ ISR(PCINT0_vect)
     if (module.states.latch != latch_state)
     {
         /**
-         * The offset between the latch signal and the direction signal
-         * determines the rotation direction.
+         * Only the first edge of a bounce train is counted, the debounce
+         * time is restarted by every edge so the train is ignored until
+         * the contacts have settled.
          */
-        if (latch_state != GetDirectionState())
-        {
-            module.signals.right = 1;
-        }
-        else
+        if (Timer_TimeDifference(module.states.latch_timer) >= DEBOUNCE_TIME_MS)
         {
-            module.signals.left = 1;
+            /**
+             * The offset between the latch signal and the direction signal
+             * determines the rotation direction. Detents are counted until
+             * popped so that none are lost while the main loop is busy.
+             */
+            if (latch_state != GetDirectionState())
+            {
+                if (module.signals.rotation < INT8_MAX)
+                {
+                    ++module.signals.rotation;
+                }
+            }
+            else
+            {
+                if (module.signals.rotation > INT8_MIN)
+                {
+                    --module.signals.rotation;
+                }
+            }
         }
+
+        module.states.latch_timer = Timer_GetMilliseconds();
     }
 
     /**
@@ -155,21 +176,25 @@ void driverPEC11_Init(void)
         .states =
         {
             .latch = GetLatchState(),
-            .button = GetButtonState()
+            .button = GetButtonState(),
+            .latch_timer = 0
         }
     };
 
     INFO("PEC11 driver initialized");
 }
 
-bool driverPEC11_PopLeftRotation(void)
+int8_t driverPEC11_PopRotation(void)
 {
-    return PopSignal(&module.signals.left);
-}
+    int8_t rotation;
 
-bool driverPEC11_PopRightRotation(void)
-{
-    return PopSignal(&module.signals.right);
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        rotation = module.signals.rotation;
+        module.signals.rotation = 0;
+    }
+
+    return rotation;
 }
 
 bool driverPEC11_PopBriefPush(void)
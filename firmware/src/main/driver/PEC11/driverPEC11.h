@@ -1,7 +1,7 @@
 /**
  * @file   driverPEC11.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-04-08 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Driver for Bourns PEC11 series rotary encoder with push button.
  */
 
@@ -50,20 +50,12 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 void driverPEC11_Init(void);
 
 /**
- * Check if any left rotations has been recorded and
- * remove one rotation if possible.
+ * Get and clear the number of detents rotated since the last call.
  *
- * @return True if a rotation was present and removed.
+ * @return Number of detents, positive for right and negative for left
+ *         rotation.
  */
-bool driverPEC11_PopLeftRotation(void);
-
-/**
- * Check if any right rotations has been recorded and
- * remove one rotation if possible.
- *
- * @return True if a rotation was present and removed.
- */
-bool driverPEC11_PopRightRotation(void);
+int8_t driverPEC11_PopRotation(void);
 
 /**
  * Check if any brief pushes has been recorded and
@@ -1,7 +1,7 @@
 /**
  * @file   Encoder.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-09-17 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Module for handling rotary encoders.
  */
 
@@ -30,12 +30,21 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "driverPEC11.h"
 #include "libDebug.h"
+#include "Timer.h"
 #include "Encoder.h"
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
+//Time per detent below which the step size is increased.
+#define ACCELERATION_FAST_MS    20
+#define ACCELERATION_MEDIUM_MS  50
+
+#define STEP_SIZE_FAST      5
+#define STEP_SIZE_MEDIUM    2
+#define STEP_SIZE_DEFAULT   1
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -43,6 +52,13 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 struct module_t
 {
     struct encoder_callbacks_t callbacks;
+    encoder_activity_callback_t activity_callback;
+    struct
+    {
+        uint32_t timer;
+        uint8_t step_size;
+        bool right;
+    } rotation;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -55,6 +71,10 @@ static struct module_t module;
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
+static void UpdateStepSize(int8_t rotation);
+static void Rotate(int8_t rotation);
+static bool RegisterActivity(void);
+
 //////////////////////////////////////////////////////////////////////////
 //INTERUPT SERVICE ROUTINES
 //////////////////////////////////////////////////////////////////////////
@@ -65,7 +85,17 @@ static struct module_t module;
 
 void Encoder_Init(void)
 {
-    module = (struct module_t) { {0}};
+    module = (struct module_t)
+    {
+        .callbacks = {0},
+        .activity_callback = NULL,
+        .rotation =
+        {
+            .timer = 0,
+            .step_size = STEP_SIZE_DEFAULT,
+            .right = false
+        }
+    };
     driverPEC11_Init();
 
     INFO("Encoder module initialized");
@@ -73,21 +103,39 @@ void Encoder_Init(void)
 
 void Encoder_Update(void)
 {
-    if (module.callbacks.right != NULL && driverPEC11_PopRightRotation())
+    int8_t rotation = 0;
+
+    /**
+     * The driver only keeps the net rotation, which can't be split by
+     * direction. Leave it in the driver until both directions are handled
+     * instead of losing the detents in the unhandled direction.
+     */
+    if (module.callbacks.right != NULL && module.callbacks.left != NULL)
     {
-        module.callbacks.right();
+        rotation = driverPEC11_PopRotation();
     }
-    else if (module.callbacks.left != NULL && driverPEC11_PopLeftRotation())
+
+    if (rotation != 0)
     {
-        module.callbacks.left();
+        UpdateStepSize(rotation);
+        if (RegisterActivity() == true)
+        {
+            Rotate(rotation);
+        }
     }
     else if (module.callbacks.brief_push != NULL && driverPEC11_PopBriefPush())
     {
-        module.callbacks.brief_push();
+        if (RegisterActivity() == true)
+        {
+            module.callbacks.brief_push();
+        }
     }
     else if (module.callbacks.extended_push != NULL && driverPEC11_PopExtendedPush())
     {
-        module.callbacks.extended_push();
+        if (RegisterActivity() == true)
+        {
+            module.callbacks.extended_push();
+        }
     }
 }
 
@@ -96,11 +144,89 @@ void Encoder_SetCallbacks(const struct encoder_callbacks_t *callbacks_p)
     module.callbacks = *callbacks_p;
 }
 
+void Encoder_SetActivityCallback(encoder_activity_callback_t callback)
+{
+    module.activity_callback = callback;
+}
+
 struct encoder_callbacks_t Encoder_GetCallbacks(void)
 {
     return module.callbacks;
 }
 
+uint8_t Encoder_GetStepSize(void)
+{
+    return module.rotation.step_size;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
+
+/**
+ * Accelerate when the encoder is spun quickly in the same direction. The
+ * speed is averaged over all detents since the previous rotation, so a
+ * busy main loop doesn't affect it.
+ */
+static void UpdateStepSize(int8_t rotation)
+{
+    const bool right = rotation > 0;
+    const uint8_t nr_detents = right ? rotation : -rotation;
+    const uint32_t time_per_detent = Timer_TimeDifference(module.rotation.timer) / nr_detents;
+
+    if (right != module.rotation.right || time_per_detent >= ACCELERATION_MEDIUM_MS)
+    {
+        module.rotation.step_size = STEP_SIZE_DEFAULT;
+    }
+    else if (time_per_detent >= ACCELERATION_FAST_MS)
+    {
+        module.rotation.step_size = STEP_SIZE_MEDIUM;
+    }
+    else
+    {
+        module.rotation.step_size = STEP_SIZE_FAST;
+    }
+
+    module.rotation.timer = Timer_GetMilliseconds();
+    module.rotation.right = right;
+}
+
+/**
+ * Call the rotation callback once for each detent.
+ */
+static void Rotate(int8_t rotation)
+{
+    encoder_callback_t callback;
+    uint8_t nr_detents;
+
+    if (rotation > 0)
+    {
+        callback = module.callbacks.right;
+        nr_detents = (uint8_t)rotation;
+    }
+    else
+    {
+        callback = module.callbacks.left;
+        nr_detents = (uint8_t)(-(int16_t)rotation);
+    }
+
+    while (nr_detents > 0)
+    {
+        callback();
+        --nr_detents;
+    }
+}
+
+/**
+ * Notify the activity callback of an event, returns false if the event
+ * should be dropped.
+ */
+static bool RegisterActivity(void)
+{
+    if (module.activity_callback == NULL)
+    {
+        return true;
+    }
+
+    return module.activity_callback();
+}
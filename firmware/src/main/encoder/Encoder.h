@@ -1,7 +1,7 @@
 /**
  * @file   Encoder.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-09-17 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Module for handling rotary encoders.
  */
 
@@ -29,6 +29,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //INCLUDES
 //////////////////////////////////////////////////////////////////////////
 
+#include <stdint.h>
+#include <stdbool.h>
+
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
@@ -46,6 +49,8 @@ struct encoder_callbacks_t
     encoder_callback_t extended_push;
 };
 
+typedef bool (*encoder_activity_callback_t)(void);
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -58,7 +63,11 @@ void Encoder_Init(void);
 /**
  * Update the internal state of the encoder module.
  *
- * Calls any set callbacks if the rotary encoder has been active.
+ * Calls any set callbacks if the rotary encoder has been active. The
+ * rotation callback is called once for every detent rotated since the
+ * last update. Rotation is only handled when both the right and left
+ * callbacks are set, otherwise it's kept until they are. The activity
+ * callback is called before every handled event.
  */
 void Encoder_Update(void);
 
@@ -69,6 +78,17 @@ void Encoder_Update(void);
  */
 void Encoder_SetCallbacks(const struct encoder_callbacks_t *callbacks_p);
 
+/**
+ * Set a callback that is called before the callbacks for any signal.
+ *
+ * Unlike the signal callbacks it isn't replaced when a view takes over
+ * the encoder, which makes it the place to register user activity. If it
+ * returns false the event is dropped, e.g. when it only woke the display.
+ *
+ * @param callback Activity callback, NULL to disable.
+ */
+void Encoder_SetActivityCallback(encoder_activity_callback_t callback);
+
 /**
  * Get callbacks for the encoder signals.
  *
@@ -76,4 +96,13 @@ void Encoder_SetCallbacks(const struct encoder_callbacks_t *callbacks_p);
  */
 struct encoder_callbacks_t Encoder_GetCallbacks(void);
 
+/**
+ * Get the step size of the latest rotation. The step size grows when the
+ * encoder is spun quickly, rotation callbacks that adjust a value can use
+ * it to take larger steps.
+ *
+ * @return Step size, at least one.
+ */
+uint8_t Encoder_GetStepSize(void);
+
 #endif
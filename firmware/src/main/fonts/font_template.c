@@ -32,6 +32,30 @@
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+#if COMPRESSED_FONT
+/* Width and height in the high and low nibble of size. Signed baseline offset
+ * and horizontal bearing in the high and low nibble of position. */
+typedef struct
+{{
+    uint16_t data_offset;
+    uint8_t size;
+    uint8_t position;
+#if !MONO_FONT
+    uint8_t advance;
+#endif
+}} glyph_entry_t;
+#else
+typedef glyph_info_t glyph_entry_t;
+#endif
+
+/* Glyphs for the chars first to last are stored from index and onward. */
+typedef struct
+{{
+    uint8_t first;
+    uint8_t last;
+    uint8_t index;
+}} glyph_range_t;
+
 
 //////////////////////////////////////////////////////////////////////////
 //VARIABLES
@@ -42,11 +66,16 @@ static const uint8_t glyph_data[] PROGMEM =
 {glyph_data}
 }};
 
-static const glyph_info_t glyphs[] PROGMEM =
+static const glyph_entry_t glyphs[] PROGMEM =
 {{
 {glyph_info}
 }};
 
+static const glyph_range_t glyph_ranges[] PROGMEM =
+{{
+{glyph_ranges}
+}};
+
 static font_info_t font =
 {{
     .name = "{font_name}",
@@ -73,19 +102,41 @@ static font_info_t font =
 ///         does not exist.
 ///
 bool Font_GetGlyphInfo(char glyph_value, glyph_info_t *glyph)
- {{
-
-    size_t glyph_offset;
+{{
+    const uint8_t value = (uint8_t)glyph_value;
 
-    switch (glyph_value)
+    for (size_t i = 0; i < (sizeof(glyph_ranges) / sizeof(*glyph_ranges)); ++i)
     {{
-{glyph_offset}
-        default:
-            return false;
+        const uint8_t first = pgm_read_byte(&glyph_ranges[i].first);
+
+        if (value < first)
+        {{
+            break;
+        }}
+
+        if (value <= pgm_read_byte(&glyph_ranges[i].last))
+        {{
+            const size_t index = pgm_read_byte(&glyph_ranges[i].index) + (value - first);
+#if COMPRESSED_FONT
+            glyph_entry_t entry;
+            memcpy_P(&entry, &glyphs[index], sizeof(entry));
+
+            glyph->data = &glyph_data[entry.data_offset];
+            glyph->width = entry.size >> 4;
+            glyph->height = entry.size & 0x0F;
+            glyph->baseline_offset = (int8_t)entry.position >> 4;
+            glyph->horizontal_bearing = entry.position & 0x0F;
+#if !MONO_FONT
+            glyph->advance = entry.advance;
+#endif
+#else
+            memcpy_P(glyph, &glyphs[index], sizeof(*glyphs));
+#endif
+            return true;
+        }}
     }}
 
-    memcpy_P(glyph, &glyphs[glyph_offset], sizeof(*glyphs));
-    return true;
+    return false;
 }}
 
 ///
@@ -27,11 +27,24 @@
 //////////////////////////////////////////////////////////////////////////
 
 #define MONO_FONT {monospace_font}
+#define COMPRESSED_FONT {compressed_font}
+
+// Rows above and below the baseline covered by the tallest glyphs.
+#define FONT_ASCENT {font_ascent}
+#define FONT_DESCENT {font_descent}
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+/**
+ * Glyph bitmaps are stored column by column with one byte per eight rows,
+ * top row in the least significant bit. Same layout as the display VRAM.
+ *
+ * In the compressed format the columns are instead stored as one bit stream
+ * without padding between columns, the top row of the first column in the
+ * least significant bit of the first byte.
+ */
 typedef struct
 {{
     const uint8_t *data;
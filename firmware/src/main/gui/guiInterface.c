@@ -1,7 +1,7 @@
 /**
  * @file   guiInterface.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-05-26 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of guiInterface
  *
  * Detailed description of file.
@@ -64,12 +64,11 @@ void guiInterface_DrawViewIndicator(indicator_position_type position)
     switch (position)
     {
         case INDICATOR_POS_RIGHT:
-            libUI_DrawLine(DISPLAY_WIDTH - 1, 0, DISPLAY_WIDTH - 1,
-                           DISPLAY_HEIGHT - 1);
+            libUI_DrawVerticalLine(DISPLAY_WIDTH - 1, 0, DISPLAY_HEIGHT);
             break;
 
         case INDICATOR_POS_LEFT:
-            libUI_DrawLine(0, 0, 0, DISPLAY_HEIGHT - 1);
+            libUI_DrawVerticalLine(0, 0, DISPLAY_HEIGHT);
             break;
 
         default:
@@ -1,7 +1,7 @@
 /**
  * @file   guiNodes.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of GUI for remote nodes.
  */
 
@@ -30,14 +30,13 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include "common.h"
 
 #include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
 
 #include "libDebug.h"
 #include "libUI.h"
 
 #include "Interface.h"
 #include "Nodes.h"
+#include "Trend.h"
 
 #include "guiNodes.h"
 
@@ -51,6 +50,11 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define BATT_INDICATOR_Y                23
 #define BATT_INDICATOR_ANIMATION_DELAY  400
 
+#define SPARKLINE_X         2
+#define SPARKLINE_Y         2
+#define SPARKLINE_HEIGHT    28
+#define TREND_RANGE_X       (SPARKLINE_X + TREND_NR_SAMPLES + 6)
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -61,12 +65,21 @@ struct node_view_t
     struct view details;
     struct view temperature;
     struct view humidity;
+    struct view trend;
+    struct trend_t temperature_trend;
 };
 
 struct module_t
 {
     struct node_view_t views[MAX_NR_NODE_VIEWS];
     struct
+    {
+        struct ui_widget_t index;
+        struct ui_widget_t temperature;
+        struct ui_widget_t humidity;
+        struct ui_widget_t battery;
+    } widgets;
+    struct
     {
         uint8_t nr_bars;
         uint32_t timer;
@@ -79,6 +92,17 @@ struct module_t
 
 static struct module_t module;
 
+//Battery outline with the terminal on the right side, bars are filled in
+//when drawn.
+static const uint8_t battery_icon[] PROGMEM =
+{
+    10, 6,
+    0x3F, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x3F, 0x1E
+};
+
+static const char temperature_unit[] PROGMEM = " C";
+static const char humidity_unit[] PROGMEM = " %";
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -87,10 +111,12 @@ static void DrawNodeView(uint16_t context);
 static void DrawDetailedNodeView(uint16_t context);
 static void DrawTemperatureMaxMinView(uint16_t context);
 static void DrawHumidityMaxMinView(uint16_t context);
-static void DrawBattery(uint8_t nr_bars);
-static void DrawBatteryIndicator(const struct node_t *node_p);
+static void DrawTemperatureTrendView(uint16_t context);
+static int16_t GetBatteryBars(const struct node_t *node_p);
 static void ClearAction(uint16_t context __attribute__ ((unused)));
 static uint8_t ContextToNodeID(uint16_t context);
+static void PrintMeasurement(const char *label_p, int16_t value,
+                             const char *unit_p, uint8_t x_pos, uint8_t y_pos);
 
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
@@ -103,6 +129,7 @@ void guiNodes_Init(void)
         struct node_view_t *view_p = &module.views[i];
 
         Interface_InitView(&view_p->overview, DrawNodeView, i);
+        Interface_SetRefreshPeriod(&view_p->overview, BATT_INDICATOR_ANIMATION_DELAY);
         Interface_AddView(&view_p->overview);
 
         Interface_InitView(&view_p->temperature, DrawTemperatureMaxMinView, i);
@@ -113,10 +140,31 @@ void guiNodes_Init(void)
         Interface_AddAction(&view_p->humidity, ClearAction);
         Interface_AddChild(&view_p->overview, &view_p->humidity);
 
+        Interface_InitView(&view_p->trend, DrawTemperatureTrendView, i);
+        Interface_AddChild(&view_p->overview, &view_p->trend);
+
         Interface_InitView(&view_p->details, DrawDetailedNodeView, i);
         Interface_AddChild(&view_p->overview, &view_p->details);
+
+        //NOTE: The nodes must be added before the views are initialized.
+        struct node_t *node_p = Nodes_GetNodeFromID(ContextToNodeID(i));
+        sc_assert(node_p != NULL);
+
+        Trend_Init(&view_p->temperature_trend, TREND_TEMPERATURE_OFFSET,
+                   TREND_TEMPERATURE_DIVISOR, TREND_DEFAULT_PERIOD_S);
+        Sensor_SetTrend(Node_GetTemperatureSensor(node_p), &view_p->temperature_trend);
     }
 
+    //The overview widgets are shared by all node views, only one of them
+    //is shown at a time.
+    libUI_InitWidget(&module.widgets.index, UI_WIDGET_NUMBER, NULL, 1, 12);
+    libUI_InitWidget(&module.widgets.temperature, UI_WIDGET_FIXED_POINT,
+                     temperature_unit, 45, UI_DOUBLE_ROW_FIRST);
+    libUI_InitWidget(&module.widgets.humidity, UI_WIDGET_FIXED_POINT,
+                     humidity_unit, 45, UI_DOUBLE_ROW_SECOND);
+    libUI_InitWidget(&module.widgets.battery, UI_WIDGET_GAUGE, battery_icon,
+                     BATT_INDICATOR_X, BATT_INDICATOR_Y);
+
     module.battery_indicator.nr_bars = 0;
     module.battery_indicator.timer = 0;
 }
@@ -127,15 +175,13 @@ void guiNodes_Init(void)
 
 static void DrawNodeView(uint16_t context)
 {
-    /**
-     * Add three to node index(context) so the indexing continues after the
-     * two temperature sensors.
-     */
-    libUI_Print("%u", 1, 12, context + 3);
-
     struct node_t *node_p = Nodes_GetNodeFromID(ContextToNodeID(context));
     sc_assert(node_p != NULL);
 
+    int16_t temperature_scaled = UI_WIDGET_NO_VALUE;
+    int16_t humidity_scaled = UI_WIDGET_NO_VALUE;
+    int16_t nr_bars = UI_WIDGET_NO_VALUE;
+
     if (Node_IsActive(node_p))
     {
         const struct sensor_t *temperature_sensor_p = Node_GetTemperatureSensor(node_p);
@@ -144,46 +190,27 @@ static void DrawNodeView(uint16_t context)
         if (Sensor_IsValid(temperature_sensor_p) &&
                 Sensor_IsValid(humidity_sensor_p))
         {
-            int16_t temperature_scaled;
-            int16_t humidity_scaled;
-
             Sensor_GetValue(temperature_sensor_p, &temperature_scaled);
             Sensor_GetValue(humidity_sensor_p, &humidity_scaled);
-
-            struct div_t temperature;
-            struct div_t humidity;
-
-            temperature = Divide((int32_t)temperature_scaled, 10);
-            humidity = Divide((int32_t)humidity_scaled, 10);
-
-            libUI_Print(
-                "%ld.+%d C",
-                45,
-                UI_DOUBLE_ROW_FIRST,
-                temperature.quotient,
-                abs(temperature.remainder)
-            );
-            libUI_Print(
-                "%ld.+%d %%",
-                45,
-                UI_DOUBLE_ROW_SECOND,
-                humidity.quotient,
-                abs(humidity.remainder)
-            );
-        }
-        else
-        {
-            libUI_Print("--.-- C", 40, UI_DOUBLE_ROW_FIRST);
-            libUI_Print("--.-- %%", 40, UI_DOUBLE_ROW_SECOND);
         }
 
-        DrawBatteryIndicator(node_p);
-    }
-    else
-    {
-        libUI_Print("--.-- C", 40, UI_DOUBLE_ROW_FIRST);
-        libUI_Print("--.-- %%", 40, UI_DOUBLE_ROW_SECOND);
+        nr_bars = GetBatteryBars(node_p);
     }
+
+    /**
+     * Add three to node index(context) so the indexing continues after the
+     * two temperature sensors.
+     */
+    libUI_SetWidgetValue(&module.widgets.index, (int16_t)context + 3);
+    libUI_SetWidgetValue(&module.widgets.temperature, temperature_scaled);
+    libUI_SetWidgetValue(&module.widgets.humidity, humidity_scaled);
+    libUI_SetWidgetValue(&module.widgets.battery, nr_bars);
+
+    libUI_RetainFrame();
+    libUI_DrawWidget(&module.widgets.index);
+    libUI_DrawWidget(&module.widgets.temperature);
+    libUI_DrawWidget(&module.widgets.humidity);
+    libUI_DrawWidget(&module.widgets.battery);
 }
 
 static void DrawDetailedNodeView(uint16_t context)
@@ -195,8 +222,15 @@ static void DrawDetailedNodeView(uint16_t context)
         uint16_t voltage = Node_GetBatteryVoltage(node_p);
         int16_t rssi = Node_GetRSSI(node_p);
 
-        libUI_Print("Batt: %hu mV", 2, UI_DOUBLE_ROW_FIRST, voltage);
-        libUI_Print("RSSI: %i dBm", 2, UI_DOUBLE_ROW_SECOND, rssi);
+        uint8_t x_pos;
+
+        x_pos = libUI_Print("Batt: ", 2, UI_DOUBLE_ROW_FIRST);
+        x_pos = libUI_PrintUnsigned(voltage, 1, x_pos, UI_DOUBLE_ROW_FIRST);
+        libUI_Print(" mV", x_pos, UI_DOUBLE_ROW_FIRST);
+
+        x_pos = libUI_Print("RSSI: ", 2, UI_DOUBLE_ROW_SECOND);
+        x_pos = libUI_PrintSigned(rssi, x_pos, UI_DOUBLE_ROW_SECOND);
+        libUI_Print(" dBm", x_pos, UI_DOUBLE_ROW_SECOND);
     }
     else
     {
@@ -215,25 +249,14 @@ static void DrawTemperatureMaxMinView(uint16_t context)
     if (Sensor_IsStatisticsValid(temperature_sensor_p))
     {
         int16_t temperature_scaled;
-        struct div_t temperature;
 
         Sensor_GetMaxValue(temperature_sensor_p, &temperature_scaled);
-        temperature = Divide((int32_t)temperature_scaled, 10);
-        libUI_Print(
-            "Max: %ld.%d C",
-            2,
-            UI_DOUBLE_ROW_FIRST,
-            temperature.quotient,
-            abs(temperature.remainder));
+        PrintMeasurement(PSTR("Max: "), temperature_scaled, PSTR(" C"),
+                         2, UI_DOUBLE_ROW_FIRST);
 
         Sensor_GetMinValue(temperature_sensor_p, &temperature_scaled);
-        temperature = Divide((int32_t)temperature_scaled, 10);
-        libUI_Print(
-            "Min: %ld.%d C",
-            2,
-            UI_DOUBLE_ROW_SECOND,
-            temperature.quotient,
-            abs(temperature.remainder));
+        PrintMeasurement(PSTR("Min: "), temperature_scaled, PSTR(" C"),
+                         2, UI_DOUBLE_ROW_SECOND);
     }
     else
     {
@@ -252,50 +275,56 @@ static void DrawHumidityMaxMinView(uint16_t context)
     if (Sensor_IsStatisticsValid(humidity_sensor_p))
     {
         int16_t humidity_scaled;
-        struct div_t humidity;
 
         Sensor_GetMaxValue(humidity_sensor_p, &humidity_scaled);
-        humidity = Divide((int32_t)humidity_scaled, 10);
-        libUI_Print(
-            "Max: %ld.%d %%",
-            2, UI_DOUBLE_ROW_FIRST,
-            humidity.quotient,
-            abs(humidity.remainder));
+        PrintMeasurement(PSTR("Max: "), humidity_scaled, PSTR(" %"),
+                         2, UI_DOUBLE_ROW_FIRST);
 
         Sensor_GetMinValue(humidity_sensor_p, &humidity_scaled);
-        humidity = Divide((int32_t)humidity_scaled, 10);
-        libUI_Print(
-            "Min: %ld.%d %%",
-            2,
-            UI_DOUBLE_ROW_SECOND,
-            humidity.quotient,
-            abs(humidity.remainder));
+        PrintMeasurement(PSTR("Min: "), humidity_scaled, PSTR(" %"),
+                         2, UI_DOUBLE_ROW_SECOND);
     }
     else
     {
-        libUI_Print("Max: --.-- %%", 2, UI_DOUBLE_ROW_FIRST);
-        libUI_Print("Min: --.-- %%", 2, UI_DOUBLE_ROW_SECOND);
+        libUI_Print("Max: --.-- %", 2, UI_DOUBLE_ROW_FIRST);
+        libUI_Print("Min: --.-- %", 2, UI_DOUBLE_ROW_SECOND);
     }
 }
 
-static void DrawBattery(uint8_t nr_bars)
+static void DrawTemperatureTrendView(uint16_t context)
 {
-    libUI_DrawRectangle(BATT_INDICATOR_X, BATT_INDICATOR_Y, 8, 5);
-    libUI_DrawLine(BATT_INDICATOR_X + 9,
-                   BATT_INDICATOR_Y + 1,
-                   BATT_INDICATOR_X + 9,
-                   BATT_INDICATOR_Y + 4);
+    sc_assert(context < ElementsIn(module.views));
+
+    const struct trend_t *trend_p = &module.views[context].temperature_trend;
 
-    for (size_t i = 0; i < nr_bars; ++i)
+    int16_t max_scaled;
+    int16_t min_scaled;
+
+    if (Trend_GetRange(trend_p, &min_scaled, &max_scaled))
     {
-        libUI_DrawLine(BATT_INDICATOR_X + 2 + i,
-                       BATT_INDICATOR_Y + 2,
-                       BATT_INDICATOR_X + 2 + i,
-                       BATT_INDICATOR_Y + 3);
+        uint8_t first;
+        const uint8_t *samples_p = Trend_GetSamples(trend_p, &first);
+
+        libUI_DrawSparkline(samples_p, TREND_NR_SAMPLES, first,
+                            SPARKLINE_X, SPARKLINE_Y, SPARKLINE_HEIGHT);
+
+        uint8_t x_pos;
+        x_pos = libUI_PrintFixedPoint(max_scaled, TREND_RANGE_X, UI_DOUBLE_ROW_FIRST);
+        libUI_PrintText_P(temperature_unit, x_pos, UI_DOUBLE_ROW_FIRST);
+        x_pos = libUI_PrintFixedPoint(min_scaled, TREND_RANGE_X, UI_DOUBLE_ROW_SECOND);
+        libUI_PrintText_P(temperature_unit, x_pos, UI_DOUBLE_ROW_SECOND);
+    }
+    else
+    {
+        libUI_Print("Trend: --", 2, UI_SINGLE_ROW);
     }
 }
 
-static void DrawBatteryIndicator(const struct node_t *node_p)
+/**
+ * Number of bars in the battery gauge, animated while charging and hidden
+ * when the battery is ok.
+ */
+static int16_t GetBatteryBars(const struct node_t *node_p)
 {
     if (Node_IsBatteryCharging(node_p))
     {
@@ -305,16 +334,18 @@ static void DrawBatteryIndicator(const struct node_t *node_p)
             ++module.battery_indicator.nr_bars;
             module.battery_indicator.timer = Timer_GetMilliseconds();
         }
-        DrawBattery(module.battery_indicator.nr_bars % 6);
+        return module.battery_indicator.nr_bars % 6;
     }
     else if (Node_IsBatteryChargerConnected(node_p))
     {
-        DrawBattery(5);
+        return 5;
     }
     else if (!Node_IsBatteryOk(node_p))
     {
-        DrawBattery(0);
+        return 0;
     }
+
+    return UI_WIDGET_NO_VALUE;
 }
 
 static void ClearAction(uint16_t context __attribute__ ((unused)))
@@ -333,3 +364,14 @@ static uint8_t ContextToNodeID(uint16_t context)
 {
     return (uint8_t)context + 128;
 }
+
+/**
+ * Print label and unit around a measurement in tenths.
+ */
+static void PrintMeasurement(const char *label_p, int16_t value,
+                             const char *unit_p, uint8_t x_pos, uint8_t y_pos)
+{
+    x_pos = libUI_PrintText_P(label_p, x_pos, y_pos);
+    x_pos = libUI_PrintFixedPoint(value, x_pos, y_pos);
+    libUI_PrintText_P(unit_p, x_pos, y_pos);
+}
@@ -1,7 +1,7 @@
 /**
  * @file   guiRTC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of GUI for displaying the current time.
  */
 
@@ -40,6 +40,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 #define UTC_OFFSET_SEC 3600
+#define CLOCK_REFRESH_PERIOD_MS 1000
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -80,12 +81,16 @@ static struct module_t module;
 static void DrawClockView(uint16_t context __attribute__ ((unused)));
 static void DrawDetailedTimeView(uint16_t context __attribute__ ((unused)));
 static void DrawUnderLine(void);
+static void PrintDate(const struct time_t *time_p, uint8_t x_pos, uint8_t y_pos);
+static uint8_t PrintClock(const struct time_t *time_p, uint8_t x_pos, uint8_t y_pos);
+static void PrintClockWithSeconds(const struct time_t *time_p, uint8_t x_pos, uint8_t y_pos);
 static void DrawSetTimeView(uint16_t context __attribute__ ((unused)));
 static void ConvertTimeToLocal(struct time_t *time_p);
 static void ConvertTimeToUTC(struct time_t *time_p);
 static void SetTimeAction(uint16_t context __attribute__ ((unused)));
 static struct limits_t GetCurrentFieldLimits(size_t field_index, const struct time_t *time_p);
 static void AdjustTimeToLimits(const struct time_t *time_p);
+static void StepField(bool increase);
 static void IncreaseField(void);
 static void DecreaseField(void);
 
@@ -99,9 +104,11 @@ void guiRTC_Init(void)
     module.set_time.index = 0;
 
     Interface_InitView(&module.view.overview, DrawClockView, 0);
+    Interface_SetRefreshPeriod(&module.view.overview, CLOCK_REFRESH_PERIOD_MS);
     Interface_AddView(&module.view.overview);
 
     Interface_InitView(&module.view.details, DrawDetailedTimeView, 0);
+    Interface_SetRefreshPeriod(&module.view.details, CLOCK_REFRESH_PERIOD_MS);
     Interface_AddAction(&module.view.details, SetTimeAction);
     Interface_AddChild(&module.view.overview, &module.view.details);
 
@@ -119,7 +126,7 @@ static void DrawClockView(uint16_t context __attribute__ ((unused)))
 
     ConvertTimeToLocal(&time);
 
-    libUI_Print("%02u:%02u", 45, UI_SINGLE_ROW, time.hour, time.minute);
+    PrintClock(&time, 45, UI_SINGLE_ROW);
 }
 
 static void DrawDetailedTimeView(uint16_t context __attribute__ ((unused)))
@@ -129,8 +136,8 @@ static void DrawDetailedTimeView(uint16_t context __attribute__ ((unused)))
 
     ConvertTimeToLocal(&time);
 
-    libUI_Print("20%02u-%02u-%02u", 25, UI_DOUBLE_ROW_FIRST, time.year, time.month, time.date);
-    libUI_Print("%02u:%02u:%02u", 34, UI_DOUBLE_ROW_SECOND, time.hour, time.minute, time.second);
+    PrintDate(&time, 25, UI_DOUBLE_ROW_FIRST);
+    PrintClockWithSeconds(&time, 34, UI_DOUBLE_ROW_SECOND);
 }
 
 static void DrawUnderLine(void)
@@ -178,7 +185,31 @@ static void DrawUnderLine(void)
 
     const struct underline_t *line_p = &lines[module.set_time.index];
 
-    libUI_DrawLine(line_p->x, line_p->y, line_p->x + line_p->length, line_p->y);
+    libUI_DrawHorizontalLine(line_p->x, line_p->y, line_p->length + 1);
+}
+
+static void PrintDate(const struct time_t *time_p, uint8_t x_pos, uint8_t y_pos)
+{
+    x_pos = libUI_Print("20", x_pos, y_pos);
+    x_pos = libUI_PrintUnsigned(time_p->year, 2, x_pos, y_pos);
+    x_pos = libUI_Print("-", x_pos, y_pos);
+    x_pos = libUI_PrintUnsigned(time_p->month, 2, x_pos, y_pos);
+    x_pos = libUI_Print("-", x_pos, y_pos);
+    libUI_PrintUnsigned(time_p->date, 2, x_pos, y_pos);
+}
+
+static uint8_t PrintClock(const struct time_t *time_p, uint8_t x_pos, uint8_t y_pos)
+{
+    x_pos = libUI_PrintUnsigned(time_p->hour, 2, x_pos, y_pos);
+    x_pos = libUI_Print(":", x_pos, y_pos);
+    return libUI_PrintUnsigned(time_p->minute, 2, x_pos, y_pos);
+}
+
+static void PrintClockWithSeconds(const struct time_t *time_p, uint8_t x_pos, uint8_t y_pos)
+{
+    x_pos = PrintClock(time_p, x_pos, y_pos);
+    x_pos = libUI_Print(":", x_pos, y_pos);
+    libUI_PrintUnsigned(time_p->second, 2, x_pos, y_pos);
 }
 
 static void DrawSetTimeView(uint16_t context __attribute__ ((unused)))
@@ -186,8 +217,8 @@ static void DrawSetTimeView(uint16_t context __attribute__ ((unused)))
     struct time_t time;
     time = module.set_time.time;
 
-    libUI_Print("20%02u-%02u-%02u", 25, UI_DOUBLE_ROW_FIRST, time.year, time.month, time.date);
-    libUI_Print("%02u:%02u:%02u", 34, UI_DOUBLE_ROW_SECOND, time.hour, time.minute, time.second);
+    PrintDate(&time, 25, UI_DOUBLE_ROW_FIRST);
+    PrintClockWithSeconds(&time, 34, UI_DOUBLE_ROW_SECOND);
 
     DrawUnderLine();
 }
@@ -284,21 +315,31 @@ static void AdjustTimeToLimits(const struct time_t *time_p)
     }
 }
 
-static void IncreaseField(void)
+/**
+ * Step the current field, wrapping around within its limits. The step size
+ * follows the encoder acceleration so large changes can be made quickly.
+ */
+static void StepField(bool increase)
 {
     uint8_t *field_p = ((uint8_t *)&module.set_time.time) + module.set_time.index;
 
     struct limits_t limits;
     limits = GetCurrentFieldLimits(module.set_time.index, &module.set_time.time);
 
-    if (*field_p < limits.max)
-    {
-        *field_p += 1;
-    }
-    else
+    const uint8_t range = limits.max - limits.min + 1;
+    uint8_t step = Encoder_GetStepSize() % range;
+
+    if (!increase)
     {
-        *field_p = limits.min;
+        step = range - step;
     }
+
+    *field_p = limits.min + (*field_p - limits.min + step) % range;
+}
+
+static void IncreaseField(void)
+{
+    StepField(true);
     AdjustTimeToLimits(&module.set_time.time);
 
     /**
@@ -309,19 +350,7 @@ static void IncreaseField(void)
 
 static void DecreaseField(void)
 {
-    uint8_t *field_p = ((uint8_t *)&module.set_time.time) + module.set_time.index;
-
-    struct limits_t limits;
-    limits = GetCurrentFieldLimits(module.set_time.index, &module.set_time.time);
-
-    if (*field_p > limits.min)
-    {
-        *field_p -= 1;
-    }
-    else
-    {
-        *field_p = limits.max;
-    }
+    StepField(false);
     AdjustTimeToLimits(&module.set_time.time);
 
     /**
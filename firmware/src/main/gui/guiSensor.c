@@ -1,7 +1,7 @@
 /**
  * @file   guiSensor.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-19 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of guiSensor
  *
  * Detailed description of file.
@@ -31,11 +31,10 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //NOTE: Include common.h before all other headers
 #include "common.h"
 
-#include <stdlib.h>
-
 #include "libDebug.h"
 #include "libUI.h"
 #include "Sensor.h"
+#include "Trend.h"
 #include "Interface.h"
 #include "driverNTC.h"
 #include "guiSensor.h"
@@ -46,6 +45,11 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define NR_SENSOR_VIEWS 2
 
+#define SPARKLINE_X         2
+#define SPARKLINE_Y         2
+#define SPARKLINE_HEIGHT    28
+#define TREND_RANGE_X       (SPARKLINE_X + TREND_NR_SAMPLES + 6)
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -54,12 +58,19 @@ struct sensor_view_t
 {
     struct view overview;
     struct view details;
+    struct view trend_view;
     struct sensor_t *sensor_p;
+    struct trend_t trend;
 };
 
 struct module_t
 {
     struct sensor_view_t views[NR_SENSOR_VIEWS];
+    struct
+    {
+        struct ui_widget_t index;
+        struct ui_widget_t temperature;
+    } widgets;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -68,14 +79,19 @@ struct module_t
 
 static struct module_t module;
 
+static const char temperature_unit[] PROGMEM = " C";
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
 void DrawDetailsView(uint16_t context);
 void DrawOverviewView(uint16_t context);
+void DrawTrendView(uint16_t context);
 void ClearAction(uint16_t context);
 struct sensor_view_t *GetViewPointerFromContext(uint16_t context);
+static void PrintMeasurement(const char *label_p, int16_t value, uint8_t x_pos,
+                             uint8_t y_pos);
 
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
@@ -94,8 +110,19 @@ void guiSensor_Init(void)
         Interface_AddAction(&view_p->details, ClearAction);
         Interface_AddChild(&view_p->overview, &view_p->details);
 
+        Interface_InitView(&view_p->trend_view, DrawTrendView, i);
+        Interface_AddChild(&view_p->overview, &view_p->trend_view);
+
         view_p->sensor_p = driverNTC_GetSensor(i);
+
+        Trend_Init(&view_p->trend, TREND_TEMPERATURE_OFFSET,
+                   TREND_TEMPERATURE_DIVISOR, TREND_DEFAULT_PERIOD_S);
+        Sensor_SetTrend(view_p->sensor_p, &view_p->trend);
     }
+
+    libUI_InitWidget(&module.widgets.index, UI_WIDGET_NUMBER, NULL, 1, 12);
+    libUI_InitWidget(&module.widgets.temperature, UI_WIDGET_FIXED_POINT,
+                     temperature_unit, 45, UI_SINGLE_ROW);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -112,16 +139,8 @@ void DrawDetailsView(uint16_t context)
     if (Sensor_GetMaxValue(view_p->sensor_p, &max_scaled) &&
             Sensor_GetMinValue(view_p->sensor_p, &min_scaled))
     {
-        struct div_t max;
-        struct div_t min;
-
-        max = Divide((int32_t)max_scaled, 10);
-        min = Divide((int32_t)min_scaled, 10);
-
-        libUI_Print("Max: %ld.%d C", 2, UI_DOUBLE_ROW_FIRST,
-                    max.quotient, abs(max.remainder));
-        libUI_Print("Min: %ld.%d C", 2, UI_DOUBLE_ROW_SECOND,
-                    min.quotient, abs(min.remainder));
+        PrintMeasurement(PSTR("Max: "), max_scaled, 2, UI_DOUBLE_ROW_FIRST);
+        PrintMeasurement(PSTR("Min: "), min_scaled, 2, UI_DOUBLE_ROW_SECOND);
     }
     else
     {
@@ -136,22 +155,46 @@ void DrawOverviewView(uint16_t context)
      * Add one to index(context) since end users are more familiar with
      * indexing starting at 1.
      */
-    libUI_Print("%u", 1, 12, context + 1);
+    libUI_SetWidgetValue(&module.widgets.index, (int16_t)context + 1);
 
     const struct sensor_view_t *view_p = GetViewPointerFromContext(context);
     int16_t temperature_scaled;
 
-    if (Sensor_GetValue(view_p->sensor_p, &temperature_scaled))
+    if (!Sensor_GetValue(view_p->sensor_p, &temperature_scaled))
+    {
+        temperature_scaled = UI_WIDGET_NO_VALUE;
+    }
+    libUI_SetWidgetValue(&module.widgets.temperature, temperature_scaled);
+
+    libUI_RetainFrame();
+    libUI_DrawWidget(&module.widgets.index);
+    libUI_DrawWidget(&module.widgets.temperature);
+}
+
+void DrawTrendView(uint16_t context)
+{
+    const struct sensor_view_t *view_p = GetViewPointerFromContext(context);
+
+    int16_t max_scaled;
+    int16_t min_scaled;
+
+    if (Trend_GetRange(&view_p->trend, &min_scaled, &max_scaled))
     {
-        struct div_t temperature;
-        temperature = Divide((int32_t)temperature_scaled, 10);
+        uint8_t first;
+        const uint8_t *samples_p = Trend_GetSamples(&view_p->trend, &first);
 
-        libUI_Print("%ld.%d C", 45, UI_SINGLE_ROW,
-                    temperature.quotient, abs(temperature.remainder));
+        libUI_DrawSparkline(samples_p, TREND_NR_SAMPLES, first,
+                            SPARKLINE_X, SPARKLINE_Y, SPARKLINE_HEIGHT);
+
+        uint8_t x_pos;
+        x_pos = libUI_PrintFixedPoint(max_scaled, TREND_RANGE_X, UI_DOUBLE_ROW_FIRST);
+        libUI_PrintText_P(temperature_unit, x_pos, UI_DOUBLE_ROW_FIRST);
+        x_pos = libUI_PrintFixedPoint(min_scaled, TREND_RANGE_X, UI_DOUBLE_ROW_SECOND);
+        libUI_PrintText_P(temperature_unit, x_pos, UI_DOUBLE_ROW_SECOND);
     }
     else
     {
-        libUI_Print("-.- C", 45, UI_SINGLE_ROW);
+        libUI_Print("Trend: --", 2, UI_SINGLE_ROW);
     }
 }
 
@@ -169,3 +212,14 @@ struct sensor_view_t *GetViewPointerFromContext(uint16_t context)
 
     return &module.views[context];
 }
+
+/**
+ * Print label followed by a temperature in tenths of degrees.
+ */
+static void PrintMeasurement(const char *label_p, int16_t value, uint8_t x_pos,
+                             uint8_t y_pos)
+{
+    x_pos = libUI_PrintText_P(label_p, x_pos, y_pos);
+    x_pos = libUI_PrintFixedPoint(value, x_pos, y_pos);
+    libUI_Print(" C", x_pos, y_pos);
+}
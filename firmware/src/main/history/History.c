@@ -0,0 +1,375 @@
+/**
+ * @file   History.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Implementation of History module
+ *
+ * Each block holds consecutive samples from one source, an absolute first
+ * value followed by 4-bit deltas. Blocks are allocated in order from a ring
+ * so the oldest block is always replaced first. The whole block is written
+ * on every append and covered by a CRC, a block only partially written
+ * before a reset is ignored.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "common.h"
+#include "History.h"
+#include "CRC.h"
+#include "libDebug.h"
+#include "driverNVM.h"
+#include "RTC.h"
+#include "Timer.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define POLL_INTERVAL_MS 1000
+
+#define NO_BLOCK UINT8_MAX
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+struct module_t
+{
+    uint8_t next;
+    uint8_t sequence;
+    uint16_t period;
+    bool period_valid;
+    uint32_t timer;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+static struct module_t module;
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+static uint8_t FindNewestBlock(uint8_t source, struct history_block_t *block_p);
+static bool FindNextBlock(uint8_t source, uint8_t *age_p,
+                          struct history_block_t *block_p);
+static uint8_t GetAge(const struct history_block_t *block_p);
+static int16_t GetLastValue(const struct history_block_t *block_p);
+static int8_t GetDelta(const struct history_block_t *block_p, uint8_t index);
+static void SetDelta(struct history_block_t *block_p, uint8_t index, int8_t delta);
+static bool ReadBlock(uint8_t index, struct history_block_t *block_p);
+static void WriteBlock(uint8_t index, struct history_block_t *block_p);
+static bool IsCRCValid(const struct history_block_t *block_p);
+static void UpdateCRC(struct history_block_t *block_p);
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+void History_Init(void)
+{
+    _Static_assert(sizeof(struct history_block_t) == HISTORY_BLOCK_SIZE,
+                   "Invalid history block size!");
+    _Static_assert(HISTORY_NVM_ADDRESS + HISTORY_NVM_SIZE <= UINT8_MAX + 1,
+                   "History does not fit in NVM!");
+
+    bool found = false;
+
+    module.next = 0;
+    module.sequence = 0;
+    module.period_valid = false;
+    module.timer = Timer_GetMilliseconds();
+
+    // Blocks are allocated in ring order so the newest block is followed
+    // by the oldest. All valid blocks were allocated within the last
+    // `HISTORY_NR_BLOCKS` allocations and compare correctly as serial
+    // numbers.
+    for (uint8_t i = 0; i < HISTORY_NR_BLOCKS; ++i)
+    {
+        struct history_block_t block;
+
+        if (ReadBlock(i, &block) &&
+                (!found || (int8_t)(block.sequence - module.sequence) > 0))
+        {
+            found = true;
+            module.sequence = block.sequence;
+            module.next = (i + 1) % HISTORY_NR_BLOCKS;
+        }
+    }
+
+    INFO("History module initialized");
+}
+
+bool History_IsSampleDue(uint16_t *period_p)
+{
+    sc_assert(period_p != NULL);
+
+    if (Timer_TimeDifference(module.timer) < POLL_INTERVAL_MS)
+    {
+        return false;
+    }
+
+    module.timer = Timer_GetMilliseconds();
+
+    uint32_t timestamp;
+    if (!RTC_GetTimeStamp(&timestamp))
+    {
+        return false;
+    }
+
+    const uint16_t period = (uint16_t)(timestamp / HISTORY_PERIOD_S);
+
+    if (module.period_valid && period == module.period)
+    {
+        return false;
+    }
+
+    module.period = period;
+    module.period_valid = true;
+
+    *period_p = period;
+    return true;
+}
+
+void History_Append(uint8_t source, uint16_t period, int16_t value)
+{
+    struct history_block_t block;
+    const uint8_t index = FindNewestBlock(source, &block);
+
+    if (index != NO_BLOCK)
+    {
+        const uint16_t next_period = block.period + block.count;
+
+        // Already recorded, the period started before a reset.
+        if ((uint16_t)(next_period - 1) == period)
+        {
+            return;
+        }
+
+        const int32_t delta = (int32_t)value - GetLastValue(&block);
+
+        if (period == next_period && block.count < HISTORY_MAX_SAMPLES &&
+                delta >= HISTORY_DELTA_MIN && delta <= HISTORY_DELTA_MAX)
+        {
+            SetDelta(&block, block.count - 1, (int8_t)delta);
+            ++block.count;
+
+            WriteBlock(index, &block);
+            return;
+        }
+    }
+
+    memset(&block, 0, sizeof(block));
+    block.sequence = ++module.sequence;
+    block.source = source;
+    block.period = period;
+    block.first = value;
+    block.count = 1;
+
+    WriteBlock(module.next, &block);
+    module.next = (module.next + 1) % HISTORY_NR_BLOCKS;
+}
+
+void History_Begin(struct history_iterator_t *iterator_p, uint8_t source)
+{
+    sc_assert(iterator_p != NULL);
+
+    iterator_p->source = source;
+    iterator_p->age = UINT8_MAX;
+    iterator_p->index = 0;
+    iterator_p->block.count = 0;
+}
+
+bool History_Next(struct history_iterator_t *iterator_p,
+                  struct history_sample_t *sample_p)
+{
+    sc_assert(iterator_p != NULL);
+    sc_assert(sample_p != NULL);
+
+    if (iterator_p->index >= iterator_p->block.count)
+    {
+        if (!FindNextBlock(iterator_p->source, &iterator_p->age,
+                           &iterator_p->block))
+        {
+            return false;
+        }
+
+        iterator_p->index = 0;
+        iterator_p->value = iterator_p->block.first;
+    }
+    else
+    {
+        iterator_p->value += GetDelta(&iterator_p->block, iterator_p->index - 1);
+    }
+
+    sample_p->period = iterator_p->block.period + iterator_p->index;
+    sample_p->value = iterator_p->value;
+
+    ++iterator_p->index;
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Find the most recently allocated block of the supplied source.
+ *
+ * @return Index of the block, or NO_BLOCK if the source has no blocks.
+ */
+static uint8_t FindNewestBlock(uint8_t source, struct history_block_t *block_p)
+{
+    uint8_t newest_index = NO_BLOCK;
+    uint8_t newest_age = UINT8_MAX;
+
+    for (uint8_t i = 0; i < HISTORY_NR_BLOCKS; ++i)
+    {
+        struct history_block_t block;
+
+        if (ReadBlock(i, &block) && block.source == source &&
+                GetAge(&block) < newest_age)
+        {
+            newest_index = i;
+            newest_age = GetAge(&block);
+            *block_p = block;
+        }
+    }
+
+    return newest_index;
+}
+
+/**
+ * Find the oldest block of the supplied source that is newer than age.
+ *
+ * @return True if a block was found, age is updated with its age.
+ */
+static bool FindNextBlock(uint8_t source, uint8_t *age_p,
+                          struct history_block_t *block_p)
+{
+    bool found = false;
+    uint8_t next_age = 0;
+
+    for (uint8_t i = 0; i < HISTORY_NR_BLOCKS; ++i)
+    {
+        struct history_block_t block;
+
+        if (ReadBlock(i, &block) && block.source == source)
+        {
+            const uint8_t age = GetAge(&block);
+
+            if (age < *age_p && (!found || age > next_age))
+            {
+                found = true;
+                next_age = age;
+                *block_p = block;
+            }
+        }
+    }
+
+    *age_p = next_age;
+    return found;
+}
+
+/**
+ * Get the number of blocks allocated after the supplied block.
+ */
+static uint8_t GetAge(const struct history_block_t *block_p)
+{
+    return module.sequence - block_p->sequence;
+}
+
+static int16_t GetLastValue(const struct history_block_t *block_p)
+{
+    int16_t value = block_p->first;
+
+    for (uint8_t i = 0; i < block_p->count - 1; ++i)
+    {
+        value += GetDelta(block_p, i);
+    }
+
+    return value;
+}
+
+static int8_t GetDelta(const struct history_block_t *block_p, uint8_t index)
+{
+    const uint8_t data = block_p->deltas[index / 2];
+    const uint8_t nibble = (index % 2 == 0) ? (data & 0x0F) : (data >> 4);
+
+    return (int8_t)(nibble ^ 0x08) - 0x08;
+}
+
+static void SetDelta(struct history_block_t *block_p, uint8_t index, int8_t delta)
+{
+    uint8_t *data_p = &block_p->deltas[index / 2];
+    const uint8_t nibble = (uint8_t)delta & 0x0F;
+
+    if (index % 2 == 0)
+    {
+        *data_p = (*data_p & 0xF0) | nibble;
+    }
+    else
+    {
+        *data_p = (*data_p & 0x0F) | (nibble << 4);
+    }
+}
+
+/**
+ * Read a block from NVM.
+ *
+ * @return True if the block is valid, otherwise false.
+ */
+static bool ReadBlock(uint8_t index, struct history_block_t *block_p)
+{
+    const uint8_t address = HISTORY_NVM_ADDRESS + index * HISTORY_BLOCK_SIZE;
+
+    driverNVM_Read(address, block_p, sizeof(*block_p));
+
+    return block_p->count > 0 && block_p->count <= HISTORY_MAX_SAMPLES &&
+           IsCRCValid(block_p);
+}
+
+static void WriteBlock(uint8_t index, struct history_block_t *block_p)
+{
+    const uint8_t address = HISTORY_NVM_ADDRESS + index * HISTORY_BLOCK_SIZE;
+
+    UpdateCRC(block_p);
+    driverNVM_Write(address, block_p, sizeof(*block_p));
+}
+
+static bool IsCRCValid(const struct history_block_t *block_p)
+{
+    const size_t size = offsetof(__typeof__(*block_p), crc);
+
+    return CRC_16(block_p, size) == block_p->crc;
+}
+
+static void UpdateCRC(struct history_block_t *block_p)
+{
+    const size_t size = offsetof(__typeof__(*block_p), crc);
+
+    block_p->crc = CRC_16(block_p, size);
+}
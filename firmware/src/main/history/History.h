@@ -0,0 +1,141 @@
+/**
+ * @file   History.h
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Header of History module
+ *
+ * Persistent sensor history, stored as a circular log of delta encoded
+ * blocks in the part of NVM not used by the sensor statistics.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HISTORY_H_
+#define HISTORY_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+//NVM below this address is reserved for the sensor statistics.
+#define HISTORY_NVM_ADDRESS 64
+#define HISTORY_NVM_SIZE 192
+
+#define HISTORY_BLOCK_SIZE 16
+#define HISTORY_NR_BLOCKS (HISTORY_NVM_SIZE / HISTORY_BLOCK_SIZE)
+
+//Bytes left for deltas after the block header and CRC.
+#define HISTORY_PAYLOAD_SIZE (HISTORY_BLOCK_SIZE - 9)
+
+//Deltas are stored as signed 4-bit values, two in each byte.
+#define HISTORY_DELTA_MIN -8
+#define HISTORY_DELTA_MAX 7
+#define HISTORY_MAX_SAMPLES (1 + HISTORY_PAYLOAD_SIZE * 2)
+
+#define HISTORY_PERIOD_S 600U
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+struct __attribute__((packed)) history_block_t
+{
+    uint8_t sequence;
+    uint8_t source;
+    uint16_t period;
+    int16_t first;
+    uint8_t count;
+    uint8_t deltas[HISTORY_PAYLOAD_SIZE];
+    uint16_t crc;
+};
+
+struct history_sample_t
+{
+    uint16_t period;
+    int16_t value;
+};
+
+struct history_iterator_t
+{
+    struct history_block_t block;
+    uint8_t source;
+    uint8_t age;
+    uint8_t index;
+    int16_t value;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Initialize the history module, the valid blocks in NVM are scanned to
+ * find where the log continues.
+ */
+void History_Init(void);
+
+/**
+ * Check if a new sample period has started. The RTC is polled at most
+ * once per second.
+ *
+ * @param period_p Pointer to variable where the period will be stored,
+ *                 the RTC timestamp divided by `HISTORY_PERIOD_S`.
+ *
+ * @return True once for each new period, otherwise false.
+ */
+bool History_IsSampleDue(uint16_t *period_p);
+
+/**
+ * Append a sample to the history of the supplied source. The current block
+ * of the source is continued if the sample directly follows it and the
+ * delta fits, otherwise the oldest block in the log is replaced.
+ *
+ * @param source Source ID, the sensor ID.
+ * @param period Sample period.
+ * @param value  Sample value.
+ */
+void History_Append(uint8_t source, uint16_t period, int16_t value);
+
+/**
+ * Start iterating the history of the supplied source, oldest sample first.
+ * The iterator is invalidated by `History_Append()`.
+ *
+ * @param iterator_p Pointer to iterator struct.
+ * @param source     Source ID.
+ */
+void History_Begin(struct history_iterator_t *iterator_p, uint8_t source);
+
+/**
+ * Get the next sample.
+ *
+ * @param iterator_p Pointer to iterator struct.
+ * @param sample_p   Pointer to struct where the sample will be stored.
+ *
+ * @return True if a sample was stored, false when the history is exhausted.
+ */
+bool History_Next(struct history_iterator_t *iterator_p,
+                  struct history_sample_t *sample_p);
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file   Interface.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of Interface functions
  *
  * Detailed description of file.
@@ -44,26 +44,44 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
-#define REFRESH_RATE_MS 100
+#define ACTIVE_REFRESH_PERIOD_MS 100
+#define INDICATOR_TIMEOUT_MS 2000
+#define DIM_TIMEOUT_MS 30000
+#define SLEEP_TIMEOUT_MS 120000
+
+#define BRIGHTNESS_NORMAL 0x80
+#define BRIGHTNESS_DIMMED 0x08
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+enum power_state_t
+{
+    POWER_STATE_ACTIVE,
+    POWER_STATE_DIMMED,
+    POWER_STATE_SLEEP
+};
+
 //////////////////////////////////////////////////////////////////////////
 //VARIABLES
 //////////////////////////////////////////////////////////////////////////
 
 static bool refresh_flag;
+static bool indicator_visible;
 static uint32_t activity_timer;
+static enum power_state_t power_state;
 static struct view *root_view;
 static struct view *active_view;
+static struct view *drawn_view;
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
 static void DrawViewIndicator(void);
+static void UpdatePowerState(uint32_t idle_time);
+static uint16_t GetRefreshPeriod(void);
 
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
@@ -82,9 +100,12 @@ void Interface_Init(void)
     Display_Rotate(true);
 
     refresh_flag = true;
+    indicator_visible = false;
     activity_timer = 0;
+    power_state = POWER_STATE_ACTIVE;
     root_view = NULL;
     active_view = NULL;
+    drawn_view = NULL;
 
     INFO("Init done");
     return;
@@ -93,6 +114,13 @@ void Interface_Init(void)
 ///
 /// @brief Update interface if needed, call as fast as possible.
 ///
+/// The active view is only redrawn when it has been invalidated with
+/// Interface_Refresh() or when its refresh period has expired.
+///
+/// The display is dimmed after DIM_TIMEOUT_MS without encoder activity and
+/// put to sleep after SLEEP_TIMEOUT_MS. Nothing is drawn or flushed while the
+/// display is asleep.
+///
 /// @param  None
 /// @return None
 ///
@@ -102,10 +130,24 @@ void Interface_Update(void)
 
     if (refresh_flag == true)
     {
-        if (active_view != NULL && active_view->draw_function != NULL)
+        const uint32_t idle_time = Timer_TimeDifference(activity_timer);
+        UpdatePowerState(idle_time);
+
+        if (power_state != POWER_STATE_SLEEP &&
+            active_view != NULL && active_view->draw_function != NULL)
         {
+            //Views retaining their frame only redraw changed widgets, start
+            //from an empty frame when the view changes or the view indicator
+            //has to be erased.
+            if (active_view != drawn_view || indicator_visible == true)
+            {
+                libUI_Clear();
+                drawn_view = active_view;
+            }
+
             active_view->draw_function(active_view->context);
-            if (Timer_TimeDifference(activity_timer) < 2000)
+            indicator_visible = (idle_time < INDICATOR_TIMEOUT_MS);
+            if (indicator_visible == true)
             {
                 DrawViewIndicator();
             }
@@ -115,7 +157,8 @@ void Interface_Update(void)
         auto_timer = Timer_GetMilliseconds();
     }
 
-    if (Timer_TimeDifference(auto_timer) > REFRESH_RATE_MS)
+    if (power_state != POWER_STATE_SLEEP &&
+        Timer_TimeDifference(auto_timer) > GetRefreshPeriod())
     {
         refresh_flag = true;
     }
@@ -163,6 +206,7 @@ void Interface_InitView(struct view *view,
     view->draw_function = draw_function;
     view->action_function = NULL;
     view->context = context;
+    view->refresh_period = INTERFACE_DEFAULT_REFRESH_PERIOD_MS;
     view->child = NULL;
     view->prev = NULL;
     view->next = NULL;
@@ -284,6 +328,19 @@ void Interface_AddAction(struct view *view, interface_fp action_function)
     return;
 }
 
+///
+/// @brief Set the longest time a view is shown without being redrawn.
+///
+/// @param  *view Pointer to view
+/// @param  period_ms Refresh period in milliseconds
+/// @return None
+///
+void Interface_SetRefreshPeriod(struct view *view, uint16_t period_ms)
+{
+    view->refresh_period = period_ms;
+    return;
+}
+
 ///
 /// @brief Get the root view.
 ///
@@ -307,7 +364,7 @@ struct view *Interface_GetActiveView(void)
 }
 
 ///
-/// @brief Sets the refresh flag to true. The interface will be refreshed
+/// @brief Invalidate the active view. The interface will be refreshed
 ///        next time Interface_Update() is called.
 ///
 /// @param  None
@@ -334,9 +391,7 @@ void Interface_PreviousView(void)
         {
             active_view = active_view->prev;
         }
-
         refresh_flag = true;
-        activity_timer = Timer_GetMilliseconds();
     }
     return;
 }
@@ -356,9 +411,7 @@ void Interface_NextView(void)
         {
             active_view = active_view->next;
         }
-
         refresh_flag = true;
-        activity_timer = Timer_GetMilliseconds();
     }
     return;
 }
@@ -382,9 +435,7 @@ void Interface_ActivateView(void)
         {
             active_view = active_view->parent;
         }
-
         refresh_flag = true;
-        activity_timer = Timer_GetMilliseconds();
     }
     return;
 }
@@ -405,6 +456,35 @@ void Interface_Action(void)
     return;
 }
 
+///
+/// @brief Register user activity, restores the brightness and wakes the
+///        display if needed. Meant to be used as the encoder activity
+///        callback so that every event counts, including those handled
+///        by views that take over the encoder.
+///
+/// @param  None
+/// @return False if the event only woke the display and should be dropped.
+///
+bool Interface_RegisterActivity(void)
+{
+    const bool was_sleeping = (power_state == POWER_STATE_SLEEP);
+
+    if (power_state != POWER_STATE_ACTIVE)
+    {
+        if (was_sleeping == true)
+        {
+            Display_On();
+        }
+        Display_SetBrightness(BRIGHTNESS_NORMAL);
+        power_state = POWER_STATE_ACTIVE;
+    }
+
+    refresh_flag = true;
+    activity_timer = Timer_GetMilliseconds();
+
+    return !was_sleeping;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -422,3 +502,36 @@ static void DrawViewIndicator(void)
     }
     return;
 }
+
+static void UpdatePowerState(uint32_t idle_time)
+{
+    if (idle_time > SLEEP_TIMEOUT_MS)
+    {
+        if (power_state != POWER_STATE_SLEEP)
+        {
+            INFO("Display sleep");
+            Display_Off();
+            power_state = POWER_STATE_SLEEP;
+        }
+    }
+    else if (idle_time > DIM_TIMEOUT_MS)
+    {
+        if (power_state == POWER_STATE_ACTIVE)
+        {
+            Display_SetBrightness(BRIGHTNESS_DIMMED);
+            power_state = POWER_STATE_DIMMED;
+        }
+    }
+    return;
+}
+
+static uint16_t GetRefreshPeriod(void)
+{
+    //Keep refreshing while the view indicator is shown so that it is
+    //removed when it times out.
+    if (active_view == NULL || indicator_visible == true)
+    {
+        return ACTIVE_REFRESH_PERIOD_MS;
+    }
+    return active_view->refresh_period;
+}
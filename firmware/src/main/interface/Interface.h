@@ -1,7 +1,7 @@
 /**
  * @file   Interface.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header of Interface
  *
  * Detailed description of file.
@@ -32,6 +32,13 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 #include <stdint.h>
+#include <stdbool.h>
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define INTERFACE_DEFAULT_REFRESH_PERIOD_MS 1000
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -44,6 +51,7 @@ struct view
     interface_fp draw_function;
     interface_fp action_function;
     uint16_t context;
+    uint16_t refresh_period;
     struct view *parent;
     struct view *child;
     struct view *next;
@@ -63,12 +71,14 @@ void Interface_InitView(struct view *view,
 void Interface_AddView(struct view *new_view);
 void Interface_AddChild(struct view *parent_view, struct view *child_view);
 void Interface_AddAction(struct view *view, interface_fp action_function);
+void Interface_SetRefreshPeriod(struct view *view, uint16_t period_ms);
 void Interface_AddSibling(struct view *sibling_view, struct view *new_view);
 void Interface_RemoveView(const struct view *view);
 void Interface_NextView(void);
 void Interface_PreviousView(void);
 void Interface_ActivateView(void);
 void Interface_Action(void);
+bool Interface_RegisterActivity(void);
 struct view *Interface_GetRootView(void);
 struct view *Interface_GetActiveView(void);
 
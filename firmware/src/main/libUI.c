@@ -1,11 +1,12 @@
 /**
  * @file   libUI.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of UI library.
  *
  * The UI library contains functions for drawing simple shapes and for
- * printing text.
+ * printing text, and retained widgets that are only rendered again when
+ * their value changes.
  */
 
 /*
@@ -32,8 +33,6 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include "common.h"
 #include <avr/pgmspace.h>
 #include <stdlib.h>
-#include <stdarg.h>
-#include <stdio.h>
 #include "Display.h"
 #include "libUI.h"
 #include "font.h"
@@ -42,32 +41,158 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
-#define PRINT_BUFFER_SIZE 24
+#define DECIMAL_BASE 10
+#define HEXADECIMAL_BASE 16
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+struct module_t
+{
+    bool retain_requested;
+    bool frame_retained;
+};
+
 //////////////////////////////////////////////////////////////////////////
 //VARIABLES
 //////////////////////////////////////////////////////////////////////////
 
+static struct module_t module;
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
-static inline bool IsPixelBitSet(uint8_t data, uint8_t bit);
 static inline void PrintChar(const glyph_info_t *char_ptr, uint8_t x_pos,
                              uint8_t y_pos);
+static uint8_t PrintCharacter(char character, uint8_t x_pos, uint8_t y_pos);
+static uint8_t PrintNumber(uint32_t value, uint8_t base, uint8_t min_digits,
+                           uint8_t x_pos, uint8_t y_pos);
+#if COMPRESSED_FONT
+static void DrawPackedGlyph(const glyph_info_t *glyph, uint8_t x, int8_t y);
+#endif
+static uint8_t RenderWidget(const struct ui_widget_t *widget_p);
+static void ClearWidget(const struct ui_widget_t *widget_p);
 
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
 
+///
+/// @brief Flush the frame to the display. VRAM is cleared for the next frame
+///        unless libUI_RetainFrame() was called while drawing it.
+///
+/// @param  None
+/// @return None
+///
 void libUI_Update(void)
 {
     Display_Flush();
+
+    if (module.retain_requested == false)
+    {
+        Display_ClearVRAM();
+    }
+
+    module.frame_retained = module.retain_requested;
+    module.retain_requested = false;
+}
+
+///
+/// @brief Clear VRAM, all widgets are rendered in full when drawn next.
+///
+/// @param  None
+/// @return None
+///
+void libUI_Clear(void)
+{
     Display_ClearVRAM();
+    module.frame_retained = false;
+}
+
+///
+/// @brief Keep the current frame in VRAM after the next libUI_Update() so
+///        that widgets can be redrawn incrementally.
+///
+/// @param  None
+/// @return None
+///
+void libUI_RetainFrame(void)
+{
+    module.retain_requested = true;
+}
+
+///
+/// @brief Initialize a retained widget
+///
+/// @param  widget_p Widget to initialize
+/// @param  type Widget type
+/// @param  data_p Label, unit or icon in FLASH depending on type, the unit
+///                can be NULL
+/// @param  x_pos Left column
+/// @param  y_pos Baseline for text widgets, top row for gauges and icons
+/// @return None
+///
+void libUI_InitWidget(struct ui_widget_t *widget_p, enum ui_widget_type_t type,
+                      const void *data_p, uint8_t x_pos, uint8_t y_pos)
+{
+    sc_assert(widget_p != NULL);
+    sc_assert(type <= UI_WIDGET_ICON);
+    sc_assert(data_p != NULL || type == UI_WIDGET_NUMBER ||
+              type == UI_WIDGET_FIXED_POINT);
+
+    widget_p->data_p = data_p;
+    widget_p->value = UI_WIDGET_NO_VALUE;
+    widget_p->type = (uint8_t)type;
+    widget_p->x_pos = x_pos;
+    widget_p->y_pos = y_pos;
+    widget_p->width = 0;
+    widget_p->dirty = true;
+}
+
+///
+/// @brief Set the value shown by a widget, the widget is marked for redraw
+///        if the value changed.
+///
+/// @param  widget_p Widget
+/// @param  value New value, UI_WIDGET_NO_VALUE if there is none
+/// @return None
+///
+void libUI_SetWidgetValue(struct ui_widget_t *widget_p, int16_t value)
+{
+    sc_assert(widget_p != NULL);
+
+    if (widget_p->value != value)
+    {
+        widget_p->value = value;
+        widget_p->dirty = true;
+    }
+}
+
+///
+/// @brief Draw a widget. Nothing is done if the widget is unchanged and
+///        still present in the retained frame.
+///
+/// @param  widget_p Widget to draw
+/// @return None
+///
+void libUI_DrawWidget(struct ui_widget_t *widget_p)
+{
+    sc_assert(widget_p != NULL);
+
+    if (module.frame_retained == true)
+    {
+        if (widget_p->dirty == false)
+        {
+            return;
+        }
+
+        ClearWidget(widget_p);
+    }
+
+    widget_p->width = RenderWidget(widget_p) - widget_p->x_pos;
+    widget_p->dirty = false;
 }
 
 void libUI_DrawLine(uint8_t x_start, uint8_t y_start, uint8_t x_end,
@@ -80,6 +205,19 @@ void libUI_DrawLine(uint8_t x_start, uint8_t y_start, uint8_t x_end,
     int err = (dx > dy ? dx : -dy) / 2;
     int e2;
 
+    //Axis aligned lines are written a whole VRAM byte at a time.
+    if (dy == 0 && dx < UINT8_MAX)
+    {
+        libUI_DrawHorizontalLine(x_start < x_end ? x_start : x_end, y_start, dx + 1);
+        return;
+    }
+
+    if (dx == 0 && dy < UINT8_MAX)
+    {
+        libUI_DrawVerticalLine(x_start, y_start < y_end ? y_start : y_end, dy + 1);
+        return;
+    }
+
     while (1)
     {
         Display_SetPixel(x_start, y_start);
@@ -103,13 +241,60 @@ void libUI_DrawLine(uint8_t x_start, uint8_t y_start, uint8_t x_end,
     }
 }
 
+void libUI_DrawHorizontalLine(uint8_t x_pos, uint8_t y_pos, uint8_t length)
+{
+    Display_FillRectangle(x_pos, y_pos, length, 1);
+}
+
+void libUI_DrawVerticalLine(uint8_t x_pos, uint8_t y_pos, uint8_t length)
+{
+    Display_FillRectangle(x_pos, y_pos, 1, length);
+}
+
+///
+/// @brief Draw the outline of a rectangle
+///
+/// The outline is drawn on both x_start and x_start + width, i.e. the
+/// rectangle covers width + 1 columns and height + 1 rows.
+///
 void libUI_DrawRectangle(uint8_t x_start, uint8_t y_start, uint8_t width,
                          uint8_t height)
 {
-    libUI_DrawLine(x_start, y_start, x_start + width, y_start);
-    libUI_DrawLine(x_start, y_start, x_start, y_start + height);
-    libUI_DrawLine(x_start, y_start + height, x_start + width, y_start + height);
-    libUI_DrawLine(x_start + width, y_start, x_start + width, y_start + height);
+    libUI_DrawHorizontalLine(x_start, y_start, width + 1);
+    libUI_DrawHorizontalLine(x_start, y_start + height, width + 1);
+    libUI_DrawVerticalLine(x_start, y_start, height + 1);
+    libUI_DrawVerticalLine(x_start + width, y_start, height + 1);
+}
+
+void libUI_FillRectangle(uint8_t x_pos, uint8_t y_pos, uint8_t width,
+                         uint8_t height)
+{
+    Display_FillRectangle(x_pos, y_pos, width, height);
+}
+
+void libUI_InvertRectangle(uint8_t x_pos, uint8_t y_pos, uint8_t width,
+                           uint8_t height)
+{
+    Display_InvertRectangle(x_pos, y_pos, width, height);
+}
+
+///
+/// @brief Draw an icon from FLASH to the display
+///
+/// @param  icon_p Icon in FLASH, see UI_ICON_*_INDEX for the layout
+/// @param  x_pos Left column of the icon
+/// @param  y_pos Top row of the icon
+/// @return None
+///
+void libUI_DrawIcon_P(const uint8_t *icon_p, uint8_t x_pos, uint8_t y_pos)
+{
+    sc_assert(icon_p != NULL);
+    sc_assert(y_pos <= INT8_MAX);
+
+    Display_DrawBitmap_P(x_pos, (int8_t)y_pos,
+                         &icon_p[UI_ICON_DATA_INDEX],
+                         pgm_read_byte(&icon_p[UI_ICON_WIDTH_INDEX]),
+                         pgm_read_byte(&icon_p[UI_ICON_HEIGHT_INDEX]));
 }
 
 void libUI_DrawCircle(uint8_t x_pos, uint8_t y_pos, uint8_t radius)
@@ -142,55 +327,318 @@ void libUI_DrawCircle(uint8_t x_pos, uint8_t y_pos, uint8_t radius)
 }
 
 ///
-/// @brief Print string from FLASH to the display
+/// @brief Draw a sparkline of the samples in a ring
 ///
-/// @param  text Text to print
-/// @param  x_pos Vertical position in pixels
-/// @param  y_pos Horizontal position in pixels
-/// @param  variable number of arguments
+/// Each sample is one column, scaled so that the lowest and highest sample
+/// span the full height. A column is filled from the row of the previous
+/// sample to its own row, which keeps the line connected at the cost of at
+/// most one VRAM byte write per page and column.
+///
+/// @param  samples_p Ring of samples, UI_SPARKLINE_GAP leaves a column empty
+/// @param  nr_samples Number of samples in the ring
+/// @param  first Index of the oldest sample, drawn in the leftmost column
+/// @param  x_pos Left column of the sparkline
+/// @param  y_pos Top row of the sparkline
+/// @param  height Number of rows used by the sparkline
 /// @return None
 ///
-void libUI_Print_P(const char *text, uint8_t x_pos, uint8_t y_pos, ...)
+void libUI_DrawSparkline(const uint8_t *samples_p, uint8_t nr_samples, uint8_t first,
+                         uint8_t x_pos, uint8_t y_pos, uint8_t height)
 {
-    va_list args;
-    char buffer[PRINT_BUFFER_SIZE];
+    sc_assert(samples_p != NULL);
+    sc_assert(first < nr_samples || nr_samples == 0);
+    sc_assert(height > 0);
+
+    uint8_t min = UI_SPARKLINE_GAP;
+    uint8_t max = 0;
+
+    for (uint8_t i = 0; i < nr_samples; ++i)
+    {
+        const uint8_t sample = samples_p[i];
+
+        if (sample != UI_SPARKLINE_GAP)
+        {
+            min = sample < min ? sample : min;
+            max = sample > max ? sample : max;
+        }
+    }
+
+    if (min == UI_SPARKLINE_GAP)
+    {
+        return;
+    }
+
+    const uint8_t range = max - min;
+    const uint8_t bottom_row = y_pos + height - 1;
+    uint8_t previous_row = 0;
+    bool connected = false;
+    uint8_t index = first;
+
+    for (uint8_t column = 0; column < nr_samples; ++column)
+    {
+        const uint8_t sample = samples_p[index];
+        index = (index + 1 == nr_samples) ? 0 : index + 1;
+
+        if (sample == UI_SPARKLINE_GAP)
+        {
+            connected = false;
+            continue;
+        }
+
+        uint8_t row = y_pos + (height - 1) / 2;
+
+        if (range > 0)
+        {
+            const uint16_t scaled = (uint16_t)(sample - min) * (height - 1);
+            row = bottom_row - (uint8_t)((scaled + range / 2) / range);
+        }
+
+        uint8_t top_row = row;
+        uint8_t end_row = row;
+
+        if (connected)
+        {
+            top_row = previous_row < row ? previous_row : row;
+            end_row = previous_row > row ? previous_row : row;
+        }
+
+        Display_FillRectangle(x_pos + column, top_row, 1, end_row - top_row + 1);
 
-    va_start(args, y_pos);
+        previous_row = row;
+        connected = true;
+    }
+}
 
-    vsnprintf_P(buffer, sizeof(buffer), text, args);
+///
+/// @brief Print string from FLASH to the display
+///
+/// @param  text Text to print
+/// @param  x_pos Horizontal position in pixels
+/// @param  y_pos Vertical position of the baseline in pixels
+/// @return Horizontal position after the printed text
+///
+uint8_t libUI_PrintText_P(const char *text, uint8_t x_pos, uint8_t y_pos)
+{
+    sc_assert(text != NULL);
 
-    //Make sure that the buffer is null terminated.
-    buffer[sizeof(buffer) - 1] = '\0';
+    char character;
 
-    libUI_PrintText(buffer, x_pos, y_pos);
-    va_end(args);
+    while ((character = (char)pgm_read_byte(text++)) != '\0')
+    {
+        x_pos = PrintCharacter(character, x_pos, y_pos);
+    }
+
+    return x_pos;
 }
 
-void libUI_PrintText(const char *buffer, uint8_t x_pos, uint8_t y_pos)
+uint8_t libUI_PrintText(const char *buffer, uint8_t x_pos, uint8_t y_pos)
 {
     sc_assert(buffer != NULL);
     const char *char_ptr = buffer;
 
     while(*char_ptr != '\0')
     {
-        glyph_info_t glyph;
-        if (Font_GetGlyphInfo(*char_ptr, &glyph))
-        {
-            PrintChar(&glyph, x_pos, y_pos);
-            x_pos += Font_GetAdvance(&glyph);
-        }
-
+        x_pos = PrintCharacter(*char_ptr, x_pos, y_pos);
         ++char_ptr;
     }
+
+    return x_pos;
+}
+
+///
+/// @brief Print an unsigned decimal number
+///
+/// @param  value Number to print
+/// @param  min_digits Minimum number of digits, zero padded. E.g. 2 for time fields.
+/// @param  x_pos Horizontal position in pixels
+/// @param  y_pos Vertical position of the baseline in pixels
+/// @return Horizontal position after the printed number
+///
+uint8_t libUI_PrintUnsigned(uint32_t value, uint8_t min_digits, uint8_t x_pos,
+                            uint8_t y_pos)
+{
+    return PrintNumber(value, DECIMAL_BASE, min_digits, x_pos, y_pos);
+}
+
+uint8_t libUI_PrintSigned(int32_t value, uint8_t x_pos, uint8_t y_pos)
+{
+    uint32_t magnitude = (uint32_t)value;
+
+    if (value < 0)
+    {
+        x_pos = PrintCharacter('-', x_pos, y_pos);
+        magnitude = -magnitude;
+    }
+
+    return PrintNumber(magnitude, DECIMAL_BASE, 1, x_pos, y_pos);
+}
+
+uint8_t libUI_PrintHex(uint32_t value, uint8_t min_digits, uint8_t x_pos,
+                       uint8_t y_pos)
+{
+    return PrintNumber(value, HEXADECIMAL_BASE, min_digits, x_pos, y_pos);
+}
+
+///
+/// @brief Print a fixed-point number with one decimal
+///
+/// @param  value Number to print in tenths, e.g. -15 is printed as -1.5
+/// @param  x_pos Horizontal position in pixels
+/// @param  y_pos Vertical position of the baseline in pixels
+/// @return Horizontal position after the printed number
+///
+uint8_t libUI_PrintFixedPoint(int32_t value, uint8_t x_pos, uint8_t y_pos)
+{
+    uint32_t magnitude = (uint32_t)value;
+
+    if (value < 0)
+    {
+        x_pos = PrintCharacter('-', x_pos, y_pos);
+        magnitude = -magnitude;
+    }
+
+    x_pos = PrintNumber(magnitude / 10, DECIMAL_BASE, 1, x_pos, y_pos);
+    x_pos = PrintCharacter('.', x_pos, y_pos);
+    return PrintCharacter('0' + (char)(magnitude % 10), x_pos, y_pos);
 }
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
 
-static inline bool IsPixelBitSet(uint8_t data, uint8_t bit)
+static uint8_t PrintCharacter(char character, uint8_t x_pos, uint8_t y_pos)
+{
+    glyph_info_t glyph;
+
+    if (Font_GetGlyphInfo(character, &glyph))
+    {
+        PrintChar(&glyph, x_pos, y_pos);
+        x_pos += Font_GetAdvance(&glyph);
+    }
+
+    return x_pos;
+}
+
+/**
+ * Print the digits most significant first without a digit buffer, the
+ * divisor is scaled up to the leading digit and then divided down.
+ */
+static uint8_t PrintNumber(uint32_t value, uint8_t base, uint8_t min_digits,
+                           uint8_t x_pos, uint8_t y_pos)
+{
+    sc_assert(min_digits <= UI_MAX_MIN_DIGITS);
+
+    uint32_t divisor = 1;
+    uint8_t nr_digits = 1;
+
+    while (nr_digits < min_digits || value / divisor >= base)
+    {
+        divisor *= base;
+        ++nr_digits;
+    }
+
+    do
+    {
+        const uint8_t digit = (uint8_t)(value / divisor);
+        value -= digit * divisor;
+        divisor /= base;
+
+        x_pos = PrintCharacter(digit < 10 ? '0' + digit : 'A' + digit - 10,
+                               x_pos, y_pos);
+    }
+    while (divisor != 0);
+
+    return x_pos;
+}
+
+/**
+ * Render the widget and return the column following it.
+ */
+static uint8_t RenderWidget(const struct ui_widget_t *widget_p)
 {
-    return data & (1 << (7 - bit));
+    const int16_t value = widget_p->value;
+    const uint8_t y_pos = widget_p->y_pos;
+    uint8_t x_pos = widget_p->x_pos;
+
+    switch (widget_p->type)
+    {
+        case UI_WIDGET_LABEL:
+            x_pos = libUI_PrintText_P(widget_p->data_p, x_pos, y_pos);
+            break;
+
+        case UI_WIDGET_NUMBER:
+        case UI_WIDGET_FIXED_POINT:
+            if (value == UI_WIDGET_NO_VALUE)
+            {
+                x_pos = (widget_p->type == UI_WIDGET_FIXED_POINT) ?
+                        libUI_Print("-.-", x_pos, y_pos) :
+                        libUI_Print("--", x_pos, y_pos);
+            }
+            else if (widget_p->type == UI_WIDGET_FIXED_POINT)
+            {
+                x_pos = libUI_PrintFixedPoint(value, x_pos, y_pos);
+            }
+            else
+            {
+                x_pos = libUI_PrintSigned(value, x_pos, y_pos);
+            }
+
+            if (widget_p->data_p != NULL)
+            {
+                x_pos = libUI_PrintText_P(widget_p->data_p, x_pos, y_pos);
+            }
+            break;
+
+        case UI_WIDGET_GAUGE:
+        case UI_WIDGET_ICON:
+            if (value != UI_WIDGET_NO_VALUE &&
+                (value != 0 || widget_p->type == UI_WIDGET_GAUGE))
+            {
+                const uint8_t *icon_p = widget_p->data_p;
+                const uint8_t width = pgm_read_byte(&icon_p[UI_ICON_WIDTH_INDEX]);
+
+                libUI_DrawIcon_P(icon_p, x_pos, y_pos);
+
+                //The gauge is filled inside the outline, one column per unit.
+                if (widget_p->type == UI_WIDGET_GAUGE && value > 0 && width > 4)
+                {
+                    const uint8_t height = pgm_read_byte(&icon_p[UI_ICON_HEIGHT_INDEX]);
+                    const uint8_t fill = (value < width - 4) ? (uint8_t)value : width - 4;
+
+                    libUI_FillRectangle(x_pos + 2, y_pos + 2, fill, height - 4);
+                }
+
+                x_pos += width;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return x_pos;
+}
+
+/**
+ * Erase the region covered by the last render of the widget.
+ */
+static void ClearWidget(const struct ui_widget_t *widget_p)
+{
+    if (widget_p->type == UI_WIDGET_GAUGE || widget_p->type == UI_WIDGET_ICON)
+    {
+        const uint8_t *icon_p = widget_p->data_p;
+
+        Display_ClearRectangle(widget_p->x_pos, widget_p->y_pos, widget_p->width,
+                               pgm_read_byte(&icon_p[UI_ICON_HEIGHT_INDEX]));
+    }
+    else
+    {
+        const uint8_t top = (widget_p->y_pos > FONT_ASCENT) ?
+                            widget_p->y_pos - FONT_ASCENT : 0;
+
+        Display_ClearRectangle(widget_p->x_pos, top, widget_p->width,
+                               widget_p->y_pos + FONT_DESCENT - top);
+    }
 }
 
 static inline void PrintChar(const glyph_info_t *glyph, uint8_t x_base,
@@ -198,24 +646,49 @@ static inline void PrintChar(const glyph_info_t *glyph, uint8_t x_base,
 {
     sc_assert(glyph != NULL);
 
-    x_base += glyph->horizontal_bearing;
+    const uint8_t x = x_base + glyph->horizontal_bearing;
+    const int8_t y = (int8_t)y_base - glyph->baseline_offset - glyph->height;
+
+    //Glyph data layout is described in font_template.h.
+#if COMPRESSED_FONT
+    DrawPackedGlyph(glyph, x, y);
+#else
+    Display_DrawBitmap_P(x, y, glyph->data, glyph->width, glyph->height);
+#endif
+}
+
+#if COMPRESSED_FONT
+/**
+ * Expand the glyph bit stream one column at a time straight into VRAM.
+ *
+ * The stream is refilled a byte at a time and each column is extracted with
+ * a single mask and shift. Glyphs are less than 16 rows high so at most 22
+ * bits are buffered.
+ */
+static void DrawPackedGlyph(const glyph_info_t *glyph, uint8_t x, int8_t y)
+{
+    const uint8_t *data_p = glyph->data;
+    const uint8_t height = glyph->height;
+    const uint16_t column_mask = (uint16_t)((1u << height) - 1);
+    uint32_t stream = 0;
+    uint8_t nr_bits = 0;
 
-    for (uint8_t y_pos = 0; y_pos < glyph->height; ++y_pos)
+    for (uint8_t column = 0; column < glyph->width; ++column)
     {
-        for (uint8_t x_pos = 0; x_pos < glyph->width; ++x_pos)
+        if (x + column > UINT8_MAX)
         {
-            uint16_t bit_count = ((uint16_t)y_pos * (uint16_t)glyph->width +
-                                  (uint16_t)x_pos);
-            uint8_t byte_idx = bit_count / 8;
-            uint8_t bit_idx = bit_count % 8;
+            break;
+        }
 
-            if (IsPixelBitSet(pgm_read_byte(&glyph->data[byte_idx]), bit_idx))
-            {
-                Display_SetPixel(
-                    x_pos + x_base,
-                    y_pos + y_base - glyph->baseline_offset - glyph->height
-                );
-            }
+        while (nr_bits < height)
+        {
+            stream |= (uint32_t)pgm_read_byte(data_p++) << nr_bits;
+            nr_bits += 8;
         }
+
+        Display_DrawColumn(x + column, y, (uint16_t)stream & column_mask);
+        stream >>= height;
+        nr_bits -= height;
     }
 }
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file   libUI.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-05-26 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header of UI-library.
  *
  * Detailed description of file.
@@ -31,32 +31,104 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //INCLUDES
 //////////////////////////////////////////////////////////////////////////
 
+#include <stdint.h>
+#include <stdbool.h>
 #include <avr/pgmspace.h>
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
-#define libUI_Print(text, x_pos, y_pos, ...) libUI_Print_P(PSTR(text), x_pos, y_pos, ##__VA_ARGS__)
+#define libUI_Print(text, x_pos, y_pos) libUI_PrintText_P(PSTR(text), x_pos, y_pos)
+
+// Largest number of digits that can be requested with min_digits.
+#define UI_MAX_MIN_DIGITS 8
 
 // Standard y-positions for text baselines.
 #define UI_SINGLE_ROW 20
 #define UI_DOUBLE_ROW_FIRST 13
 #define UI_DOUBLE_ROW_SECOND 27
 
+// Icons are stored in flash as width, height followed by the bitmap in the
+// same column/page layout as Display_DrawBitmap_P.
+#define UI_ICON_WIDTH_INDEX 0
+#define UI_ICON_HEIGHT_INDEX 1
+#define UI_ICON_DATA_INDEX 2
+
+// Widget value for a missing measurement, numbers are rendered as dashes and
+// gauges and icons are hidden.
+#define UI_WIDGET_NO_VALUE INT16_MIN
+
+// Sparkline sample without a value, the column is left empty.
+#define UI_SPARKLINE_GAP UINT8_MAX
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+enum ui_widget_type_t
+{
+    UI_WIDGET_LABEL,        // Text in flash
+    UI_WIDGET_NUMBER,       // Integer followed by a unit in flash
+    UI_WIDGET_FIXED_POINT,  // Tenths followed by a unit in flash
+    UI_WIDGET_GAUGE,        // Icon outline filled with value columns
+    UI_WIDGET_ICON          // Icon shown when value is non-zero
+};
+
+/*
+ * Retained widgets are created once and drawn every frame, they are only
+ * rendered again when their value has changed or the frame has been cleared.
+ * Text widgets are positioned by their baseline, gauges and icons by their
+ * top left corner.
+ */
+struct ui_widget_t
+{
+    const void *data_p;
+    int16_t value;
+    uint8_t type;
+    uint8_t x_pos;
+    uint8_t y_pos;
+    uint8_t width;
+    bool dirty;
+};
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
 void libUI_Update(void);
-void libUI_PrintText(const char *buffer, uint8_t x_pos, uint8_t y_pos);
-void libUI_Print_P(const char *text, uint8_t x_pos, uint8_t y_pos, ...);
+void libUI_Clear(void);
+void libUI_RetainFrame(void);
+
+/*
+ * All widgets of a view using libUI_RetainFrame() must be drawn every frame,
+ * the widgets erase their own region before they are rendered again.
+ */
+void libUI_InitWidget(struct ui_widget_t *widget_p, enum ui_widget_type_t type,
+                      const void *data_p, uint8_t x_pos, uint8_t y_pos);
+void libUI_SetWidgetValue(struct ui_widget_t *widget_p, int16_t value);
+void libUI_DrawWidget(struct ui_widget_t *widget_p);
+
+/*
+ * The print functions render each character straight into VRAM and return
+ * the x-position following the printed text so that fields can be chained.
+ */
+uint8_t libUI_PrintText(const char *buffer, uint8_t x_pos, uint8_t y_pos);
+uint8_t libUI_PrintText_P(const char *text, uint8_t x_pos, uint8_t y_pos);
+uint8_t libUI_PrintUnsigned(uint32_t value, uint8_t min_digits, uint8_t x_pos, uint8_t y_pos);
+uint8_t libUI_PrintSigned(int32_t value, uint8_t x_pos, uint8_t y_pos);
+uint8_t libUI_PrintHex(uint32_t value, uint8_t min_digits, uint8_t x_pos, uint8_t y_pos);
+uint8_t libUI_PrintFixedPoint(int32_t value, uint8_t x_pos, uint8_t y_pos);
+
 void libUI_DrawLine(uint8_t x_start, uint8_t y_start, uint8_t x_end, uint8_t y_end);
+void libUI_DrawHorizontalLine(uint8_t x_pos, uint8_t y_pos, uint8_t length);
+void libUI_DrawVerticalLine(uint8_t x_pos, uint8_t y_pos, uint8_t length);
 void libUI_DrawRectangle(uint8_t x_start, uint8_t y_start, uint8_t width, uint8_t height);
+void libUI_FillRectangle(uint8_t x_pos, uint8_t y_pos, uint8_t width, uint8_t height);
+void libUI_InvertRectangle(uint8_t x_pos, uint8_t y_pos, uint8_t width, uint8_t height);
+void libUI_DrawIcon_P(const uint8_t *icon_p, uint8_t x_pos, uint8_t y_pos);
 void libUI_DrawCircle(uint8_t x_pos, uint8_t y_pos, uint8_t radius);
+void libUI_DrawSparkline(const uint8_t *samples_p, uint8_t nr_samples, uint8_t first,
+                         uint8_t x_pos, uint8_t y_pos, uint8_t height);
 
 #endif /* LIBUI_H_ */
@@ -1,7 +1,7 @@
 /**
  * @file   main_firmware.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-28 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of main
  */
 
@@ -30,6 +30,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <avr/io.h>
 #include <avr/wdt.h>
+#include <avr/sleep.h>
 
 #include "libDebug.h"
 #include "libSPI.h"
@@ -40,10 +41,12 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include "RTC.h"
 #include "ADC.h"
 #include "Sensor.h"
+#include "History.h"
 #include "Interface.h"
 #include "Timer.h"
 #include "Transceiver.h"
 #include "Com.h"
+#include "Channel.h"
 #include "Nodes.h"
 #include "Config.h"
 #include "ErrorHandler.h"
@@ -62,6 +65,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 #define LOW_STACK_LIMIT 100 // ~5% left of total memory
+#define SPI_TRACE_INTERVAL_MS 60000
+#define TRANSCEIVER_STATISTICS_INTERVAL_MS 60000
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -71,6 +76,8 @@ struct module_t
 {
     struct node_t nodes[3];
     uint32_t memory_check_timer;
+    uint32_t spi_trace_timer;
+    uint32_t transceiver_statistics_timer;
     bool memory_low_flag;
 };
 
@@ -85,6 +92,12 @@ static struct module_t module;
 //////////////////////////////////////////////////////////////////////////
 
 void CheckMemoryUsage(void);
+void SleepUntilDeadline(void);
+#ifdef DEBUG_ENABLE
+void ReportSPIUsage(void);
+void ReportTransceiverStatistics(void);
+#endif
+
 void assert_fail_handler(const char *file_p, int line_number, const char *expression_p);
 void handle_corrupt_config(void);
 
@@ -112,6 +125,7 @@ int main(void)
     libSPI_Init(1);
     RTC_Init();
     Sensor_Init();
+    History_Init();
     driverNTC_Init();
 
     Interface_Init();
@@ -120,12 +134,12 @@ int main(void)
         handle_corrupt_config();
     }
     Transceiver_Init();
+    //Readings are sent periodically, only the latest one from each node
+    //is of interest when the receive queue overflows.
+    Transceiver_SetOverflowPolicy(TR_OVERFLOW_REPLACE_SAME_ROUTE);
     Com_Init();
+    Channel_Init();
     Encoder_Init();
-    //NOTE: The first gui init called will be the root view.
-    guiRTC_Init();
-    guiSensor_Init();
-    guiNodes_Init();
     Nodes_Init();
 
     Sensor_Register(driverNTC_GetSensor(0));
@@ -137,6 +151,12 @@ int main(void)
         Nodes_Add(&module.nodes[i]);
     }
 
+    //NOTE: The first gui init called will be the root view. The sensor
+    //trends are attached by the gui so the nodes must be added first.
+    guiRTC_Init();
+    guiSensor_Init();
+    guiNodes_Init();
+
     Com_SetPacketHandler(PacketHandler_HandleReadingPacket, COM_PACKET_TYPE_READING);
 
     const struct encoder_callbacks_t encoder_callbacks =
@@ -147,11 +167,14 @@ int main(void)
         .extended_push = Interface_Action
     };
     Encoder_SetCallbacks(&encoder_callbacks);
+    Encoder_SetActivityCallback(Interface_RegisterActivity);
 
     INFO("Start up done");
     DEBUG("Device address: 0x%02X\r\n", Config_GetAddress());
 
     module.memory_check_timer = Timer_GetMilliseconds();
+    module.spi_trace_timer = Timer_GetMilliseconds();
+    module.transceiver_statistics_timer = Timer_GetMilliseconds();
 
     while (1)
     {
@@ -159,8 +182,14 @@ int main(void)
         Sensor_Update();
         Transceiver_Update();
         Com_Update();
+        Channel_Update();
         Interface_Update();
         CheckMemoryUsage();
+#ifdef DEBUG_ENABLE
+        ReportSPIUsage();
+        ReportTransceiverStatistics();
+#endif
+        SleepUntilDeadline();
     }
 
     CRITICAL("Main loop exit");
@@ -188,14 +217,70 @@ void CheckMemoryUsage(void)
     }
 }
 
+#ifdef DEBUG_ENABLE
+void ReportSPIUsage(void)
+{
+    if (Timer_TimeDifference(module.spi_trace_timer) > SPI_TRACE_INTERVAL_MS)
+    {
+        libSPI_DumpTrace();
+        libSPI_ResetTrace();
+        module.spi_trace_timer = Timer_GetMilliseconds();
+    }
+}
+
+void ReportTransceiverStatistics(void)
+{
+    if (Timer_TimeDifference(module.transceiver_statistics_timer) >
+            TRANSCEIVER_STATISTICS_INTERVAL_MS)
+    {
+        struct transceiver_statistics_t statistics;
+        Transceiver_GetStatistics(&statistics);
+
+        for (uint8_t i = 0; i < TR_NR_PRIORITIES; ++i)
+        {
+            INFO("TX[%u]: %u max, %u dropped", i,
+                 statistics.tx[i].high_water_mark, statistics.tx[i].dropped);
+        }
+        INFO("RX: %u max, %u dropped",
+             statistics.rx.high_water_mark, statistics.rx.dropped);
+
+        Transceiver_ResetStatistics();
+        module.transceiver_statistics_timer = Timer_GetMilliseconds();
+    }
+}
+#endif
+
+void SleepUntilDeadline(void)
+{
+    // Idle keeps the timer, UART, SPI and ADC running. Any interrupt wakes
+    // the CPU, at the latest the next timer tick, so the other modules are
+    // still polled every millisecond.
+    if (Sensor_GetTimeToDeadline() > 0)
+    {
+        set_sleep_mode(SLEEP_MODE_IDLE);
+        sleep_mode();
+    }
+}
+
 void assert_fail_handler(const char *file_p, int line_number, const char *expression_p)
 {
+    static bool flushing = false;
+
     UNUSED(expression_p);
     ErrorHandler_LogError(ASSFAIL, 0);
 
+    //The device is halted until it is reset by the user, save the sensor
+    //statistics first. An assert while flushing must not flush again.
+    if (!flushing)
+    {
+        flushing = true;
+        Sensor_Flush();
+    }
+
     const char *file_name = strrchr_P(file_p, '/');
-    libUI_Print("Assert: %i", 2, UI_DOUBLE_ROW_FIRST, line_number);
-    libUI_Print_P(file_name, 2, UI_DOUBLE_ROW_SECOND);
+    uint8_t x_pos = libUI_Print("Assert: ", 2, UI_DOUBLE_ROW_FIRST);
+    libUI_PrintSigned(line_number, x_pos, UI_DOUBLE_ROW_FIRST);
+    libUI_PrintText_P(file_name, 2, UI_DOUBLE_ROW_SECOND);
     libUI_Update();
 }
 
@@ -205,7 +290,10 @@ void handle_corrupt_config(void)
     ErrorHandler_LogError(CORRUPT_CONFIG, 0);
 
     libUI_Print("Corrupt config", 0, UI_DOUBLE_ROW_FIRST);
-    libUI_Print("V:0x%02X, E:0x%02X", 0, UI_DOUBLE_ROW_SECOND, Config_GetVersion(), CORRUPT_CONFIG);
+    uint8_t x_pos = libUI_Print("V:0x", 0, UI_DOUBLE_ROW_SECOND);
+    x_pos = libUI_PrintHex(Config_GetVersion(), 2, x_pos, UI_DOUBLE_ROW_SECOND);
+    x_pos = libUI_Print(", E:0x", x_pos, UI_DOUBLE_ROW_SECOND);
+    libUI_PrintHex(CORRUPT_CONFIG, 2, x_pos, UI_DOUBLE_ROW_SECOND);
     libUI_Update();
 
     ErrorHandler_PointOfNoReturn();
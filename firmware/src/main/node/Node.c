@@ -1,7 +1,7 @@
 /**
  * @file   Node.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-09-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of remote node abstraction layer.
  */
 
@@ -41,6 +41,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define SEC_IN_MS 1000
 
+//How often received readings are picked up by the sensor module.
+#define SENSOR_PERIOD_MS 500
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -76,6 +79,8 @@ void Node_Init(struct node_t *self_p, uint8_t id)
      */
     self_p->sensor.temperature.Update = NULL;
     self_p->sensor.humidity.Update = NULL;
+    self_p->sensor.temperature.period_ms = SENSOR_PERIOD_MS;
+    self_p->sensor.humidity.period_ms = SENSOR_PERIOD_MS;
 
     self_p->sensor.temperature.valid = false;
     self_p->sensor.humidity.valid = false;
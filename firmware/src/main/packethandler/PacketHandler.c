@@ -1,7 +1,7 @@
 /**
  * @file   PacketHandler.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-14 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of a node packet handler.
  */
 
@@ -31,9 +31,11 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include "Nodes.h"
 #include "Node.h"
 #include "Com.h"
+#include "Channel.h"
 #include "Time.h"
 #include "RTC.h"
 #include "ErrorHandler.h"
+#include "Interface.h"
 #include "libDebug.h"
 
 //////////////////////////////////////////////////////////////////////////
@@ -71,6 +73,10 @@ bool PacketHandler_HandleReadingPacket(const packet_frame_type *packet_p)
         Node_ReportActivity(node_p);
         Node_SetRSSI(node_p, packet_p->header.rssi);
         Node_Update(node_p, packet_p->content.data, (size_t)packet_p->content.size);
+        Interface_Refresh();
+
+        // The announcement must be sent first, the node sleeps after the ACK.
+        Channel_Announce(Node_GetID(node_p));
         SendAck(Node_GetID(node_p));
 
         return true;
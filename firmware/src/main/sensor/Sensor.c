@@ -1,7 +1,7 @@
 /**
  * @file   Sensor.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-14 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of Sensor module
  *
  * Detailed description of file.
@@ -33,6 +33,10 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include "CRC.h"
 #include "libDebug.h"
 #include "driverNVM.h"
+#include "Interface.h"
+#include "Timer.h"
+#include "Trend.h"
+#include "History.h"
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
@@ -40,6 +44,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define MAX_NUMBER_OF_SENSORS 9
 
+//Longest time a changed max or min value is kept in SRAM only.
+#define FLUSH_INTERVAL_MS 60000
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -47,7 +54,11 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 struct module_t
 {
     struct sensor_t *sensors[MAX_NUMBER_OF_SENSORS];
+    uint8_t schedule[MAX_NUMBER_OF_SENSORS];
     size_t number_of_sensors;
+    uint16_t dirty_mask;
+    uint32_t flush_timer;
+    uint32_t now;
 };
 
 struct __attribute__((packed)) sensor_statistics_t
@@ -68,7 +79,14 @@ static struct module_t module;
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
-static void SetSensorValues(struct sensor_t *self, int16_t value);
+static void UpdateSensor(struct sensor_t *self);
+static bool IsDue(const struct sensor_t *self);
+static bool IsNotAfter(const struct sensor_t *self, const struct sensor_t *other);
+static void Schedule(void);
+static void Reschedule(void);
+static bool SetSensorValues(struct sensor_t *self, int16_t value);
+static void MarkDirty(const struct sensor_t *self);
+static void RecordHistory(uint16_t period);
 static void WriteValuesToNVM(const struct sensor_t *self);
 static void ReadValuesFromNVM(struct sensor_t *self);
 static void ResetValues(struct sensor_t *self);
@@ -81,31 +99,81 @@ static void UpdateCRC(struct sensor_statistics_t *statistics);
 
 void Sensor_Init(void)
 {
+    _Static_assert(MAX_NUMBER_OF_SENSORS <= 16, "Invalid number of sensors!");
+    _Static_assert(MAX_NUMBER_OF_SENSORS * sizeof(struct sensor_statistics_t) <=
+                   HISTORY_NVM_ADDRESS, "Statistics overlap the history!");
+
     module.number_of_sensors = 0;
+    module.dirty_mask = 0;
+    module.now = 0;
 
     INFO("Sensor module initialized");
 }
 
 void Sensor_Update(void)
 {
-    for (size_t i = 0; i < module.number_of_sensors; ++i)
+    module.now = Timer_GetMilliseconds();
+
+    while (module.number_of_sensors > 0 &&
+            IsDue(module.sensors[module.schedule[0]]))
     {
-        if (module.sensors[i]->Update != NULL)
+        struct sensor_t *sensor_p = module.sensors[module.schedule[0]];
+
+        UpdateSensor(sensor_p);
+
+        // Missed periods are skipped instead of run back to back.
+        sensor_p->deadline += sensor_p->period_ms;
+        if (IsDue(sensor_p))
         {
-            module.sensors[i]->Update(module.sensors[i]);
+            sensor_p->deadline = module.now + sensor_p->period_ms;
         }
 
-        if (Sensor_IsValid(module.sensors[i]))
+        Reschedule();
+    }
+
+    uint16_t period;
+    if (History_IsSampleDue(&period))
+    {
+        RecordHistory(period);
+    }
+
+    if (module.dirty_mask != 0 &&
+            module.now - module.flush_timer >= FLUSH_INTERVAL_MS)
+    {
+        Sensor_Flush();
+    }
+}
+
+uint32_t Sensor_GetTimeToDeadline(void)
+{
+    if (module.number_of_sensors == 0)
+    {
+        return UINT32_MAX;
+    }
+
+    const struct sensor_t *sensor_p = module.sensors[module.schedule[0]];
+    const int32_t remaining = (int32_t)(sensor_p->deadline - Timer_GetMilliseconds());
+
+    return remaining > 0 ? (uint32_t)remaining : 0;
+}
+
+void Sensor_Flush(void)
+{
+    for (size_t i = 0; i < module.number_of_sensors; ++i)
+    {
+        if ((module.dirty_mask & (1U << i)) != 0)
         {
-            SetSensorValues(module.sensors[i], module.sensors[i]->value);
             WriteValuesToNVM(module.sensors[i]);
         }
     }
+
+    module.dirty_mask = 0;
 }
 
 void Sensor_Register(struct sensor_t *self)
 {
     sc_assert(self != NULL);
+    sc_assert(self->period_ms > 0);
     sc_assert(module.number_of_sensors < ElementsIn(module.sensors));
 
     module.sensors[module.number_of_sensors] = self;
@@ -117,7 +185,11 @@ void Sensor_Register(struct sensor_t *self)
     ResetValues(module.sensors[module.number_of_sensors]);
     ReadValuesFromNVM(module.sensors[module.number_of_sensors]);
 
+    // Due at the next update.
+    self->deadline = module.now;
+
     ++module.number_of_sensors;
+    Schedule();
 }
 
 bool Sensor_GetValue(const struct sensor_t *self, int16_t *value)
@@ -161,35 +233,164 @@ bool Sensor_IsStatisticsValid(const struct sensor_t *self)
     return self->statistics.valid;
 }
 
+void Sensor_SetTrend(struct sensor_t *self, struct trend_t *trend_p)
+{
+    sc_assert(self != NULL);
+
+    self->trend_p = trend_p;
+}
+
 void Sensor_Reset(struct sensor_t *self)
 {
     sc_assert(self != NULL);
 
     ResetValues(self);
     WriteValuesToNVM(self);
+
+    module.dirty_mask &= ~(1U << self->id);
 }
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
 
-static void SetSensorValues(struct sensor_t *self, int16_t value)
+/**
+ * Update the sensor and everything that depends on its value.
+ */
+static void UpdateSensor(struct sensor_t *self)
+{
+    const int16_t previous_value = self->value;
+    const bool previous_valid = self->valid;
+
+    if (self->Update != NULL)
+    {
+        self->Update(self);
+    }
+
+    if (self->value != previous_value || self->valid != previous_valid)
+    {
+        Interface_Refresh();
+    }
+
+    if (Sensor_IsValid(self) && SetSensorValues(self, self->value))
+    {
+        MarkDirty(self);
+    }
+
+    if (self->trend_p != NULL &&
+            Trend_Update(self->trend_p, self->value, Sensor_IsValid(self)))
+    {
+        Interface_Refresh();
+    }
+}
+
+static bool IsDue(const struct sensor_t *self)
+{
+    return (int32_t)(module.now - self->deadline) >= 0;
+}
+
+/**
+ * Compare deadlines, the timer wraps so the difference is used.
+ */
+static bool IsNotAfter(const struct sensor_t *self, const struct sensor_t *other)
+{
+    return (int32_t)(self->deadline - other->deadline) <= 0;
+}
+
+/**
+ * Move the last registered sensor forward to its place in the schedule.
+ */
+static void Schedule(void)
+{
+    const uint8_t id = module.number_of_sensors - 1;
+    size_t index = id;
+
+    while (index > 0 &&
+            !IsNotAfter(module.sensors[module.schedule[index - 1]], module.sensors[id]))
+    {
+        module.schedule[index] = module.schedule[index - 1];
+        --index;
+    }
+
+    module.schedule[index] = id;
+}
+
+/**
+ * Move the first sensor back to its place after its deadline has been
+ * advanced. Sensors with equal deadlines keep their order.
+ */
+static void Reschedule(void)
+{
+    const uint8_t id = module.schedule[0];
+    size_t index = 0;
+
+    while (index + 1 < module.number_of_sensors &&
+            IsNotAfter(module.sensors[module.schedule[index + 1]], module.sensors[id]))
+    {
+        module.schedule[index] = module.schedule[index + 1];
+        ++index;
+    }
+
+    module.schedule[index] = id;
+}
+
+/**
+ * Update the statistics with the supplied value.
+ *
+ * @return True if the statistics changed.
+ */
+static bool SetSensorValues(struct sensor_t *self, int16_t value)
 {
     sc_assert(self != NULL);
 
+    bool changed = !self->statistics.valid;
+
     self->value = value;
 
     if (value > self->statistics.max)
     {
         self->statistics.max = value;
+        changed = true;
     }
 
     if (value < self->statistics.min)
     {
         self->statistics.min = value;
+        changed = true;
     }
 
     self->statistics.valid = true;
+
+    return changed;
+}
+
+/**
+ * Mark the statistics for write-back, the flush timer is started by the
+ * first change so no change is kept longer than the flush interval.
+ */
+static void MarkDirty(const struct sensor_t *self)
+{
+    if (module.dirty_mask == 0)
+    {
+        module.flush_timer = module.now;
+    }
+
+    module.dirty_mask |= 1U << self->id;
+}
+
+/**
+ * Append the value of each valid sensor to the history, invalid sensors
+ * are left with a gap.
+ */
+static void RecordHistory(uint16_t period)
+{
+    for (size_t i = 0; i < module.number_of_sensors; ++i)
+    {
+        if (Sensor_IsValid(module.sensors[i]))
+        {
+            History_Append(module.sensors[i]->id, period, module.sensors[i]->value);
+        }
+    }
 }
 
 static void WriteValuesToNVM(const struct sensor_t *self)
@@ -235,16 +436,14 @@ static void ResetValues(struct sensor_t *self)
 
 static bool IsCRCValid(const struct sensor_statistics_t *statistics)
 {
-    size_t size;
-    size = sizeof(*statistics) - offsetof(__typeof__(*statistics), crc);
+    const size_t size = offsetof(__typeof__(*statistics), crc);
 
     return CRC_16(statistics, size) == statistics->crc;
 }
 
 static void UpdateCRC(struct sensor_statistics_t *statistics)
 {
-    size_t size;
-    size = sizeof(*statistics) - offsetof(__typeof__(*statistics), crc);
+    const size_t size = offsetof(__typeof__(*statistics), crc);
 
     statistics->crc = CRC_16(statistics, size);
 }
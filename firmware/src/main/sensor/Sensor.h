@@ -1,7 +1,7 @@
 /**
  * @file   Sensor.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-09-13 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header of Sensor module
  *
  * Detailed description of file.
@@ -42,10 +42,14 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
 
+struct trend_t;
+
 struct sensor_t
 {
     void (*Update)(struct sensor_t *);
     uint16_t id;
+    uint16_t period_ms;
+    uint32_t deadline;
     int16_t value;
     bool valid;
     struct
@@ -54,6 +58,7 @@ struct sensor_t
         int16_t min;
         bool valid;
     } statistics;
+    struct trend_t *trend_p;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -66,15 +71,33 @@ struct sensor_t
 void Sensor_Init(void);
 
 /**
- * Update all sensors registered in the sensor module.
+ * Update the sensors registered in the sensor module whose period has
+ * expired. Sensors are kept ordered by deadline so only the first one is
+ * checked when nothing is due.
  */
 void Sensor_Update(void);
 
 /**
- * Register a sensor to the sensor module. This sensor will be updated when
- * `Sensor_Update()` is called.
+ * Get the time left until the next sensor is due.
  *
- * @param self Pointer to sensor struct.
+ * @return Milliseconds until `Sensor_Update()` has a sensor to update, zero
+ *         if a sensor is already due or UINT32_MAX if no sensors are
+ *         registered.
+ */
+uint32_t Sensor_GetTimeToDeadline(void);
+
+/**
+ * Write all changed statistics to NVM. Statistics are written back
+ * periodically by `Sensor_Update()`, call this before a reset to make sure
+ * no changes are lost.
+ */
+void Sensor_Flush(void);
+
+/**
+ * Register a sensor to the sensor module. This sensor will be updated by
+ * `Sensor_Update()` every `period_ms`, starting with the next call.
+ *
+ * @param self Pointer to sensor struct, with a non-zero period.
  */
 void Sensor_Register(struct sensor_t *self);
 
@@ -126,6 +149,15 @@ bool Sensor_IsValid(const struct sensor_t *self);
  */
 bool Sensor_IsStatisticsValid(const struct sensor_t *self);
 
+/**
+ * Attach a trend to the supplied sensor. The trend is updated with the
+ * sensor value each time `Sensor_Update()` is called.
+ *
+ * @param self    Pointer to sensor struct.
+ * @param trend_p Pointer to an initialized trend, or NULL to detach.
+ */
+void Sensor_SetTrend(struct sensor_t *self, struct trend_t *trend_p);
+
 /**
  * Reset the recorded values for the supplied sensor.
  *
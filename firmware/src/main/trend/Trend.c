@@ -0,0 +1,197 @@
+/**
+ * @file   Trend.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Implementation of Trend module
+ *
+ * Values are averaged over one sample period and stored as a single byte,
+ * keeping the trend of a sensor within a few tens of bytes of SRAM.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include "common.h"
+#include "Timer.h"
+#include "Trend.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+static uint8_t Quantise(const struct trend_t *self_p, int16_t value);
+static int16_t Dequantise(const struct trend_t *self_p, uint8_t sample);
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+void Trend_Init(struct trend_t *self_p, int16_t offset, uint8_t divisor,
+                uint16_t period_s)
+{
+    sc_assert(self_p != NULL);
+    sc_assert(divisor > 0);
+    sc_assert(period_s > 0);
+
+    for (size_t i = 0; i < ElementsIn(self_p->samples); ++i)
+    {
+        self_p->samples[i] = TREND_NO_SAMPLE;
+    }
+
+    self_p->head = 0;
+    self_p->divisor = divisor;
+    self_p->offset = offset;
+    self_p->period_s = period_s;
+    self_p->nr_values = 0;
+    self_p->sum = 0;
+    self_p->timer = Timer_GetMilliseconds();
+}
+
+bool Trend_Update(struct trend_t *self_p, int16_t value, bool valid)
+{
+    sc_assert(self_p != NULL);
+
+    if (valid)
+    {
+        //Halve the accumulator instead of overflowing it, older values
+        //in the period simply get less weight.
+        if (self_p->nr_values == UINT16_MAX)
+        {
+            self_p->sum /= 2;
+            self_p->nr_values /= 2;
+        }
+
+        self_p->sum += value;
+        ++self_p->nr_values;
+    }
+
+    const uint32_t period_ms = (uint32_t)self_p->period_s * 1000;
+
+    if (Timer_TimeDifference(self_p->timer) < period_ms)
+    {
+        return false;
+    }
+
+    //Advance by whole periods so the sample rate doesn't drift with the
+    //main loop latency.
+    self_p->timer += period_ms;
+
+    uint8_t sample = TREND_NO_SAMPLE;
+
+    if (self_p->nr_values > 0)
+    {
+        sample = Quantise(self_p, (int16_t)(self_p->sum / self_p->nr_values));
+    }
+
+    self_p->samples[self_p->head] = sample;
+    self_p->head = (self_p->head + 1) % TREND_NR_SAMPLES;
+
+    self_p->sum = 0;
+    self_p->nr_values = 0;
+
+    return true;
+}
+
+const uint8_t *Trend_GetSamples(const struct trend_t *self_p, uint8_t *first_p)
+{
+    sc_assert(self_p != NULL);
+    sc_assert(first_p != NULL);
+
+    //The head is the next slot to overwrite, i.e. the oldest sample.
+    *first_p = self_p->head;
+    return self_p->samples;
+}
+
+bool Trend_GetRange(const struct trend_t *self_p, int16_t *min_p, int16_t *max_p)
+{
+    sc_assert(self_p != NULL);
+    sc_assert(min_p != NULL);
+    sc_assert(max_p != NULL);
+
+    uint8_t min = TREND_NO_SAMPLE;
+    uint8_t max = 0;
+
+    for (size_t i = 0; i < ElementsIn(self_p->samples); ++i)
+    {
+        const uint8_t sample = self_p->samples[i];
+
+        if (sample == TREND_NO_SAMPLE)
+        {
+            continue;
+        }
+
+        if (sample < min)
+        {
+            min = sample;
+        }
+
+        if (sample > max)
+        {
+            max = sample;
+        }
+    }
+
+    if (min == TREND_NO_SAMPLE)
+    {
+        return false;
+    }
+
+    *min_p = Dequantise(self_p, min);
+    *max_p = Dequantise(self_p, max);
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+static uint8_t Quantise(const struct trend_t *self_p, int16_t value)
+{
+    const int32_t sample = ((int32_t)value - self_p->offset) / self_p->divisor;
+
+    if (sample < 0)
+    {
+        return 0;
+    }
+    else if (sample > TREND_MAX_SAMPLE)
+    {
+        return TREND_MAX_SAMPLE;
+    }
+
+    return (uint8_t)sample;
+}
+
+static int16_t Dequantise(const struct trend_t *self_p, uint8_t sample)
+{
+    return (int16_t)((int32_t)sample * self_p->divisor + self_p->offset);
+}
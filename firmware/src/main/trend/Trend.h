@@ -0,0 +1,123 @@
+/**
+ * @file   Trend.h
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Header of Trend module
+ *
+ * Fixed size ring of downsampled and 8-bit quantised sensor values.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TREND_H_
+#define TREND_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define TREND_NR_SAMPLES 64
+
+//Stored for periods without any valid values.
+#define TREND_NO_SAMPLE UINT8_MAX
+#define TREND_MAX_SAMPLE (TREND_NO_SAMPLE - 1)
+
+//Temperatures in tenths of degrees, -40.0 to 87.0 in steps of 0.5.
+#define TREND_TEMPERATURE_OFFSET -400
+#define TREND_TEMPERATURE_DIVISOR 5
+
+//Sample period for a 12 hour window.
+#define TREND_DEFAULT_PERIOD_S ((12U * 60U * 60U) / TREND_NR_SAMPLES)
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+struct trend_t
+{
+    uint8_t samples[TREND_NR_SAMPLES];
+    uint8_t head;
+    uint8_t divisor;
+    int16_t offset;
+    uint16_t period_s;
+    uint16_t nr_values;
+    int32_t sum;
+    uint32_t timer;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+/**
+ * Initialize the trend, all samples are cleared.
+ *
+ * A value is stored as `(value - offset) / divisor`, saturated to the
+ * range 0 to `TREND_MAX_SAMPLE`.
+ *
+ * @param self_p   Pointer to trend struct.
+ * @param offset   Value stored as zero.
+ * @param divisor  Value units per quantisation step.
+ * @param period_s Seconds averaged into each sample, the trend covers
+ *                 `TREND_NR_SAMPLES` periods.
+ */
+void Trend_Init(struct trend_t *self_p, int16_t offset, uint8_t divisor,
+                uint16_t period_s);
+
+/**
+ * Accumulate the current value and store a new sample when the sample
+ * period has expired.
+ *
+ * @param self_p Pointer to trend struct.
+ * @param value  Current value.
+ * @param valid  True if the value shall be included in the average.
+ *
+ * @return True if a new sample was stored, otherwise false.
+ */
+bool Trend_Update(struct trend_t *self_p, int16_t value, bool valid);
+
+/**
+ * Get the sample ring.
+ *
+ * @param self_p  Pointer to trend struct.
+ * @param first_p Pointer to variable where the index of the oldest sample
+ *                will be stored.
+ *
+ * @return Pointer to the `TREND_NR_SAMPLES` long sample ring.
+ */
+const uint8_t *Trend_GetSamples(const struct trend_t *self_p, uint8_t *first_p);
+
+/**
+ * Get the lowest and highest stored sample, converted back to values.
+ *
+ * @param self_p Pointer to trend struct.
+ * @param min_p  Pointer to variable where the minimum will be stored.
+ * @param max_p  Pointer to variable where the maximum will be stored.
+ *
+ * @return True if the trend contains any samples, otherwise false.
+ */
+bool Trend_GetRange(const struct trend_t *self_p, int16_t *min_p, int16_t *max_p);
+
+#endif
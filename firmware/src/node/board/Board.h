@@ -1,7 +1,7 @@
 /**
  * @file   Board.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-05-01 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Board support package for the node unit.
  */
 
@@ -40,6 +40,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define RTC_SPI_MFP     DD3
 #define RTC_SPI_SS      DDD4
 #define RTC_SPI_MODE 0
+/* MCP79510 SCK max 5 MHz at 2.5 V and above. */
+#define RTC_SPI_CLOCK_DIVIDER LIBSPI_CLOCK_DIV_2
 
 #define RTC_EXTERNAL_BATTERY false
 
@@ -47,6 +49,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define RFM69_SPI_PORT  PORTB
 #define RFM69_SPI_SS    DDB2
 #define RFM69_SPI_MODE  0
+/* RFM69 SCK max 10 MHz. */
+#define RFM69_SPI_CLOCK_DIVIDER LIBSPI_CLOCK_DIV_2
 
 #define RFM69_RESET_DDR     DDRC
 #define RFM69_RESET_PORT    PORTC
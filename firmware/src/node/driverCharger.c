@@ -1,7 +1,7 @@
 /**
  * @file   driverCharger.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-04-20 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  LTC4060 charger driver
  *
  * Driver for the LTC4060 NiMH/NICd fast battery charger.
@@ -46,7 +46,17 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define VREF            3300    // mV
 #define R1_RESISTANCE   5600    // Ohm
 #define R2_RESISTANCE   100000  // Ohm
-#define SAMPLE_PERIOD   20      // ms
+#define EXTRA_BITS      1
+
+// Timer0 is stopped during the quiet conversion, about 1.2 ms per read. At
+// one read per second the millisecond timer loses about 0.1%, the battery
+// voltage changes far slower than that.
+#define SAMPLE_PERIOD   1000    // ms
+
+// A single glitch must not trigger a low battery event, the median removes
+// spikes of up to two samples before the EMA with smoothing factor 1/8.
+#define MEDIAN_LENGTH   5
+#define EMA_SHIFT       3
 
 #define CONNECTED_PIN       PINC1
 #define CONNECTED_PIN_INT   PCINT9
@@ -66,7 +76,8 @@ struct module_t
     } adc;
     struct
     {
-        struct filter_t voltage;
+        struct filter_median_t median;
+        struct filter_shift_t voltage;
     } filter;
     uint32_t sample_timer;
 };
@@ -77,6 +88,12 @@ struct module_t
 
 static struct module_t module;
 
+static const struct filter_stage_t voltage_filter[] =
+{
+    FILTER_STAGE_MEDIAN(&module.filter.median),
+    FILTER_STAGE_SHIFT(&module.filter.voltage)
+};
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -107,7 +124,10 @@ void driverCharger_Init(void)
 
     InitChargerPins();
 
-    Filter_Init(&module.filter.voltage, GetBatteryVoltage(), FILTER_ALPHA(0.1));
+    const uint16_t voltage = GetBatteryVoltage();
+
+    Filter_MedianInit(&module.filter.median, (int16_t)voltage, MEDIAN_LENGTH);
+    Filter_ShiftInit(&module.filter.voltage, (int16_t)voltage, EMA_SHIFT);
     module.sample_timer = 0;
 
     INFO("LTC4060 driver initialized");
@@ -119,7 +139,7 @@ void driverCharger_Update(void)
     {
         uint16_t voltage = GetBatteryVoltage();
 
-        Filter_Process(&module.filter.voltage, (int16_t)voltage);
+        Filter_CascadeProcess(voltage_filter, ElementsIn(voltage_filter), (int16_t)voltage);
 
         module.sample_timer = Timer_GetMilliseconds();
     }
@@ -137,7 +157,7 @@ bool driverCharger_IsCharging(void)
 
 uint16_t driverCharger_GetBatteryVoltage(void)
 {
-    return (uint16_t)Filter_Output(&module.filter.voltage);
+    return (uint16_t)Filter_ShiftOutput(&module.filter.voltage);
 }
 
 int16_t driverCharger_GetBatteryTemperature(void)
@@ -164,8 +184,7 @@ void InitChargerPins(void)
 
 uint16_t GetBatteryVoltage(void)
 {
-    uint16_t adc_value;
-    ADC_Convert(&module.adc.voltage, &adc_value, 1);
+    const uint16_t adc_value = ADC_ConvertQuiet(&module.adc.voltage, EXTRA_BITS);
 
     /**
      *
@@ -187,5 +206,5 @@ uint16_t GetBatteryVoltage(void)
      */
 
     return ((uint32_t)adc_value * VREF) /
-           ((R2_RESISTANCE * 1024) / (R1_RESISTANCE + R2_RESISTANCE));
+           ((R2_RESISTANCE * (1024UL << EXTRA_BITS)) / (R1_RESISTANCE + R2_RESISTANCE));
 }
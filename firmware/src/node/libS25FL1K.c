@@ -1,7 +1,7 @@
 /**
  * @file   libS25FL1K.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2017-08-17 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of the S25FL1-K low level driver.
  *
  * Detailed description of file.
@@ -50,6 +50,13 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //VARIABLES
 //////////////////////////////////////////////////////////////////////////
 
+static const struct libSPI_profile_t spi_profile =
+{
+    .mode = SPIMODE,
+    .clock_divider = SPICLOCKDIVIDER,
+    .trace_id = LIBSPI_TRACE_ID_FLASH
+};
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -150,14 +157,14 @@ void libS25FL1K_ExitDeepPowerDown(void)
 /// @brief Prepare for SPI read/write.
 ///
 
-/// Sets the correct SPI mode and pulls SS low so the device is selected.
+/// Sets the correct SPI mode and clock rate and pulls SS low so the device is selected.
 ///
 /// @param  None
 /// @return None
 ///
 static void PreCallback(void)
 {
-    libSPI_SetMode(SPIMODE);
+    libSPI_SetProfile(&spi_profile);
     PullCS();
 
     return;
@@ -1,7 +1,7 @@
 /**
  * @file   libS25FL1K_HAL.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-04-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Header with HAL defines for the S25FL1-K low level driver.
  *
  * Detailed description of file.
@@ -47,6 +47,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #define PullWP() PORTC &= ~(1 << WP_PIN)
 
 #define SPIMODE 0
+//The flash handles up to 108 MHz, run at the highest rate the MCU supports.
+#define SPICLOCKDIVIDER LIBSPI_CLOCK_DIV_2
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
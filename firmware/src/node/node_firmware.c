@@ -1,7 +1,7 @@
 /**
  * @file   node_firmware.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of main
  *
  * Detailed description of file.
@@ -61,6 +61,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 #define MAX_AWAKE_TIME_MS 1000
+#define MAX_MISSED_REPLIES 3
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -72,11 +73,21 @@ typedef struct
     bool sleep_now;
 } sleep_status_type;
 
+typedef struct
+{
+    bool reply_received;
+    bool hunting;
+    uint8_t missed_replies;
+    bool switch_pending;
+    struct packet_channel_t announcement;
+} channel_status_type;
+
 //////////////////////////////////////////////////////////////////////////
 //VARIABLES
 //////////////////////////////////////////////////////////////////////////
 
 static sleep_status_type sleep_status = {0};
+static channel_status_type channel_status = {0};
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
@@ -87,6 +98,8 @@ static bool IsTimeForSleep(void);
 static void RHTAvailable(const event_t *event __attribute__ ((unused)));
 static void CriticalBatteryVoltageHandler(const event_t *event __attribute__ ((unused)));
 static bool TimePacketHandler(const packet_frame_type *packet);
+static bool ChannelPacketHandler(const packet_frame_type *packet);
+static void UpdateChannel(void);
 static void FillPacket(struct packet_t *packet_p);
 
 //////////////////////////////////////////////////////////////////////////
@@ -132,6 +145,8 @@ int main(void)
 
     Sensor_Init();
     Transceiver_Init();
+    //A newer reading supersedes one still waiting to be sent.
+    Transceiver_SetOverflowPolicy(TR_OVERFLOW_REPLACE_SAME_ROUTE);
     Com_Init();
     Power_Init();
 
@@ -140,6 +155,7 @@ int main(void)
     libS25FL1K_EnterDeepPowerDown();
 
     Com_SetPacketHandler(TimePacketHandler, COM_PACKET_TYPE_TIME);
+    Com_SetPacketHandler(ChannelPacketHandler, COM_PACKET_TYPE_CHANNEL);
 
 #ifdef DEBUG_ENABLE
     //IMPORTENT: The debug wakeup must be called first to enable debug prints
@@ -208,10 +224,87 @@ static bool TimePacketHandler(const packet_frame_type *packet)
     }
 
     sleep_status.sleep_now = true;
+    channel_status.reply_received = true;
 
     return status;
 }
 
+static bool ChannelPacketHandler(const packet_frame_type *packet)
+{
+    sc_assert(packet != NULL);
+
+    struct packet_channel_t announcement;
+
+    if (packet->content.size != sizeof(announcement))
+    {
+        WARNING("Invalid channel packet size: %u", packet->content.size);
+        return false;
+    }
+
+    memcpy(&announcement, packet->content.data, sizeof(announcement));
+
+    if (announcement.channel >= TR_NR_CHANNELS)
+    {
+        WARNING("Invalid channel: %u", announcement.channel);
+        return false;
+    }
+
+    channel_status.announcement = announcement;
+    channel_status.switch_pending = true;
+
+    INFO("Channel switch to %u at %lu", announcement.channel,
+         announcement.switch_timestamp);
+
+    return true;
+}
+
+static void UpdateChannel(void)
+{
+    if (channel_status.reply_received)
+    {
+        channel_status.missed_replies = 0;
+        channel_status.hunting = false;
+    }
+    else if (channel_status.missed_replies < UINT8_MAX)
+    {
+        ++channel_status.missed_replies;
+    }
+    channel_status.reply_received = false;
+
+    uint8_t channel = Transceiver_GetChannel();
+
+    if (channel_status.switch_pending)
+    {
+        struct time_t time;
+
+        // The switch stays pending until the RTC can be read.
+        if (RTC_GetCurrentTime(&time) &&
+                Time_ConvertToTimestamp(&time) >= channel_status.announcement.switch_timestamp)
+        {
+            channel = channel_status.announcement.channel;
+            channel_status.switch_pending = false;
+            channel_status.missed_replies = 0;
+        }
+    }
+    else if (channel_status.hunting)
+    {
+        // Step through the channel plan until the master is found.
+        channel = (channel + 1) % TR_NR_CHANNELS;
+    }
+    else if (channel_status.missed_replies >= MAX_MISSED_REPLIES)
+    {
+        // Lost sync with the master, start looking on the rendezvous channel.
+        WARNING("Lost sync on channel %u", channel);
+        channel = TR_RENDEZVOUS_CHANNEL;
+        channel_status.hunting = true;
+    }
+
+    if (!Transceiver_SetChannel(channel))
+    {
+        WARNING("Failed to change channel");
+    }
+}
+
 static void FillPacket(struct packet_t *packet_p)
 {
     packet_p->battery.voltage = driverCharger_GetBatteryVoltage();
@@ -284,6 +377,13 @@ static void NotifyAndEnterSleep(void)
     RTC_SetAlarmTime(&time);
     RTC_EnableAlarm(true);
 
+#ifdef DEBUG_ENABLE
+    //Bus usage for the wake cycle, printed before the sleep event flushes
+    //the debug output.
+    libSPI_DumpTrace();
+    libSPI_ResetTrace();
+#endif
+
     event_t event = Event_New(EVENT_SLEEP);
     Event_Trigger(&event);
 
@@ -299,6 +399,10 @@ static void NotifyAndEnterSleep(void)
     event = Event_New(EVENT_WAKEUP);
     Event_Trigger(&event);
 
+    // The transceiver is idle after wake up, change channel before the
+    // next reading is sent.
+    UpdateChannel();
+
     RTC_GetCurrentTime(&time);
     INFO("Wake: %u:%u:%u", time.hour, time.minute, time.second);
 
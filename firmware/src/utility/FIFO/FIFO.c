@@ -1,7 +1,7 @@
 /**
  * @file   FIFO.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-10 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  FIFO-module.
  */
 
@@ -105,6 +105,39 @@ bool FIFO_Peek(const struct fifo_t *self_p, void *item_p)
     return false;
 }
 
+bool FIFO_Discard(struct fifo_t *self_p)
+{
+    sc_assert(self_p != NULL);
+
+    if (!FIFO_IsEmpty(self_p))
+    {
+        MoveTail(self_p);
+        return true;
+    }
+
+    return false;
+}
+
+void *FIFO_At(const struct fifo_t *self_p, uint8_t index)
+{
+    sc_assert(self_p != NULL);
+
+    if (index < self_p->number_of_elements)
+    {
+        const uint8_t position = (self_p->tail + index) % self_p->max_number_of_elements;
+        return self_p->data_p + ((size_t)position * (size_t)self_p->element_size);
+    }
+
+    return NULL;
+}
+
+uint8_t FIFO_Count(const struct fifo_t *self_p)
+{
+    sc_assert(self_p != NULL);
+
+    return self_p->number_of_elements;
+}
+
 bool FIFO_IsEmpty(const struct fifo_t *self_p)
 {
     sc_assert(self_p != NULL);
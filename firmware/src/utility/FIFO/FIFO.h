@@ -1,7 +1,7 @@
 /**
  * @file   FIFO.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  FIFO-module
  */
 
@@ -86,6 +86,36 @@ bool FIFO_Pop(struct fifo_t *self_p, void *item_p);
  */
 bool FIFO_Peek(const struct fifo_t *self_p, void *item_p);
 
+/**
+ * Remove the first item in the FIFO without copying it.
+ *
+ * @param fifo Pointer to FIFO.
+ *
+ * @return Status of discard. False if FIFO is empty, otherwise true.
+ */
+bool FIFO_Discard(struct fifo_t *self_p);
+
+/**
+ * Get a pointer to an item in the FIFO without removing it.
+ *
+ * The item can be modified in place through the returned pointer.
+ *
+ * @param fifo  Pointer to FIFO.
+ * @param index Position of the item, counted from the first(oldest) item.
+ *
+ * @return Pointer to item, NULL if there is no item at the index.
+ */
+void *FIFO_At(const struct fifo_t *self_p, uint8_t index);
+
+/**
+ * Get the number of items in the FIFO.
+ *
+ * @param fifo Pointer to FIFO.
+ *
+ * @return Number of items.
+ */
+uint8_t FIFO_Count(const struct fifo_t *self_p);
+
 /**
  * Check if FIFO is full.
  *
@@ -1,7 +1,7 @@
 /**
  * @file   Filter.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-02-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Implementation of an exponential moving average(EMA) filter.
  *
  * Detailed description of file.
@@ -47,6 +47,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
 
+static int16_t ProcessStage(const struct filter_stage_t *stage_p, int16_t sample);
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -85,6 +87,167 @@ bool Filter_IsInitialized(const struct filter_t *self_p)
     return self_p->alpha != 0;
 }
 
+void Filter_ShiftInit(struct filter_shift_t *self_p, int16_t initial_value, uint8_t shift)
+{
+    sc_assert(self_p != NULL);
+    sc_assert(shift <= FILTER_SHIFT_MAX);
+
+    /* The state is the output scaled by 2^shift to keep the fraction. */
+    self_p->state = (int32_t)initial_value << shift;
+    self_p->shift = shift;
+    self_p->initialized = true;
+}
+
+void Filter_ShiftProcess(struct filter_shift_t *self_p, int16_t sample)
+{
+    sc_assert(self_p != NULL);
+
+    /* state += (sample * 2^shift - state) / 2^shift, the rounding keeps the
+     * output from settling one below the input. */
+    self_p->state += sample - Filter_ShiftOutput(self_p);
+}
+
+int16_t Filter_ShiftOutput(const struct filter_shift_t *self_p)
+{
+    sc_assert(self_p != NULL);
+
+    const int32_t half = ((int32_t)1 << self_p->shift) >> 1;
+
+    return (int16_t)((self_p->state + half) >> self_p->shift);
+}
+
+bool Filter_ShiftIsInitialized(const struct filter_shift_t *self_p)
+{
+    sc_assert(self_p != NULL);
+
+    return self_p->initialized;
+}
+
+void Filter_MedianInit(struct filter_median_t *self_p, int16_t initial_value, uint8_t length)
+{
+    sc_assert(self_p != NULL);
+    sc_assert(length == 3 || length == 5);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        self_p->samples[i] = initial_value;
+    }
+
+    self_p->length = length;
+    self_p->index = 0;
+}
+
+void Filter_MedianProcess(struct filter_median_t *self_p, int16_t sample)
+{
+    sc_assert(self_p != NULL);
+
+    self_p->samples[self_p->index] = sample;
+    self_p->index = (self_p->index + 1 == self_p->length) ? 0 : self_p->index + 1;
+}
+
+int16_t Filter_MedianOutput(const struct filter_median_t *self_p)
+{
+    sc_assert(self_p != NULL);
+
+    int16_t sorted[FILTER_MEDIAN_MAX];
+
+    /* Insertion sort, at most ten compares for five samples. */
+    for (uint8_t i = 0; i < self_p->length; ++i)
+    {
+        const int16_t sample = self_p->samples[i];
+        uint8_t j = i;
+
+        while (j > 0 && sorted[j - 1] > sample)
+        {
+            sorted[j] = sorted[j - 1];
+            --j;
+        }
+
+        sorted[j] = sample;
+    }
+
+    return sorted[self_p->length / 2];
+}
+
+void Filter_AverageInit(struct filter_average_t *self_p,
+                        int16_t *samples_p,
+                        uint8_t shift,
+                        int16_t initial_value)
+{
+    sc_assert(self_p != NULL);
+    sc_assert(samples_p != NULL);
+    sc_assert(shift <= FILTER_SHIFT_MAX);
+
+    const uint16_t length = 1U << shift;
+
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        samples_p[i] = initial_value;
+    }
+
+    self_p->samples_p = samples_p;
+    self_p->sum = (int32_t)initial_value << shift;
+    self_p->shift = shift;
+    self_p->index = 0;
+}
+
+void Filter_AverageProcess(struct filter_average_t *self_p, int16_t sample)
+{
+    sc_assert(self_p != NULL);
+
+    const uint8_t mask = (uint8_t)((1U << self_p->shift) - 1);
+
+    self_p->sum += sample - self_p->samples_p[self_p->index];
+    self_p->samples_p[self_p->index] = sample;
+    self_p->index = (self_p->index + 1) & mask;
+}
+
+int16_t Filter_AverageOutput(const struct filter_average_t *self_p)
+{
+    sc_assert(self_p != NULL);
+
+    const int32_t half = ((int32_t)1 << self_p->shift) >> 1;
+
+    return (int16_t)((self_p->sum + half) >> self_p->shift);
+}
+
+int16_t Filter_CascadeProcess(const struct filter_stage_t *stages_p,
+                              size_t nr_stages,
+                              int16_t sample)
+{
+    sc_assert(stages_p != NULL);
+    sc_assert(nr_stages > 0);
+
+    for (size_t i = 0; i < nr_stages; ++i)
+    {
+        sample = ProcessStage(&stages_p[i], sample);
+    }
+
+    return sample;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
+
+static int16_t ProcessStage(const struct filter_stage_t *stage_p, int16_t sample)
+{
+    switch (stage_p->type)
+    {
+        case FILTER_STAGE_TYPE_SHIFT:
+            Filter_ShiftProcess(stage_p->shift_p, sample);
+            return Filter_ShiftOutput(stage_p->shift_p);
+
+        case FILTER_STAGE_TYPE_MEDIAN:
+            Filter_MedianProcess(stage_p->median_p, sample);
+            return Filter_MedianOutput(stage_p->median_p);
+
+        case FILTER_STAGE_TYPE_AVERAGE:
+            Filter_AverageProcess(stage_p->average_p, sample);
+            return Filter_AverageOutput(stage_p->average_p);
+
+        default:
+            sc_assert_fail();
+            return sample;
+    }
+}
@@ -1,8 +1,8 @@
 /**
  * @file   Filter.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-24 (Last edit)
- * @brief  Implementation of an exponential moving average(EMA) filter.
+ * @date   2026-10-18 (Last edit)
+ * @brief  Fixed-point filters for sensor samples.
  *
  * Detailed description of file.
  */
@@ -41,6 +41,17 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #define FILTER_ALPHA(a) ((uint16_t)((a) * UINT16_MAX))
 
+// Largest shift of the shift-based EMA, a smoothing factor of 1/256.
+#define FILTER_SHIFT_MAX 8
+
+// Largest window of the median filter.
+#define FILTER_MEDIAN_MAX 5
+
+// Stage initializers for a cascade, see `Filter_CascadeProcess()`.
+#define FILTER_STAGE_SHIFT(filter_p) {.type = FILTER_STAGE_TYPE_SHIFT, .shift_p = (filter_p)}
+#define FILTER_STAGE_MEDIAN(filter_p) {.type = FILTER_STAGE_TYPE_MEDIAN, .median_p = (filter_p)}
+#define FILTER_STAGE_AVERAGE(filter_p) {.type = FILTER_STAGE_TYPE_AVERAGE, .average_p = (filter_p)}
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -51,6 +62,46 @@ struct filter_t
     uint16_t alpha;
 };
 
+struct filter_shift_t
+{
+    int32_t state;
+    uint8_t shift;
+    bool initialized;
+};
+
+struct filter_median_t
+{
+    int16_t samples[FILTER_MEDIAN_MAX];
+    uint8_t length;
+    uint8_t index;
+};
+
+struct filter_average_t
+{
+    int16_t *samples_p;
+    int32_t sum;
+    uint8_t shift;
+    uint8_t index;
+};
+
+enum filter_stage_type_t
+{
+    FILTER_STAGE_TYPE_SHIFT,
+    FILTER_STAGE_TYPE_MEDIAN,
+    FILTER_STAGE_TYPE_AVERAGE
+};
+
+struct filter_stage_t
+{
+    enum filter_stage_type_t type;
+    union
+    {
+        struct filter_shift_t *shift_p;
+        struct filter_median_t *median_p;
+        struct filter_average_t *average_p;
+    };
+};
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -92,4 +143,113 @@ int16_t Filter_Output(const struct filter_t *self_p);
  */
 bool Filter_IsInitialized(const struct filter_t *self_p);
 
+/**
+ * Initialize an EMA filter with a smoothing factor of 1/2^shift. Samples are
+ * processed with additions and shifts only.
+ *
+ * @param self_p        Pointer to filter struct.
+ * @param initial_value Initial value of the filter, e.g. the first sample.
+ * @param shift         Smoothing factor exponent, 0 to `FILTER_SHIFT_MAX`.
+ */
+void Filter_ShiftInit(struct filter_shift_t *self_p, int16_t initial_value, uint8_t shift);
+
+/**
+ * Process the supplied sample.
+ *
+ * @param self_p Pointer to filter struct.
+ * @param sample Sample to process.
+ */
+void Filter_ShiftProcess(struct filter_shift_t *self_p, int16_t sample);
+
+/**
+ * Get the filter output value, rounded to nearest.
+ *
+ * @param self_p Pointer to filter struct.
+ *
+ * @return The filter output value.
+ */
+int16_t Filter_ShiftOutput(const struct filter_shift_t *self_p);
+
+/**
+ * Check if the supplied filter is initialized.
+ *
+ * @param self_p Pointer to filter struct.
+ *
+ * @return True if initialized, otherwise false.
+ */
+bool Filter_ShiftIsInitialized(const struct filter_shift_t *self_p);
+
+/**
+ * Initialize a median filter. The output ignores single sample spikes with
+ * a window of three and spikes of up to two samples with a window of five.
+ *
+ * @param self_p        Pointer to filter struct.
+ * @param initial_value Value the window is filled with.
+ * @param length        Window length, 3 or 5.
+ */
+void Filter_MedianInit(struct filter_median_t *self_p, int16_t initial_value, uint8_t length);
+
+/**
+ * Replace the oldest sample in the window with the supplied sample.
+ *
+ * @param self_p Pointer to filter struct.
+ * @param sample Sample to process.
+ */
+void Filter_MedianProcess(struct filter_median_t *self_p, int16_t sample);
+
+/**
+ * Get the median of the samples in the window.
+ *
+ * @param self_p Pointer to filter struct.
+ *
+ * @return The filter output value.
+ */
+int16_t Filter_MedianOutput(const struct filter_median_t *self_p);
+
+/**
+ * Initialize a moving average filter. The sum of the window is kept up to
+ * date so each sample costs one addition and one subtraction.
+ *
+ * @param self_p        Pointer to filter struct.
+ * @param samples_p     Window buffer of 2^shift samples.
+ * @param shift         Window length exponent, 0 to `FILTER_SHIFT_MAX`.
+ * @param initial_value Value the window is filled with.
+ */
+void Filter_AverageInit(struct filter_average_t *self_p,
+                        int16_t *samples_p,
+                        uint8_t shift,
+                        int16_t initial_value);
+
+/**
+ * Replace the oldest sample in the window with the supplied sample.
+ *
+ * @param self_p Pointer to filter struct.
+ * @param sample Sample to process.
+ */
+void Filter_AverageProcess(struct filter_average_t *self_p, int16_t sample);
+
+/**
+ * Get the mean of the samples in the window, rounded to nearest.
+ *
+ * @param self_p Pointer to filter struct.
+ *
+ * @return The filter output value.
+ */
+int16_t Filter_AverageOutput(const struct filter_average_t *self_p);
+
+/**
+ * Run a sample through a cascade of initialized filters, the output of each
+ * stage is the input of the next. The stages are typically a const array
+ * built with the `FILTER_STAGE_*()` initializers.
+ *
+ * @param stages_p  Pointer to the first stage.
+ * @param nr_stages Number of stages.
+ * @param sample    Sample to process.
+ *
+ * @return The output of the last stage.
+ */
+int16_t Filter_CascadeProcess(const struct filter_stage_t *stages_p,
+                              size_t nr_stages,
+                              int16_t sample);
+
 #endif
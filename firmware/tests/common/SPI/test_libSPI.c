@@ -0,0 +1,425 @@
+/**
+ * @file   test_libSPI.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Test suite for the SPI driver.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include "libSPI.h"
+#include "driverTimer.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+struct trace_t
+{
+    unsigned int transactions;
+    uint32_t bytes;
+    uint32_t busy_us;
+    uint32_t longest_us;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+volatile uint8_t SREG;
+volatile uint8_t DDRB;
+volatile uint8_t SPCR;
+volatile uint8_t SPSR;
+volatile uint8_t SPDR;
+
+static uint8_t nr_selects;
+static uint8_t nr_deselects;
+static struct libSPI_transaction_t *chained_p;
+static uint32_t ticks;
+static struct trace_t trace[LIBSPI_TRACE_NR_IDS];
+
+static const struct libSPI_profile_t rtc_profile =
+{
+    .mode = 0,
+    .clock_divider = LIBSPI_CLOCK_DIV_4,
+    .trace_id = LIBSPI_TRACE_ID_RTC
+};
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+void SPI_STC_vect(void);
+
+static void Select(void)
+{
+    ++nr_selects;
+}
+
+static void Deselect(void)
+{
+    ++nr_deselects;
+}
+
+static void SelectRTC(void)
+{
+    ++nr_selects;
+    libSPI_SetProfile(&rtc_profile);
+}
+
+static void SubmitChained(struct libSPI_transaction_t *transaction_p)
+{
+    assert_true(transaction_p->done);
+    libSPI_Submit(chained_p);
+}
+
+/**
+ * Let the device answer the byte written to SPDR, returns the written byte.
+ */
+static uint8_t ClockByte(uint8_t data)
+{
+    const uint8_t written = SPDR;
+
+    assert_true(SPCR & (1 << SPIE));
+
+    SPDR = data;
+    SPSR |= (1 << SPIF);
+    SPI_STC_vect();
+
+    return written;
+}
+
+/**
+ * Record the counters printed by libSPI_DumpTrace().
+ */
+void libDebug_Print_P(const char *text, ...)
+{
+    const char prefix[] = "<INFO> SPI[";
+
+    if (strncmp(text, prefix, sizeof(prefix) - 1) == 0)
+    {
+        va_list args;
+        unsigned int id;
+
+        va_start(args, text);
+        id = va_arg(args, unsigned int);
+        assert_in_range(id, 0, LIBSPI_TRACE_NR_IDS - 1);
+        trace[id].transactions = va_arg(args, unsigned int);
+        trace[id].bytes = va_arg(args, uint32_t);
+        trace[id].busy_us = va_arg(args, uint32_t);
+        trace[id].longest_us = va_arg(args, uint32_t);
+        va_end(args);
+    }
+}
+
+uint32_t driverTimer_GetTicks(void)
+{
+    return ticks;
+}
+
+static int Setup(void **state)
+{
+    SREG = (1 << SREG_I);
+    SPSR = 0;
+    SPDR = 0;
+
+    nr_selects = 0;
+    nr_deselects = 0;
+    chained_p = NULL;
+    ticks = 0;
+    memset(trace, 0, sizeof(trace));
+
+    libSPI_Init(0);
+
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//TESTS
+//////////////////////////////////////////////////////////////////////////
+
+static void test_libSPI_Submit_NULL(void **state)
+{
+    expect_assert_failure(libSPI_Submit(NULL));
+}
+
+static void test_libSPI_Submit(void **state)
+{
+    const uint8_t tx[] = {0x01, 0x02};
+    uint8_t rx[2] = {0};
+    struct libSPI_transaction_t transaction =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .tx_p = tx,
+        .rx_p = rx,
+        .length = sizeof(tx)
+    };
+
+    libSPI_Submit(&transaction);
+    assert_int_equal(nr_selects, 1);
+    assert_false(libSPI_IsDone(&transaction));
+
+    assert_int_equal(ClockByte(0xA1), 0x01);
+    assert_false(libSPI_IsDone(&transaction));
+
+    assert_int_equal(ClockByte(0xA2), 0x02);
+    assert_true(libSPI_IsDone(&transaction));
+
+    assert_int_equal(rx[0], 0xA1);
+    assert_int_equal(rx[1], 0xA2);
+    assert_int_equal(nr_selects, 1);
+    assert_int_equal(nr_deselects, 1);
+    assert_false(SPCR & (1 << SPIE));
+}
+
+static void test_libSPI_Submit_Queued(void **state)
+{
+    const uint8_t tx_first[] = {0x01};
+    const uint8_t tx_second[] = {0x02};
+    struct libSPI_transaction_t first =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .tx_p = tx_first,
+        .length = sizeof(tx_first)
+    };
+    struct libSPI_transaction_t second =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .tx_p = tx_second,
+        .length = sizeof(tx_second)
+    };
+
+    libSPI_Submit(&first);
+    libSPI_Submit(&second);
+    assert_int_equal(nr_selects, 1);
+
+    assert_int_equal(ClockByte(0x00), 0x01);
+    assert_true(libSPI_IsDone(&first));
+    assert_false(libSPI_IsDone(&second));
+    assert_int_equal(nr_selects, 2);
+    assert_int_equal(nr_deselects, 1);
+
+    assert_int_equal(ClockByte(0x00), 0x02);
+    assert_true(libSPI_IsDone(&second));
+    assert_int_equal(nr_deselects, 2);
+    assert_false(SPCR & (1 << SPIE));
+}
+
+static void test_libSPI_Submit_FromCompleteCallback(void **state)
+{
+    const uint8_t tx_first[] = {0x01};
+    const uint8_t tx_second[] = {0x02, 0x03};
+    uint8_t rx[2] = {0};
+    struct libSPI_transaction_t first =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .complete_callback = SubmitChained,
+        .tx_p = tx_first,
+        .length = sizeof(tx_first)
+    };
+    struct libSPI_transaction_t second =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .tx_p = tx_second,
+        .rx_p = rx,
+        .length = sizeof(tx_second)
+    };
+
+    chained_p = &second;
+    libSPI_Submit(&first);
+
+    /* The chained transaction must be started exactly once. */
+    assert_int_equal(ClockByte(0x00), 0x01);
+    assert_true(libSPI_IsDone(&first));
+    assert_int_equal(nr_selects, 2);
+
+    assert_int_equal(ClockByte(0xB1), 0x02);
+    assert_int_equal(ClockByte(0xB2), 0x03);
+    assert_true(libSPI_IsDone(&second));
+
+    assert_int_equal(rx[0], 0xB1);
+    assert_int_equal(rx[1], 0xB2);
+    assert_int_equal(nr_selects, 2);
+    assert_int_equal(nr_deselects, 2);
+}
+
+static void test_libSPI_Submit_ZeroLength(void **state)
+{
+    const uint8_t tx_second[] = {0x02};
+    struct libSPI_transaction_t first =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .complete_callback = SubmitChained,
+        .length = 0
+    };
+    struct libSPI_transaction_t second =
+    {
+        .pre_callback = Select,
+        .post_callback = Deselect,
+        .tx_p = tx_second,
+        .length = sizeof(tx_second)
+    };
+
+    chained_p = &second;
+    libSPI_Submit(&first);
+
+    assert_true(libSPI_IsDone(&first));
+    assert_false(libSPI_IsDone(&second));
+    assert_int_equal(nr_selects, 2);
+    assert_int_equal(nr_deselects, 1);
+
+    assert_int_equal(ClockByte(0x00), 0x02);
+    assert_true(libSPI_IsDone(&second));
+    assert_int_equal(nr_selects, 2);
+    assert_int_equal(nr_deselects, 2);
+}
+
+static void test_libSPI_Wait_InterruptsDisabled(void **state)
+{
+    const uint8_t tx[] = {0x01, 0x02, 0x03};
+    uint8_t rx[3] = {0};
+    struct libSPI_transaction_t transaction =
+    {
+        .tx_p = tx,
+        .rx_p = rx,
+        .length = sizeof(tx)
+    };
+
+    /* Loopback, the device answers with the written byte. */
+    SREG = 0;
+    SPSR = (1 << SPIF);
+
+    libSPI_Submit(&transaction);
+    libSPI_Wait(&transaction);
+
+    assert_true(libSPI_IsDone(&transaction));
+    assert_memory_equal(rx, tx, sizeof(tx));
+}
+
+static void test_libSPI_Read_Polled(void **state)
+{
+    uint8_t rx[2] = {0xFF, 0xFF};
+
+    SPSR = (1 << SPIF);
+
+    libSPI_Read(rx, sizeof(rx), Select, Deselect);
+
+    assert_int_equal(rx[0], 0x00);
+    assert_int_equal(rx[1], 0x00);
+    assert_int_equal(nr_selects, 1);
+    assert_int_equal(nr_deselects, 1);
+    assert_false(SPCR & (1 << SPIE));
+}
+
+/**
+ * Expect a chip select split into several calls to be traced as one
+ * transaction to the device selected in the first call.
+ */
+static void test_libSPI_Trace_MultipleCalls(void **state)
+{
+    uint8_t data;
+    uint8_t buffer[4];
+
+    SPSR = (1 << SPIF);
+
+    ticks = 100;
+    libSPI_WriteByte(0x81, SelectRTC, NULL);
+    ticks = 110;
+    libSPI_ReadByte(&data, NULL, NULL);
+    ticks = 120;
+    libSPI_Read(buffer, sizeof(buffer), NULL, Deselect);
+
+    ticks = 200;
+    libSPI_WriteByte(0x01, SelectRTC, Deselect);
+
+    /* Expect devices without a profile to be traced as unknown. */
+    ticks = 210;
+    libSPI_WriteByte(0x02, Select, NULL);
+    ticks = 215;
+    libSPI_ReadByte(&data, NULL, Deselect);
+
+    libSPI_DumpTrace();
+
+    assert_int_equal(nr_selects, 3);
+    assert_int_equal(nr_deselects, 3);
+
+    assert_int_equal(trace[LIBSPI_TRACE_ID_RTC].transactions, 2);
+    assert_int_equal(trace[LIBSPI_TRACE_ID_RTC].bytes, 7);
+    assert_int_equal(trace[LIBSPI_TRACE_ID_RTC].busy_us, 20 * DRIVERTIMER_TICK_US);
+    assert_int_equal(trace[LIBSPI_TRACE_ID_RTC].longest_us, 20 * DRIVERTIMER_TICK_US);
+
+    assert_int_equal(trace[LIBSPI_TRACE_ID_UNKNOWN].transactions, 1);
+    assert_int_equal(trace[LIBSPI_TRACE_ID_UNKNOWN].bytes, 2);
+    assert_int_equal(trace[LIBSPI_TRACE_ID_UNKNOWN].busy_us, 5 * DRIVERTIMER_TICK_US);
+}
+
+static void test_libSPI_Interrupt_Idle(void **state)
+{
+    expect_assert_failure(SPI_STC_vect());
+}
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test_setup(test_libSPI_Submit_NULL, Setup),
+        cmocka_unit_test_setup(test_libSPI_Submit, Setup),
+        cmocka_unit_test_setup(test_libSPI_Submit_Queued, Setup),
+        cmocka_unit_test_setup(test_libSPI_Submit_FromCompleteCallback, Setup),
+        cmocka_unit_test_setup(test_libSPI_Submit_ZeroLength, Setup),
+        cmocka_unit_test_setup(test_libSPI_Wait_InterruptsDisabled, Setup),
+        cmocka_unit_test_setup(test_libSPI_Read_Polled, Setup),
+        cmocka_unit_test_setup(test_libSPI_Trace_MultipleCalls, Setup),
+        cmocka_unit_test_setup(test_libSPI_Interrupt_Idle, Setup),
+    };
+
+    if (argc >= 2)
+    {
+        cmocka_set_test_filter(argv[1]);
+    }
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
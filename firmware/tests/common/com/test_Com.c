@@ -1,7 +1,7 @@
 /**
  * @file   test_Com.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-24 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Communications module.
  */
 
@@ -221,6 +221,7 @@ static void test_Com_Send_RTCFailure(void **state)
     will_return(__wrap_Transceiver_SendPacket, &packet_content);
     will_return(__wrap_Transceiver_SendPacket, true);
     expect_value(__wrap_Transceiver_SendPacket, target, target);
+    expect_value(__wrap_Transceiver_SendPacket, priority, TR_PRIORITY_HIGH);
     expect_value(__wrap_ErrorHandler_LogError, code, RTC_FAIL);
 
     Com_Send(target, packet_type, &fake_data, sizeof(fake_data));
@@ -247,6 +248,7 @@ static void test_Com_Send_SendFailure(void **state)
     will_return(__wrap_Transceiver_SendPacket, &packet_content);
     will_return(__wrap_Transceiver_SendPacket, false);
     expect_value(__wrap_Transceiver_SendPacket, target, target);
+    expect_value(__wrap_Transceiver_SendPacket, priority, TR_PRIORITY_HIGH);
 
     Com_Send(target, packet_type, &fake_data, sizeof(fake_data));
 }
@@ -254,7 +256,7 @@ static void test_Com_Send_SendFailure(void **state)
 static void test_Com_Send(void **state)
 {
     const uint8_t target = 2;
-    const uint8_t packet_type = 3;
+    const uint8_t packet_type = COM_PACKET_TYPE_READING;
     const uint8_t fake_data[4] = {0xAA, 0xFF, 0x00, 0xBB};
     packet_content_type packet_content;
 
@@ -262,6 +264,7 @@ static void test_Com_Send(void **state)
     will_return(__wrap_Transceiver_SendPacket, &packet_content);
     will_return(__wrap_Transceiver_SendPacket, true);
     expect_value(__wrap_Transceiver_SendPacket, target, target);
+    expect_value(__wrap_Transceiver_SendPacket, priority, TR_PRIORITY_NORMAL);
 
     Com_Send(target, packet_type, fake_data, sizeof(fake_data));
 
@@ -272,6 +275,35 @@ static void test_Com_Send(void **state)
     /* TODO: Verify timestamp. */
 }
 
+static void test_Com_Send_Priority(void **state)
+{
+    const uint8_t target = 2;
+    const uint8_t fake_data = 0xAA;
+    const struct
+    {
+        uint8_t packet_type;
+        transceiver_priority_type priority;
+    } expected[] =
+    {
+        {COM_PACKET_TYPE_ACK, TR_PRIORITY_HIGH},
+        {COM_PACKET_TYPE_DATA, TR_PRIORITY_NORMAL},
+        {COM_PACKET_TYPE_READING, TR_PRIORITY_NORMAL},
+        {COM_PACKET_TYPE_TIME, TR_PRIORITY_HIGH},
+        {COM_PACKET_TYPE_CHANNEL, TR_PRIORITY_HIGH}
+    };
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i)
+    {
+        will_return(__wrap_RTC_GetCurrentTime, true);
+        will_return(__wrap_Transceiver_SendPacket, NULL);
+        will_return(__wrap_Transceiver_SendPacket, true);
+        expect_value(__wrap_Transceiver_SendPacket, target, target);
+        expect_value(__wrap_Transceiver_SendPacket, priority, expected[i].priority);
+
+        Com_Send(target, expected[i].packet_type, &fake_data, sizeof(fake_data));
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -290,6 +322,7 @@ int main(int argc, char *argv[])
         cmocka_unit_test_setup(test_Com_Send_RTCFailure, Setup),
         cmocka_unit_test_setup(test_Com_Send_SendFailure, Setup),
         cmocka_unit_test_setup(test_Com_Send, Setup),
+        cmocka_unit_test_setup(test_Com_Send_Priority, Setup),
     };
 
     if (argc >= 2)
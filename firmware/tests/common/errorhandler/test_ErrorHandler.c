@@ -1,7 +1,7 @@
 /**
  * @file   test_ErrorHandler.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-20 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the error handler module.
  */
 
@@ -128,6 +128,7 @@ static void log_errors(size_t number_of_errors, uint8_t code_offset, uint8_t inf
     for (size_t i = 0; i < number_of_errors; ++i)
     {
         will_return(__wrap_RTC_GetTimeStamp, true);
+        will_return(__wrap_RTC_GetTimeStamp, 0);
         ErrorHandler_LogError(code_offset + i, information_offset + i);
     }
 }
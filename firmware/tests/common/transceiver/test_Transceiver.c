@@ -1,7 +1,7 @@
 /**
  * @file   test_Transceiver.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Transceiver interface.
  */
 
@@ -56,6 +56,7 @@ static void PrepareTransceiverInitMocks(void)
 {
     expect_any(__wrap_libRFM69_SetMode, mode);
     expect_function_call(__wrap_libRFM69_ClearFIFO);
+    expect_value(__wrap_libRFM69_SetCarrierFrequency, frequency, 868000000);
     will_return(__wrap_Config_GetNetworkId, &network_id);
     will_return(__wrap_Config_GetAddress, 1);
     will_return(__wrap_Config_GetBroadcastAddress, 255);
@@ -124,9 +125,10 @@ static void test_Transceiver_SendPacket_InvalidArguments(void **state)
 {
     const packet_content_type packet;
 
-    expect_assert_failure(Transceiver_SendPacket(0, NULL));
-    expect_assert_failure(Transceiver_SendPacket(1, NULL));
-    expect_assert_failure(Transceiver_SendPacket(0, &packet));
+    expect_assert_failure(Transceiver_SendPacket(0, NULL, TR_PRIORITY_NORMAL));
+    expect_assert_failure(Transceiver_SendPacket(1, NULL, TR_PRIORITY_NORMAL));
+    expect_assert_failure(Transceiver_SendPacket(0, &packet, TR_PRIORITY_NORMAL));
+    expect_assert_failure(Transceiver_SendPacket(1, &packet, TR_NR_PRIORITIES));
 }
 
 static void test_Transceiver_SendPacket_InvalidSize(void **state)
@@ -135,7 +137,7 @@ static void test_Transceiver_SendPacket_InvalidSize(void **state)
     const packet_content_type packet = {.size = sizeof(packet.data) + 1};
 
     will_return_maybe(__wrap_FIFO_IsFull, false);
-    assert_false(Transceiver_SendPacket(target, &packet));
+    assert_false(Transceiver_SendPacket(target, &packet, TR_PRIORITY_NORMAL));
 }
 
 static void test_Transceiver_SendPacket_FullFIFO(void **state)
@@ -143,8 +145,33 @@ static void test_Transceiver_SendPacket_FullFIFO(void **state)
     const uint8_t target = 1;
     const packet_content_type packet = {0};
 
+    will_return(__wrap_Config_GetAddress, 2);
     will_return(__wrap_FIFO_IsFull, true);
-    assert_false(Transceiver_SendPacket(target, &packet));
+    will_return_always(__wrap_FIFO_Count, 3);
+    assert_false(Transceiver_SendPacket(target, &packet, TR_PRIORITY_NORMAL));
+
+    struct transceiver_statistics_t statistics;
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].dropped, 1);
+    assert_int_equal(statistics.tx[TR_PRIORITY_HIGH].dropped, 0);
+}
+
+static void test_Transceiver_SendPacket_FullHighPriorityFIFO(void **state)
+{
+    const uint8_t target = 1;
+    const packet_content_type packet = {0};
+
+    will_return(__wrap_Config_GetAddress, 2);
+    will_return(__wrap_FIFO_IsFull, true);
+    will_return(__wrap_FIFO_Count, 3);
+    assert_false(Transceiver_SendPacket(target, &packet, TR_PRIORITY_HIGH));
+
+    struct transceiver_statistics_t statistics;
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.tx[TR_PRIORITY_HIGH].dropped, 1);
+    assert_int_equal(statistics.tx[TR_PRIORITY_HIGH].high_water_mark, 3);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].dropped, 0);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].high_water_mark, 0);
 }
 
 static void test_Transceiver_SendPacket(void **state)
@@ -156,8 +183,184 @@ static void test_Transceiver_SendPacket(void **state)
     will_return(__wrap_FIFO_IsFull, false);
     will_return(__wrap_Config_GetAddress, address);
     will_return(__wrap_FIFO_Push, true);
+    will_return_always(__wrap_FIFO_Count, 1);
+
+    assert_true(Transceiver_SendPacket(target, &packet, TR_PRIORITY_NORMAL));
+}
+
+static void test_Transceiver_SendPacket_DropOldest(void **state)
+{
+    const uint8_t target = 1;
+    const packet_content_type packet = {0};
+
+    Transceiver_SetOverflowPolicy(TR_OVERFLOW_DROP_OLDEST);
+
+    will_return(__wrap_Config_GetAddress, 2);
+    will_return(__wrap_FIFO_IsFull, true);
+    will_return(__wrap_FIFO_Discard, true);
+    will_return(__wrap_FIFO_Push, true);
+    will_return_always(__wrap_FIFO_Count, 3);
+    assert_true(Transceiver_SendPacket(target, &packet, TR_PRIORITY_NORMAL));
+
+    struct transceiver_statistics_t statistics;
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].dropped, 1);
+}
+
+static void test_Transceiver_SendPacket_ReplaceSameRoute(void **state)
+{
+    const uint8_t address = 2;
+    const packet_content_type packet = {.type = 0xAA, .size = 1, .data = {0xBB}};
+    packet_frame_type queued_packets[2] =
+    {
+        {.header = {.target = 3, .source = address}},
+        {.header = {.target = 1, .source = address}}
+    };
+
+    Transceiver_SetOverflowPolicy(TR_OVERFLOW_REPLACE_SAME_ROUTE);
+
+    will_return(__wrap_Config_GetAddress, address);
+    will_return(__wrap_FIFO_IsFull, true);
+    will_return(__wrap_FIFO_At, &queued_packets[0]);
+    will_return(__wrap_FIFO_At, &queued_packets[1]);
+    will_return_always(__wrap_FIFO_Count, 3);
+    assert_true(Transceiver_SendPacket(1, &packet, TR_PRIORITY_NORMAL));
+
+    /* Only the packet with the same route should be replaced. */
+    assert_int_equal(queued_packets[0].content.type, 0);
+    assert_int_equal(queued_packets[1].content.type, packet.type);
+    assert_int_equal(queued_packets[1].content.data[0], packet.data[0]);
+}
+
+static void test_Transceiver_SendPacket_ReplaceSameRouteNoMatch(void **state)
+{
+    const uint8_t address = 2;
+    const packet_content_type packet = {0};
+    packet_frame_type queued_packet = {.header = {.target = 3, .source = address}};
+
+    Transceiver_SetOverflowPolicy(TR_OVERFLOW_REPLACE_SAME_ROUTE);
+
+    will_return(__wrap_Config_GetAddress, address);
+    will_return(__wrap_FIFO_IsFull, true);
+    will_return(__wrap_FIFO_At, &queued_packet);
+    will_return(__wrap_FIFO_At, NULL);
+    will_return_always(__wrap_FIFO_Count, 3);
+    assert_false(Transceiver_SendPacket(1, &packet, TR_PRIORITY_NORMAL));
+}
+
+static void test_Transceiver_SetOverflowPolicy_Invalid(void **state)
+{
+    expect_assert_failure(Transceiver_SetOverflowPolicy(TR_OVERFLOW_REPLACE_SAME_ROUTE + 1));
+}
+
+static void test_Transceiver_GetStatistics_NULL(void **state)
+{
+    expect_assert_failure(Transceiver_GetStatistics(NULL));
+}
+
+static void test_Transceiver_GetStatistics_HighWaterMark(void **state)
+{
+    const packet_content_type packet = {0};
+    struct transceiver_statistics_t statistics;
+
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].high_water_mark, 0);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].dropped, 0);
+
+    /* Three normal priority packets queued. */
+    will_return(__wrap_Config_GetAddress, 2);
+    will_return(__wrap_FIFO_IsFull, false);
+    will_return(__wrap_FIFO_Push, true);
+    will_return(__wrap_FIFO_Count, 3);
+    Transceiver_SendPacket(1, &packet, TR_PRIORITY_NORMAL);
+
+    /* The high water mark should not decrease when the queue is drained. */
+    will_return(__wrap_Config_GetAddress, 2);
+    will_return(__wrap_FIFO_IsFull, false);
+    will_return(__wrap_FIFO_Push, true);
+    will_return(__wrap_FIFO_Count, 1);
+    Transceiver_SendPacket(1, &packet, TR_PRIORITY_NORMAL);
+
+    /* The high priority queue is accounted separately. */
+    will_return(__wrap_Config_GetAddress, 2);
+    will_return(__wrap_FIFO_IsFull, false);
+    will_return(__wrap_FIFO_Push, true);
+    will_return(__wrap_FIFO_Count, 1);
+    Transceiver_SendPacket(1, &packet, TR_PRIORITY_HIGH);
 
-    assert_true(Transceiver_SendPacket(target, &packet));
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].high_water_mark, 3);
+    assert_int_equal(statistics.tx[TR_PRIORITY_HIGH].high_water_mark, 1);
+
+    Transceiver_ResetStatistics();
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.tx[TR_PRIORITY_NORMAL].high_water_mark, 0);
+    assert_int_equal(statistics.tx[TR_PRIORITY_HIGH].high_water_mark, 0);
+}
+
+static void test_Transceiver_SetChannel_Invalid(void **state)
+{
+    expect_assert_failure(Transceiver_SetChannel(TR_NR_CHANNELS));
+}
+
+static void test_Transceiver_SetChannel_Active(void **state)
+{
+    PrepareSendingState();
+
+    assert_false(Transceiver_SetChannel(2));
+    assert_int_equal(Transceiver_GetChannel(), TR_RENDEZVOUS_CHANNEL);
+}
+
+static void test_Transceiver_SetChannel(void **state)
+{
+    assert_int_equal(Transceiver_GetChannel(), TR_RENDEZVOUS_CHANNEL);
+
+    will_return(__wrap_libRFM69_IsPayloadReady, false);
+    will_return_count(__wrap_FIFO_IsEmpty, true, 2);
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_STANDBY);
+    expect_value(__wrap_libRFM69_SetCarrierFrequency, frequency, 868200000);
+
+    assert_true(Transceiver_SetChannel(2));
+    assert_int_equal(Transceiver_GetChannel(), 2);
+
+    /* The receiver should be restarted on the new channel. */
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_RECEIVER);
+    Transceiver_Update();
+}
+
+static void test_Transceiver_MeasureRSSI_InvalidArguments(void **state)
+{
+    int8_t rssi;
+
+    expect_assert_failure(Transceiver_MeasureRSSI(TR_NR_CHANNELS, &rssi));
+    expect_assert_failure(Transceiver_MeasureRSSI(0, NULL));
+}
+
+static void test_Transceiver_MeasureRSSI_Active(void **state)
+{
+    int8_t rssi;
+
+    PrepareSendingState();
+
+    assert_false(Transceiver_MeasureRSSI(1, &rssi));
+}
+
+static void test_Transceiver_MeasureRSSI(void **state)
+{
+    int8_t rssi;
+
+    will_return(__wrap_libRFM69_IsPayloadReady, false);
+    will_return_count(__wrap_FIFO_IsEmpty, true, 2);
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_STANDBY);
+    expect_value(__wrap_libRFM69_SetCarrierFrequency, frequency, 868500000);
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_RECEIVER);
+    will_return(__wrap_libRFM69_GetRSSI, -97);
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_STANDBY);
+    expect_value(__wrap_libRFM69_SetCarrierFrequency, frequency, 868000000);
+
+    assert_true(Transceiver_MeasureRSSI(5, &rssi));
+    assert_int_equal(rssi, -97);
+    assert_int_equal(Transceiver_GetChannel(), TR_RENDEZVOUS_CHANNEL);
 }
 
 static void test_Transceiver_EventHandler_NULL(void **state)
@@ -219,7 +422,7 @@ static void test_Transceiver_Update_Listening(void **state)
 
     will_return(__wrap_libRFM69_IsPayloadReady, false);
     will_return(__wrap_libRFM69_IsRxTimeoutFlagSet, false);
-    will_return(__wrap_FIFO_IsEmpty, true);
+    will_return_count(__wrap_FIFO_IsEmpty, true, 2);
     Transceiver_Update();
 }
 
@@ -243,7 +446,9 @@ static void test_Transceiver_Update_PayloadReady(void **state)
     will_return(__wrap_libRFM69_ReadFromFIFO, mock_packet.header.total_size);
 
     will_return(__wrap_libRFM69_GetRSSI, -10);
+    will_return(__wrap_FIFO_IsFull, false);
     will_return(__wrap_FIFO_Push, true);
+    will_return(__wrap_FIFO_Count, 1);
 
     Transceiver_Update();
 }
@@ -268,7 +473,30 @@ static void test_Transceiver_Update_PayloadReadyInvalidSize(void **state)
 
 static void test_Transceiver_Update_PayloadReadyFullFIFO(void **state)
 {
-    skip();
+    packet_frame_type mock_packet;
+    mock_packet.header.total_size = 10;
+
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_RECEIVER);
+    Transceiver_Update();
+
+    will_return(__wrap_libRFM69_IsPayloadReady, true);
+    expect_value(__wrap_libRFM69_SetMode, mode, RFM_STANDBY);
+    will_return(__wrap_libRFM69_ReadFromFIFO, (uint8_t *)&mock_packet);
+    will_return(__wrap_libRFM69_ReadFromFIFO, 1);
+    will_return(__wrap_libRFM69_ReadFromFIFO, (uint8_t *)&mock_packet);
+    will_return(__wrap_libRFM69_ReadFromFIFO, mock_packet.header.total_size);
+    will_return(__wrap_libRFM69_GetRSSI, -10);
+
+    /* The packet is dropped with the default overflow policy. */
+    will_return(__wrap_FIFO_IsFull, true);
+    will_return(__wrap_FIFO_Count, 4);
+
+    Transceiver_Update();
+
+    struct transceiver_statistics_t statistics;
+    Transceiver_GetStatistics(&statistics);
+    assert_int_equal(statistics.rx.dropped, 1);
+    assert_int_equal(statistics.rx.high_water_mark, 4);
 }
 
 static void test_Transceiver_Update_RxTimeout(void **state)
@@ -324,7 +552,7 @@ static void test_Transceiver_Update_SendingNoPacket(void **state)
     Transceiver_Update();
 
     will_return(__wrap_libRFM69_IsModeReady, true);
-    will_return(__wrap_FIFO_Pop, false);
+    will_return_count(__wrap_FIFO_Pop, false, 2);
     Transceiver_Update();
 
     /**
@@ -382,6 +610,19 @@ int main(int argc, char *argv[])
         cmocka_unit_test_setup(test_Transceiver_SendPacket_InvalidSize, Setup),
         cmocka_unit_test_setup(test_Transceiver_SendPacket_FullFIFO, Setup),
         cmocka_unit_test_setup(test_Transceiver_SendPacket, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SendPacket_FullHighPriorityFIFO, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SendPacket_DropOldest, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SendPacket_ReplaceSameRoute, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SendPacket_ReplaceSameRouteNoMatch, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SetOverflowPolicy_Invalid, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SetChannel_Invalid, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SetChannel_Active, Setup),
+        cmocka_unit_test_setup(test_Transceiver_SetChannel, Setup),
+        cmocka_unit_test_setup(test_Transceiver_MeasureRSSI_InvalidArguments, Setup),
+        cmocka_unit_test_setup(test_Transceiver_MeasureRSSI_Active, Setup),
+        cmocka_unit_test_setup(test_Transceiver_MeasureRSSI, Setup),
+        cmocka_unit_test_setup(test_Transceiver_GetStatistics_NULL, Setup),
+        cmocka_unit_test_setup(test_Transceiver_GetStatistics_HighWaterMark, Setup),
         cmocka_unit_test_setup(test_Transceiver_EventHandler_NULL, Setup),
         cmocka_unit_test_setup(test_Transceiver_EventHandler_Sleep, Setup),
         cmocka_unit_test_setup(test_Transceiver_EventHandler_SleepWhenActive, Setup),
@@ -0,0 +1,305 @@
+/**
+ * @file   test_Channel.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Test suite for the channel selection module.
+ */
+
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "Channel.h"
+#include "Com.h"
+#include "Transceiver.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define SURVEY_INTERVAL_MS  (10UL * 60UL * 1000UL)
+#define SURVEY_SAMPLES      4
+#define REPORT_INTERVAL     60
+#define SWITCH_DELAY        (3 * REPORT_INTERVAL)
+#define SWITCH_POLL_INTERVAL_MS 1000
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+static const int8_t quiet_peaks[TR_NR_CHANNELS] = {-100, -98, -101, -97, -99, -100};
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//INTERUPT SERVICE ROUTINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+static int Setup(void **state)
+{
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    Channel_Init();
+
+    return 0;
+}
+
+static void PrepareSurveyChannel(uint8_t channel, int8_t peak)
+{
+    will_return(__wrap_Timer_TimeDifference, SURVEY_INTERVAL_MS + 1);
+
+    for (uint8_t i = 0; i < SURVEY_SAMPLES; ++i)
+    {
+        /* Only one of the samples contains the peak. */
+        expect_value(__wrap_Transceiver_MeasureRSSI, channel, channel);
+        will_return(__wrap_Transceiver_MeasureRSSI, i == 2 ? peak : -110);
+        will_return(__wrap_Transceiver_MeasureRSSI, true);
+    }
+
+    will_return(__wrap_Filter_IsInitialized, false);
+    expect_value(__wrap_Filter_Init, initial_value, peak);
+}
+
+/**
+ * Survey all channels but the last, the next update surveys the last
+ * channel and completes the survey.
+ */
+static void PrepareSurvey(const int8_t *peaks_p)
+{
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS - 1; ++channel)
+    {
+        PrepareSurveyChannel(channel, peaks_p[channel]);
+        Channel_Update();
+    }
+
+    PrepareSurveyChannel(TR_NR_CHANNELS - 1, peaks_p[TR_NR_CHANNELS - 1]);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+}
+
+static void PrepareSelection(const int8_t *noise_levels_p, uint8_t current_channel)
+{
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS; ++channel)
+    {
+        will_return(__wrap_Filter_Output, noise_levels_p[channel]);
+    }
+
+    will_return_always(__wrap_Transceiver_GetChannel, current_channel);
+}
+
+static void PrepareTimestamp(uint32_t timestamp)
+{
+    will_return(__wrap_RTC_GetCurrentTime, true);
+    will_return(__wrap_Time_ConvertToTimestamp, timestamp);
+}
+
+static void PrepareSwitchPoll(uint32_t timestamp)
+{
+    will_return(__wrap_Timer_TimeDifference, SWITCH_POLL_INTERVAL_MS);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    PrepareTimestamp(timestamp);
+}
+
+static void ScheduleSwitch(uint8_t current_channel, uint8_t new_channel, uint32_t timestamp)
+{
+    int8_t peaks[TR_NR_CHANNELS];
+
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS; ++channel)
+    {
+        peaks[channel] = channel == new_channel ? -105 : -80;
+    }
+
+    PrepareSurvey(peaks);
+    PrepareSelection(peaks, current_channel);
+    PrepareTimestamp(timestamp);
+    will_return(__wrap_Config_GetReportInterval, REPORT_INTERVAL);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+
+    Channel_Update();
+}
+
+//////////////////////////////////////////////////////////////////////////
+//TESTS
+//////////////////////////////////////////////////////////////////////////
+
+static void test_Channel_Update_NoSurvey(void **state)
+{
+    will_return(__wrap_Timer_TimeDifference, SURVEY_INTERVAL_MS);
+    Channel_Update();
+}
+
+static void test_Channel_Update_TransceiverBusy(void **state)
+{
+    will_return(__wrap_Timer_TimeDifference, SURVEY_INTERVAL_MS + 1);
+    expect_value(__wrap_Transceiver_MeasureRSSI, channel, 0);
+    will_return(__wrap_Transceiver_MeasureRSSI, 0);
+    will_return(__wrap_Transceiver_MeasureRSSI, false);
+
+    /* The survey is aborted and the survey timer is not restarted. */
+    Channel_Update();
+
+    /* The same channel is measured again on next update. */
+    PrepareSurveyChannel(0, -100);
+    Channel_Update();
+}
+
+static void test_Channel_Update_SurveyOneChannel(void **state)
+{
+    /* Only one channel is measured on each update. */
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS - 1; ++channel)
+    {
+        PrepareSurveyChannel(channel, quiet_peaks[channel]);
+        Channel_Update();
+    }
+}
+
+static void test_Channel_Update_QuietChannel(void **state)
+{
+    PrepareSurvey(quiet_peaks);
+    PrepareSelection(quiet_peaks, 0);
+    Channel_Update();
+
+    /* No switch should be announced. */
+    Channel_Announce(1);
+}
+
+static void test_Channel_Update_FilterInitialized(void **state)
+{
+    for (uint8_t channel = 0; channel < TR_NR_CHANNELS; ++channel)
+    {
+        will_return(__wrap_Timer_TimeDifference, SURVEY_INTERVAL_MS + 1);
+        expect_value_count(__wrap_Transceiver_MeasureRSSI, channel, channel, SURVEY_SAMPLES);
+        for (uint8_t i = 0; i < SURVEY_SAMPLES; ++i)
+        {
+            will_return(__wrap_Transceiver_MeasureRSSI, -100);
+            will_return(__wrap_Transceiver_MeasureRSSI, true);
+        }
+        will_return(__wrap_Filter_IsInitialized, true);
+        expect_function_call(__wrap_Filter_Process);
+
+        if (channel == TR_NR_CHANNELS - 1)
+        {
+            will_return(__wrap_Timer_GetMilliseconds, 0);
+            PrepareSelection(quiet_peaks, 0);
+        }
+
+        Channel_Update();
+    }
+}
+
+static void test_Channel_Update_Hysteresis(void **state)
+{
+    const int8_t peaks[TR_NR_CHANNELS] = {-95, -100, -98, -97, -96, -99};
+
+    PrepareSurvey(peaks);
+    PrepareSelection(peaks, 0);
+    Channel_Update();
+
+    Channel_Announce(1);
+}
+
+static void test_Channel_Update_ScheduleSwitch(void **state)
+{
+    const uint8_t target = 130;
+    const uint32_t timestamp = 1000;
+
+    ScheduleSwitch(0, 3, timestamp);
+
+    expect_value(__wrap_Com_Send, target, target);
+    expect_value(__wrap_Com_Send, packet_type, COM_PACKET_TYPE_CHANNEL);
+    Channel_Announce(target);
+
+    /* The RTC should not be read more than once per second. */
+    will_return(__wrap_Timer_TimeDifference, SWITCH_POLL_INTERVAL_MS - 1);
+    Channel_Update();
+
+    /* The switch should not be done before the announced time. */
+    PrepareSwitchPoll(timestamp + SWITCH_DELAY - 1);
+    Channel_Update();
+
+    /* Retry if the transceiver is busy. */
+    PrepareSwitchPoll(timestamp + SWITCH_DELAY);
+    expect_value(__wrap_Transceiver_SetChannel, channel, 3);
+    will_return(__wrap_Transceiver_SetChannel, false);
+    Channel_Update();
+
+    PrepareSwitchPoll(timestamp + SWITCH_DELAY);
+    expect_value(__wrap_Transceiver_SetChannel, channel, 3);
+    will_return(__wrap_Transceiver_SetChannel, true);
+    Channel_Update();
+
+    /* Nothing should be announced after the switch. */
+    Channel_Announce(target);
+}
+
+static void test_Channel_Update_ScheduleSwitchRTCFailure(void **state)
+{
+    int8_t peaks[TR_NR_CHANNELS] = {-80, -80, -80, -80, -80, -105};
+
+    PrepareSurvey(peaks);
+    PrepareSelection(peaks, 0);
+    will_return(__wrap_RTC_GetCurrentTime, false);
+    Channel_Update();
+
+    Channel_Announce(1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test_setup(test_Channel_Update_NoSurvey, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_TransceiverBusy, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_SurveyOneChannel, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_QuietChannel, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_FilterInitialized, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_Hysteresis, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_ScheduleSwitch, Setup),
+        cmocka_unit_test_setup(test_Channel_Update_ScheduleSwitchRTCFailure, Setup)
+    };
+
+    if (argc >= 2)
+    {
+        cmocka_set_test_filter(argv[1]);
+    }
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
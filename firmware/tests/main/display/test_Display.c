@@ -1,7 +1,7 @@
 /**
  * @file   test_Display.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-06 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Display module.
  */
 
@@ -43,6 +43,10 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
+#define SPAN_WIDTH 16
+#define SPANS_PER_PAGE (NHD223_NUMBER_OF_COLUMNS / SPAN_WIDTH)
+#define NR_SPANS (NHD223_NUMBER_OF_PAGES * SPANS_PER_PAGE)
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -52,6 +56,10 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 static uint8_t expected_vram[NHD223_NUMBER_OF_PAGES][NHD223_NUMBER_OF_COLUMNS];
+static uint8_t flushed_vram[NHD223_NUMBER_OF_PAGES][NHD223_NUMBER_OF_COLUMNS];
+static uint8_t nr_flushes;
+static bool expect_full_flush;
+static uint8_t column_offset;
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
@@ -65,9 +73,15 @@ static void ClearExpectedVRAM(void)
 static int Setup(void **state)
 {
     ClearExpectedVRAM();
+    memset(flushed_vram, 0x00, sizeof(flushed_vram));
+    nr_flushes = 0;
+    expect_full_flush = true;
+    column_offset = 0;
 
     expect_function_call(__wrap_driverNHD223_Init);
     expect_function_call_any(__wrap_driverNHD223_SetHorizontalAddressingMode);
+    expect_value(__wrap_driverNHD223_SetMultiplexRatio, ratio, 32);
+    expect_value(__wrap_driverNHD223_SetRemap, remapped, false);
     expect_any(__wrap_driverNHD223_SetColumnAddressRange, start_address);
     expect_any(__wrap_driverNHD223_SetColumnAddressRange, end_address);
     expect_any(__wrap_driverNHD223_SetPageAddressRange, start_address);
@@ -78,15 +92,67 @@ static int Setup(void **state)
     return 0;
 }
 
+static void ExpectSpans(uint8_t page, uint8_t first_span, uint8_t end_span)
+{
+    const uint8_t start_column = first_span * SPAN_WIDTH;
+    const uint8_t end_column = end_span * SPAN_WIDTH - 1;
+
+    expect_value(__wrap_driverNHD223_SetColumnAddressRange, start_address, start_column + column_offset);
+    expect_value(__wrap_driverNHD223_SetColumnAddressRange, end_address, end_column + column_offset);
+    expect_value(__wrap_driverNHD223_SetPageAddressRange, start_address, page);
+    expect_value(__wrap_driverNHD223_SetPageAddressRange, end_address, page);
+
+    const size_t length = end_column - start_column + 1;
+
+    expect_value(__wrap_driverNHD223_WriteDataBlock, length, length);
+    expect_memory(__wrap_driverNHD223_WriteDataBlock, data_p,
+                  &expected_vram[page][start_column], length);
+    memcpy(&flushed_vram[page][start_column], &expected_vram[page][start_column], length);
+}
+
+static bool IsSpanDirty(uint8_t page, uint8_t span)
+{
+    const uint8_t span_index = page * SPANS_PER_PAGE + span;
+    const uint8_t scrub_index = nr_flushes % NR_SPANS;
+
+    return expect_full_flush ||
+           span_index == scrub_index ||
+           memcmp(&expected_vram[page][span * SPAN_WIDTH],
+                  &flushed_vram[page][span * SPAN_WIDTH],
+                  SPAN_WIDTH) != 0;
+}
+
+/**
+ * Expect a flush of all spans that differ from the last flushed frame, one
+ * span is also rewritten on each flush.
+ */
 static void ExpectFlush(void)
 {
     for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
     {
-        for (uint8_t column = 0; column < NHD223_NUMBER_OF_COLUMNS; ++column)
+        uint8_t span = 0;
+
+        while (span < SPANS_PER_PAGE)
         {
-            expect_value(__wrap_driverNHD223_WriteData, data, expected_vram[page][column]);
+            if (IsSpanDirty(page, span))
+            {
+                const uint8_t first_span = span;
+
+                while (span < SPANS_PER_PAGE && IsSpanDirty(page, span))
+                {
+                    ++span;
+                }
+                ExpectSpans(page, first_span, span);
+            }
+            else
+            {
+                ++span;
+            }
         }
     }
+
+    ++nr_flushes;
+    expect_full_flush = false;
 }
 
 static void CheckVRAM(void)
@@ -103,6 +169,8 @@ void test_Display_Init(void **state)
 {
     expect_function_call(__wrap_driverNHD223_Init);
     expect_function_call(__wrap_driverNHD223_SetHorizontalAddressingMode);
+    expect_value(__wrap_driverNHD223_SetMultiplexRatio, ratio, 32);
+    expect_value(__wrap_driverNHD223_SetRemap, remapped, false);
 
     const uint8_t max_column_address = 127;
     expect_value(__wrap_driverNHD223_SetColumnAddressRange, start_address, 0);
@@ -132,6 +200,73 @@ static void test_Display_Flush(void **state)
     CheckVRAM();
 }
 
+static void test_Display_Flush_Unchanged(void **state)
+{
+    /* First flush after init writes the whole frame. */
+    for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
+    {
+        ExpectSpans(page, 0, SPANS_PER_PAGE);
+    }
+    Display_Flush();
+
+    /* Only the scrubbed span is written when nothing has changed. */
+    ExpectSpans(0, 1, 2);
+    Display_Flush();
+
+    ExpectSpans(0, 2, 3);
+    Display_Flush();
+}
+
+static void test_Display_Flush_OnlyChangedSpans(void **state)
+{
+    for (uint8_t page = 0; page < NHD223_NUMBER_OF_PAGES; ++page)
+    {
+        ExpectSpans(page, 0, SPANS_PER_PAGE);
+    }
+    Display_Flush();
+
+    /* Page 1, span 2. */
+    expected_vram[1][40] = 0x02;
+    ExpectSpans(0, 1, 2);
+    ExpectSpans(1, 2, 3);
+    Display_SetPixel(40, 9);
+    Display_Flush();
+
+    /* Adjacent dirty spans are written in one window. */
+    expected_vram[2][15] = 0x01;
+    expected_vram[2][16] = 0x01;
+    ExpectSpans(0, 2, 3);
+    ExpectSpans(2, 0, 2);
+    Display_SetPixel(15, 16);
+    Display_SetPixel(16, 16);
+    Display_Flush();
+
+    /* Cleared content is also written. */
+    memset(expected_vram, 0x00, sizeof(expected_vram));
+    ExpectSpans(0, 3, 4);
+    ExpectSpans(1, 2, 3);
+    ExpectSpans(2, 0, 2);
+    Display_ClearVRAM();
+    Display_Flush();
+}
+
+/**
+ * Expect changes that cancel out in byte sums to be detected, +0x80 and
+ * -0x80 two columns apart used to leave a Fletcher style sum unchanged.
+ */
+static void test_Display_Flush_CancellingChanges(void **state)
+{
+    expected_vram[0][2] = 0x80;
+    Display_SetPixel(2, 7);
+    CheckVRAM();
+
+    expected_vram[0][0] = 0x80;
+    expected_vram[0][2] = 0x00;
+    Display_SetPixel(0, 7);
+    Display_ClearRectangle(2, 7, 1, 1);
+    CheckVRAM();
+}
+
 static void test_Display_SetBrightness(void **state)
 {
     uint8_t values[] = {0, 128, UINT8_MAX};
@@ -194,42 +329,162 @@ static void test_Display_SetPixel(void **state)
 
 static void test_Display_Clear(void **state)
 {
+    CheckVRAM();
+
     Display_SetPixel(0, 0);
+    expect_full_flush = true;
     ExpectFlush();
     Display_Clear();
 }
 
 static void test_Display_Reset(void **state)
 {
+    CheckVRAM();
+
     Display_SetPixel(0, 0);
     expect_function_call(__wrap_driverNHD223_ResetDisplay);
+    expect_value(__wrap_driverNHD223_SetMultiplexRatio, ratio, 32);
+    expect_value(__wrap_driverNHD223_SetRemap, remapped, false);
+    expect_full_flush = true;
     ExpectFlush();
     Display_Reset();
 }
 
+static void test_Display_DrawBitmap_P(void **state)
+{
+    /* Two columns, ten rows high. */
+    const uint8_t bitmap[] = {0xFF, 0x03, 0x01, 0x02};
+
+    /* Page aligned. */
+    expected_vram[0][10] = 0xFF;
+    expected_vram[1][10] = 0x03;
+    expected_vram[0][11] = 0x01;
+    expected_vram[1][11] = 0x02;
+    Display_DrawBitmap_P(10, 0, bitmap, 2, 10);
+    CheckVRAM();
+
+    /* Not page aligned, each byte is split over two pages. */
+    ClearExpectedVRAM();
+    Display_ClearVRAM();
+    expected_vram[1][10] = 0xF8;
+    expected_vram[2][10] = 0x1F;
+    expected_vram[1][11] = 0x08;
+    expected_vram[2][11] = 0x10;
+    Display_DrawBitmap_P(10, 11, bitmap, 2, 10);
+    CheckVRAM();
+}
+
+static void test_Display_DrawBitmap_P_Clipping(void **state)
+{
+    const uint8_t bitmap[] = {0xFF, 0x03, 0x01, 0x02};
+
+    /* Rows above the display. */
+    expected_vram[0][0] = 0x7F;
+    expected_vram[0][1] = 0x40;
+    Display_DrawBitmap_P(0, -3, bitmap, 2, 10);
+    CheckVRAM();
+
+    /* Rows below and columns to the right of the display. */
+    ClearExpectedVRAM();
+    Display_ClearVRAM();
+    expected_vram[3][127] = 0xC0;
+    Display_DrawBitmap_P(127, 30, bitmap, 2, 10);
+    CheckVRAM();
+}
+
+static void test_Display_DrawColumn(void **state)
+{
+    expected_vram[0][5] = 0xC0;
+    expected_vram[1][5] = 0xFF;
+    expected_vram[2][5] = 0x3F;
+    Display_DrawColumn(5, 6, 0xFFFF);
+    CheckVRAM();
+
+    /* Clipped at the top, bottom and right edge. */
+    ClearExpectedVRAM();
+    Display_ClearVRAM();
+    expected_vram[0][0] = 0x3F;
+    expected_vram[3][1] = 0xE0;
+    Display_DrawColumn(0, -10, 0xFFFF);
+    Display_DrawColumn(1, 29, 0x0007);
+    Display_DrawColumn(128, 0, 0xFFFF);
+    CheckVRAM();
+}
+
+static void test_Display_FillRectangle(void **state)
+{
+    expected_vram[0][3] = 0xC0;
+    expected_vram[1][3] = 0xFF;
+    expected_vram[2][3] = 0x03;
+    expected_vram[0][4] = 0xC0;
+    expected_vram[1][4] = 0xFF;
+    expected_vram[2][4] = 0x03;
+    Display_FillRectangle(3, 6, 2, 12);
+    CheckVRAM();
+
+    /* Clipped at the right and bottom edge, nothing drawn outside. */
+    ClearExpectedVRAM();
+    Display_ClearVRAM();
+    expected_vram[3][126] = 0xC0;
+    expected_vram[3][127] = 0xC0;
+    Display_FillRectangle(126, 30, 10, 10);
+    Display_FillRectangle(128, 0, 1, 1);
+    Display_FillRectangle(0, 32, 1, 1);
+    Display_FillRectangle(0, 0, 0, 8);
+    Display_FillRectangle(0, 0, 8, 0);
+    CheckVRAM();
+}
+
+static void test_Display_ClearRectangle(void **state)
+{
+    expected_vram[0][3] = 0x3F;
+    expected_vram[1][3] = 0xFC;
+    expected_vram[0][4] = 0xFF;
+    expected_vram[1][4] = 0xFF;
+    Display_FillRectangle(3, 0, 2, 16);
+    Display_ClearRectangle(3, 6, 1, 4);
+    CheckVRAM();
+}
+
+static void test_Display_InvertRectangle(void **state)
+{
+    expected_vram[0][0] = 0x02;
+    expected_vram[0][1] = 0x03;
+    Display_SetPixel(0, 0);
+    Display_InvertRectangle(0, 0, 2, 2);
+    CheckVRAM();
+
+    /* Inverting again restores the original content. */
+    ClearExpectedVRAM();
+    expected_vram[0][0] = 0x01;
+    Display_InvertRectangle(0, 0, 2, 2);
+    CheckVRAM();
+}
+
 static void test_Display_Rotate(void **state)
 {
-    /* Check that VRAM is cleared when changing rotation. */
+    CheckVRAM();
+
+    /* Check that VRAM is cleared and that the whole frame is rewritten at the
+     * remapped column addresses. */
     Display_SetPixel(0, 0);
+    expect_value(__wrap_driverNHD223_SetRemap, remapped, true);
     Display_Rotate(true);
+    column_offset = 4;
+    expect_full_flush = true;
     CheckVRAM();
 
-    /* Check that the correct pixel is set, lower right corner instead of upper left corner. */
-    uint8_t expected_column = 127;
-    uint8_t expected_page = 3;
-    uint8_t expected_value = 0x80;
-    expected_vram[expected_page][expected_column] = expected_value;
+    /* Pixels are not mirrored in VRAM, the controller does that. */
+    expected_vram[0][0] = 0x01;
     Display_SetPixel(0, 0);
     CheckVRAM();
 
     /* Rotate back again. */
     ClearExpectedVRAM();
-    expected_column = 0;
-    expected_page = 0;
-    expected_value = 0x01;
-    expected_vram[expected_page][expected_column] = expected_value;
+    expect_value(__wrap_driverNHD223_SetRemap, remapped, false);
     Display_Rotate(false);
-    Display_SetPixel(0, 0);
+    column_offset = 0;
+    expect_full_flush = true;
     CheckVRAM();
 }
 
@@ -237,6 +492,28 @@ static void test_Display_Rotate(void **state)
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
 
+/**
+ * Same CRC-16 as the utility module, the flush relies on it detecting any
+ * change within a span.
+ */
+uint16_t __wrap_CRC_16(const void *data, size_t length)
+{
+    const uint8_t *data_p = data;
+    uint16_t crc = 0x0000;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc ^= (uint16_t)data_p[i] << 8;
+
+        for (uint8_t bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x8005) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
 int main(int argc, char *argv[])
 {
     const struct CMUnitTest tests[] =
@@ -245,11 +522,20 @@ int main(int argc, char *argv[])
         cmocka_unit_test_setup(test_Display_On, Setup),
         cmocka_unit_test_setup(test_Display_Off, Setup),
         cmocka_unit_test_setup(test_Display_Flush, Setup),
+        cmocka_unit_test_setup(test_Display_Flush_Unchanged, Setup),
+        cmocka_unit_test_setup(test_Display_Flush_OnlyChangedSpans, Setup),
+        cmocka_unit_test_setup(test_Display_Flush_CancellingChanges, Setup),
         cmocka_unit_test_setup(test_Display_SetBrightness, Setup),
         cmocka_unit_test_setup(test_Display_SetPixel_InvalidCoordinates, Setup),
         cmocka_unit_test_setup(test_Display_SetPixel, Setup),
         cmocka_unit_test_setup(test_Display_Clear, Setup),
         cmocka_unit_test_setup(test_Display_Reset, Setup),
+        cmocka_unit_test_setup(test_Display_DrawBitmap_P, Setup),
+        cmocka_unit_test_setup(test_Display_DrawBitmap_P_Clipping, Setup),
+        cmocka_unit_test_setup(test_Display_DrawColumn, Setup),
+        cmocka_unit_test_setup(test_Display_FillRectangle, Setup),
+        cmocka_unit_test_setup(test_Display_ClearRectangle, Setup),
+        cmocka_unit_test_setup(test_Display_InvertRectangle, Setup),
         cmocka_unit_test_setup(test_Display_Rotate, Setup),
     };
 
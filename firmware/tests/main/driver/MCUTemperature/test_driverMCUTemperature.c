@@ -1,7 +1,7 @@
 /**
  * @file   test_driverMCUTemperature.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the MCU temperature driver.
  */
 
@@ -63,7 +63,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 static int Setup(void **state)
 {
-    expect_any(__wrap_ADC_InitChannel, index);
+    expect_any(__wrap_ADC_InitScanChannel, index);
     driverMCUTemperature_Init();
 
     return 0;
@@ -77,7 +77,7 @@ static void test_driverMCUTemperature_Init(void **state)
 {
     const uint8_t expected_channel_index = 8;
 
-    expect_value(__wrap_ADC_InitChannel, index, expected_channel_index);
+    expect_value(__wrap_ADC_InitScanChannel, index, expected_channel_index);
     driverMCUTemperature_Init();
 }
 
@@ -86,18 +86,17 @@ static void test_driverMCUTemperature_GetSensor(void **state)
     assert_non_null(driverMCUTemperature_GetSensor());
 }
 
-static void test_driverMCUTemperature_UpdateSampleFrequency(void **state)
+static void test_driverMCUTemperature_UpdateStartScan(void **state)
 {
+    // The sensor module calls update once per period, each call reads the
+    // result of the previous scan and starts the next.
     for (size_t i = 0; i < 2; ++i)
     {
         struct sensor_t *sensor_p = driverMCUTemperature_GetSensor();
+        assert_true(sensor_p->period_ms > 0);
 
-        will_return(__wrap_Timer_TimeDifference, 100);
-        sensor_p->Update(sensor_p);
-
-        will_return(__wrap_Timer_TimeDifference, 101);
-        will_return(__wrap_ADC_Convert, 0);
-        will_return(__wrap_Timer_GetMilliseconds, 200);
+        will_return(__wrap_ADC_GetScanResult, false);
+        expect_function_call(__wrap_ADC_StartScan);
         sensor_p->Update(sensor_p);
     }
 }
@@ -106,15 +105,28 @@ static void test_driverMCUTemperature_Update(void **state)
 {
     struct sensor_t *sensor_p = driverMCUTemperature_GetSensor();
 
-    will_return(__wrap_Timer_TimeDifference, UINT32_MAX);
-    will_return(__wrap_ADC_Convert, 100);
-    will_return(__wrap_Timer_GetMilliseconds, 200);
+    will_return(__wrap_ADC_GetScanResult, true);
+    will_return(__wrap_ADC_GetScanResult, 100 << 2);
+    expect_function_call(__wrap_ADC_StartScan);
     sensor_p->Update(sensor_p);
 
     assert_int_equal(sensor_p->value, 33);
     assert_true(sensor_p->valid);
 }
 
+static void test_driverMCUTemperature_UpdateNoResult(void **state)
+{
+    struct sensor_t *sensor_p = driverMCUTemperature_GetSensor();
+
+    sensor_p->valid = false;
+
+    will_return(__wrap_ADC_GetScanResult, false);
+    expect_function_call(__wrap_ADC_StartScan);
+    sensor_p->Update(sensor_p);
+
+    assert_false(sensor_p->valid);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -125,8 +137,9 @@ int main(int argc, char *argv[])
     {
         cmocka_unit_test(test_driverMCUTemperature_Init),
         cmocka_unit_test_setup(test_driverMCUTemperature_GetSensor, Setup),
-        cmocka_unit_test_setup(test_driverMCUTemperature_UpdateSampleFrequency, Setup),
+        cmocka_unit_test_setup(test_driverMCUTemperature_UpdateStartScan, Setup),
         cmocka_unit_test_setup(test_driverMCUTemperature_Update, Setup),
+        cmocka_unit_test_setup(test_driverMCUTemperature_UpdateNoResult, Setup),
     };
 
     if (argc >= 2)
@@ -1,7 +1,7 @@
 /**
  * @file   test_driverNHD223.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-28 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite NHD2.23(SSD1305) graphic OLED display driver.
  */
 
@@ -135,6 +135,23 @@ static void ExpectWriteData(uint8_t data)
     expect_function_call(__wrap_Board_NHD223_SetEnableLow);
 }
 
+static void ExpectDataStream(const uint8_t *data_p, size_t length)
+{
+    ExpectSetWriteMode();
+    ExpectSetDataMode();
+
+    expect_function_call(__wrap_Board_NHD223_SetChipSelectLow);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        expect_function_call(__wrap_Board_NHD223_SetEnableHigh);
+        expect_value(__wrap_Board_NHD223_SetDataPins, data, data_p[i]);
+        expect_function_call(__wrap_Board_NHD223_SetEnableLow);
+    }
+
+    expect_function_call(__wrap_Board_NHD223_SetChipSelectHigh);
+}
+
 static void ExpectSetPageAddress(uint8_t address)
 {
     ExpectWriteCommand(SSD1305_SET_PAGE | address);
@@ -142,14 +159,12 @@ static void ExpectSetPageAddress(uint8_t address)
 
 static void ExpectClearDisplay()
 {
+    const uint8_t empty_page[NHD223_NUMBER_OF_COLUMNS] = {0};
+
     for (size_t i = 0; i < NHD223_NUMBER_OF_PAGES; ++i)
     {
         ExpectSetPageAddress(i);
-
-        for (size_t i = 0; i < NHD223_NUMBER_OF_COLUMNS; ++i)
-        {
-            ExpectWriteData(0x00);
-        }
+        ExpectDataStream(empty_page, sizeof(empty_page));
     }
 }
 
@@ -179,6 +194,25 @@ static void test_driverNHD223_WriteData(void **state)
     }
 }
 
+static void test_driverNHD223_WriteDataBlock(void **state)
+{
+    const uint8_t data[] = {0, 128, UINT8_MAX, 0x5A};
+
+    ExpectDataStream(data, sizeof(data));
+    driverNHD223_WriteDataBlock(data, sizeof(data));
+}
+
+static void test_driverNHD223_WriteDataBlock_Empty(void **state)
+{
+    ExpectDataStream(NULL, 0);
+    driverNHD223_WriteDataBlock((const uint8_t *)"", 0);
+}
+
+static void test_driverNHD223_WriteDataBlock_Invalid(void **state)
+{
+    expect_assert_failure(driverNHD223_WriteDataBlock(NULL, 1));
+}
+
 static void test_driverNHD223_ResetDisplay(void **state)
 {
     ExpectResetSequence();
@@ -200,6 +234,30 @@ static void test_driverNHD223_SetHorizontalAddressingMode(void **state)
     driverNHD223_SetHorizontalAddressingMode();
 }
 
+static void test_driverNHD223_SetMultiplexRatio_Invalid(void **state)
+{
+    expect_assert_failure(driverNHD223_SetMultiplexRatio(15));
+    expect_assert_failure(driverNHD223_SetMultiplexRatio(65));
+}
+
+static void test_driverNHD223_SetMultiplexRatio(void **state)
+{
+    ExpectWriteCommand(SSD1305_SETMULTIPLEX);
+    ExpectWriteCommand(31);
+    driverNHD223_SetMultiplexRatio(32);
+}
+
+static void test_driverNHD223_SetRemap(void **state)
+{
+    ExpectWriteCommand(SSD1305_SEGREMAP1);
+    ExpectWriteCommand(SSD1305_COMSCANDEC);
+    driverNHD223_SetRemap(true);
+
+    ExpectWriteCommand(SSD1305_SEGREMAP);
+    ExpectWriteCommand(SSD1305_COMSCANINC);
+    driverNHD223_SetRemap(false);
+}
+
 static void test_driverNHD223_SetPageAddress_Invalid(void **state)
 {
     const uint8_t values[] = {NHD223_NUMBER_OF_PAGES, UINT8_MAX};
@@ -293,9 +351,15 @@ int main(int argc, char *argv[])
     {
         cmocka_unit_test(test_driverNHD223_WriteCommand),
         cmocka_unit_test(test_driverNHD223_WriteData),
+        cmocka_unit_test(test_driverNHD223_WriteDataBlock),
+        cmocka_unit_test(test_driverNHD223_WriteDataBlock_Empty),
+        cmocka_unit_test(test_driverNHD223_WriteDataBlock_Invalid),
         cmocka_unit_test(test_driverNHD223_ResetDisplay),
         cmocka_unit_test(test_driverNHD223_Init),
         cmocka_unit_test(test_driverNHD223_SetHorizontalAddressingMode),
+        cmocka_unit_test(test_driverNHD223_SetMultiplexRatio_Invalid),
+        cmocka_unit_test(test_driverNHD223_SetMultiplexRatio),
+        cmocka_unit_test(test_driverNHD223_SetRemap),
         cmocka_unit_test(test_driverNHD223_SetPageAddress_Invalid),
         cmocka_unit_test(test_driverNHD223_SetPageAddress),
         cmocka_unit_test(test_driverNHD223_SetPageAddressRange_Invalid),
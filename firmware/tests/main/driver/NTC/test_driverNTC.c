@@ -1,7 +1,7 @@
 /**
  * @file   test_driverNTC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-04-12 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the NTC driver.
  */
 
@@ -63,8 +63,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 static int Setup(void **state)
 {
-    expect_value(__wrap_ADC_InitChannel, index, 6);
-    expect_value(__wrap_ADC_InitChannel, index, 7);
+    expect_value(__wrap_ADC_InitScanChannel, index, 6);
+    expect_value(__wrap_ADC_InitScanChannel, index, 7);
     driverNTC_Init();
 
     return 0;
@@ -76,8 +76,8 @@ static int Setup(void **state)
 
 static void test_driverNTC_Init(void **state)
 {
-    expect_value(__wrap_ADC_InitChannel, index, 6);
-    expect_value(__wrap_ADC_InitChannel, index, 7);
+    expect_value(__wrap_ADC_InitScanChannel, index, 6);
+    expect_value(__wrap_ADC_InitScanChannel, index, 7);
     driverNTC_Init();
 }
 
@@ -95,47 +95,62 @@ static void test_driverNTC_GetSensor(void **state)
 
 static void test_driverNTC_UpdateInvalidValue(void **state)
 {
-    const uint16_t test_data[] = {0, 119, 939, 1023};
+    const uint16_t test_data[] = {0, (119 << 2) + 3, 939 << 2, 4095};
     struct sensor_t *sensor_p = driverNTC_GetSensor(0);
 
     for (size_t i = 0; i < sizeof(test_data) / sizeof(test_data[0]); ++i)
     {
-        will_return(__wrap_Timer_TimeDifference, UINT32_MAX);
-        will_return(__wrap_ADC_Convert, test_data[i]);
-        will_return(__wrap_Timer_GetMilliseconds, 0);
+        will_return(__wrap_ADC_GetScanResult, true);
+        will_return(__wrap_ADC_GetScanResult, test_data[i]);
+        expect_function_call(__wrap_ADC_StartScan);
         sensor_p->Update(sensor_p);
 
         assert_false(sensor_p->valid);
     }
 }
 
-static void test_driverNTC_UpdateSampleFrequency(void **state)
+static void test_driverNTC_UpdateStartScan(void **state)
 {
+    // The sensor module calls update once per period, each call reads the
+    // result of the previous scan and starts the next.
     for (size_t i = 0; i < 2; ++i)
     {
-        struct sensor_t *sensor_p = driverNTC_GetSensor(0);
+        struct sensor_t *sensor_p = driverNTC_GetSensor(i);
+        assert_true(sensor_p->period_ms > 0);
 
-        will_return(__wrap_Timer_TimeDifference, 100);
-        sensor_p->Update(sensor_p);
-
-        will_return(__wrap_Timer_TimeDifference, 101);
-        will_return(__wrap_ADC_Convert, 0);
-        will_return(__wrap_Timer_GetMilliseconds, 200);
+        will_return(__wrap_ADC_GetScanResult, false);
+        expect_function_call(__wrap_ADC_StartScan);
         sensor_p->Update(sensor_p);
     }
 }
 
+static void test_driverNTC_UpdateNoResult(void **state)
+{
+    const int16_t temperature = 250;
+    struct sensor_t *sensor_p = driverNTC_GetSensor(1);
+
+    sensor_p->value = temperature;
+    sensor_p->valid = true;
+
+    will_return(__wrap_ADC_GetScanResult, false);
+    expect_function_call(__wrap_ADC_StartScan);
+    sensor_p->Update(sensor_p);
+
+    assert_true(sensor_p->valid);
+    assert_int_equal(sensor_p->value, temperature);
+}
+
 static void test_driverNTC_UpdateUninitializedFilter(void **state)
 {
     const int16_t temperature = 250;
     struct sensor_t *sensor_p = driverNTC_GetSensor(1);
 
-    will_return(__wrap_Timer_TimeDifference, UINT32_MAX);
-    will_return(__wrap_ADC_Convert, 512);
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-    will_return(__wrap_Filter_IsInitialized, false);
-    expect_value(__wrap_Filter_Init, initial_value, temperature);
-    will_return(__wrap_Filter_Output, temperature);
+    will_return(__wrap_ADC_GetScanResult, true);
+    will_return(__wrap_ADC_GetScanResult, 512 << 2);
+    will_return(__wrap_Filter_ShiftIsInitialized, false);
+    expect_in_range(__wrap_Filter_ShiftInit, initial_value, temperature - 1, temperature + 1);
+    will_return(__wrap_Filter_ShiftOutput, temperature);
+    expect_function_call(__wrap_ADC_StartScan);
 
     sensor_p->Update(sensor_p);
     assert_true(sensor_p->valid);
@@ -147,18 +162,35 @@ static void test_driverNTC_UpdateInitializedFilter(void **state)
     const int16_t temperature = 250;
     struct sensor_t *sensor_p = driverNTC_GetSensor(1);
 
-    will_return(__wrap_Timer_TimeDifference, UINT32_MAX);
-    will_return(__wrap_ADC_Convert, 512);
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-    will_return(__wrap_Filter_IsInitialized, true);
-    expect_function_call(__wrap_Filter_Process);
-    will_return(__wrap_Filter_Output, temperature);
+    will_return(__wrap_ADC_GetScanResult, true);
+    will_return(__wrap_ADC_GetScanResult, 512 << 2);
+    will_return(__wrap_Filter_ShiftIsInitialized, true);
+    expect_function_call(__wrap_Filter_ShiftProcess);
+    will_return(__wrap_Filter_ShiftOutput, temperature);
+    expect_function_call(__wrap_ADC_StartScan);
 
     sensor_p->Update(sensor_p);
     assert_true(sensor_p->valid);
     assert_int_equal(sensor_p->value, temperature);
 }
 
+static void test_driverNTC_UpdateInterpolated(void **state)
+{
+    struct sensor_t *sensor_p = driverNTC_GetSensor(1);
+
+    // The thermistor model gives 81.1 degrees for 911.25, the breakpoint
+    // tables are generated to stay within 0.1 degrees of the model.
+    will_return(__wrap_ADC_GetScanResult, true);
+    will_return(__wrap_ADC_GetScanResult, (911 << 2) + 1);
+    will_return(__wrap_Filter_ShiftIsInitialized, false);
+    expect_in_range(__wrap_Filter_ShiftInit, initial_value, 810, 812);
+    will_return(__wrap_Filter_ShiftOutput, 811);
+    expect_function_call(__wrap_ADC_StartScan);
+
+    sensor_p->Update(sensor_p);
+    assert_true(sensor_p->valid);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -171,9 +203,11 @@ int main(int argc, char *argv[])
         cmocka_unit_test_setup(test_driverNTC_GetSensor_InvalidId, Setup),
         cmocka_unit_test_setup(test_driverNTC_GetSensor, Setup),
         cmocka_unit_test_setup(test_driverNTC_UpdateInvalidValue, Setup),
-        cmocka_unit_test_setup(test_driverNTC_UpdateSampleFrequency, Setup),
+        cmocka_unit_test_setup(test_driverNTC_UpdateStartScan, Setup),
+        cmocka_unit_test_setup(test_driverNTC_UpdateNoResult, Setup),
         cmocka_unit_test_setup(test_driverNTC_UpdateUninitializedFilter, Setup),
-        cmocka_unit_test_setup(test_driverNTC_UpdateInitializedFilter, Setup)
+        cmocka_unit_test_setup(test_driverNTC_UpdateInitializedFilter, Setup),
+        cmocka_unit_test_setup(test_driverNTC_UpdateInterpolated, Setup)
     };
 
     if (argc >= 2)
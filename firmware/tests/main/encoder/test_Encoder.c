@@ -1,7 +1,7 @@
 /**
  * @file   test_Encoder.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Encoder module.
  */
 
@@ -89,6 +89,12 @@ static void FakeExtendedPushCallback(void)
     function_called();
 }
 
+static bool FakeActivityCallback(void)
+{
+    function_called();
+    return mock_type(bool);
+}
+
 static void SetCallbacks(void)
 {
     struct encoder_callbacks_t callbacks =
@@ -173,8 +179,7 @@ static void test_Encoder_Update_NoInput(void **state)
 {
     SetCallbacks();
 
-    will_return(__wrap_driverPEC11_PopRightRotation, false);
-    will_return(__wrap_driverPEC11_PopLeftRotation, false);
+    will_return(__wrap_driverPEC11_PopRotation, 0);
     will_return(__wrap_driverPEC11_PopBriefPush, false);
     will_return(__wrap_driverPEC11_PopExtendedPush, false);
 
@@ -185,16 +190,18 @@ static void test_Encoder_Update(void **state)
 {
     SetCallbacks();
 
-    will_return(__wrap_driverPEC11_PopRightRotation, true);
+    will_return_always(__wrap_Timer_TimeDifference, 1000);
+    will_return_always(__wrap_Timer_GetMilliseconds, 0);
+
+    will_return(__wrap_driverPEC11_PopRotation, 1);
     expect_function_call(FakeRightCallback);
     Encoder_Update();
 
-    will_return_always(__wrap_driverPEC11_PopRightRotation, false);
-    will_return(__wrap_driverPEC11_PopLeftRotation, true);
+    will_return(__wrap_driverPEC11_PopRotation, -1);
     expect_function_call(FakeLeftCallback);
     Encoder_Update();
 
-    will_return_always(__wrap_driverPEC11_PopLeftRotation, false);
+    will_return_always(__wrap_driverPEC11_PopRotation, 0);
     will_return(__wrap_driverPEC11_PopBriefPush, true);
     expect_function_call(FakeBriefPushCallback);
     Encoder_Update();
@@ -205,6 +212,151 @@ static void test_Encoder_Update(void **state)
     Encoder_Update();
 }
 
+/**
+ * Expect one callback for each detent recorded since the last update.
+ */
+static void test_Encoder_Update_MultipleDetents(void **state)
+{
+    SetCallbacks();
+    will_return_always(__wrap_Timer_TimeDifference, 1000);
+    will_return_always(__wrap_Timer_GetMilliseconds, 0);
+
+    will_return(__wrap_driverPEC11_PopRotation, 3);
+    expect_function_calls(FakeRightCallback, 3);
+    Encoder_Update();
+
+    will_return(__wrap_driverPEC11_PopRotation, INT8_MIN);
+    expect_function_calls(FakeLeftCallback, 128);
+    Encoder_Update();
+}
+
+/**
+ * Expect the detents to be left in the driver if there are no rotation
+ * callbacks.
+ */
+static void test_Encoder_Update_NoRotationCallbacks(void **state)
+{
+    struct encoder_callbacks_t callbacks =
+    {
+        .brief_push = FakeBriefPushCallback
+    };
+    Encoder_SetCallbacks(&callbacks);
+
+    will_return(__wrap_driverPEC11_PopBriefPush, true);
+    expect_function_call(FakeBriefPushCallback);
+    Encoder_Update();
+}
+
+/**
+ * Expect the detents to be left in the driver if only one direction is
+ * handled.
+ */
+static void test_Encoder_Update_OneRotationCallback(void **state)
+{
+    struct encoder_callbacks_t callbacks =
+    {
+        .right = FakeRightCallback,
+        .brief_push = FakeBriefPushCallback
+    };
+    Encoder_SetCallbacks(&callbacks);
+
+    will_return(__wrap_driverPEC11_PopBriefPush, true);
+    expect_function_call(FakeBriefPushCallback);
+    Encoder_Update();
+}
+
+/**
+ * Expect the activity callback to be called once before every event.
+ */
+static void test_Encoder_Update_ActivityCallback(void **state)
+{
+    SetCallbacks();
+    Encoder_SetActivityCallback(FakeActivityCallback);
+    will_return_always(__wrap_Timer_TimeDifference, 1000);
+    will_return_always(__wrap_Timer_GetMilliseconds, 0);
+
+    will_return(__wrap_driverPEC11_PopRotation, 2);
+    will_return(FakeActivityCallback, true);
+    expect_function_call(FakeActivityCallback);
+    expect_function_calls(FakeRightCallback, 2);
+    Encoder_Update();
+
+    will_return_always(__wrap_driverPEC11_PopRotation, 0);
+    will_return(__wrap_driverPEC11_PopBriefPush, true);
+    will_return(FakeActivityCallback, true);
+    expect_function_call(FakeActivityCallback);
+    expect_function_call(FakeBriefPushCallback);
+    Encoder_Update();
+
+    will_return_always(__wrap_driverPEC11_PopBriefPush, false);
+    will_return(__wrap_driverPEC11_PopExtendedPush, true);
+    will_return(FakeActivityCallback, true);
+    expect_function_call(FakeActivityCallback);
+    expect_function_call(FakeExtendedPushCallback);
+    Encoder_Update();
+
+    /* Expect no activity without an event. */
+    will_return(__wrap_driverPEC11_PopExtendedPush, false);
+    Encoder_Update();
+}
+
+/**
+ * Expect the event to be dropped if the activity callback rejects it.
+ */
+static void test_Encoder_Update_ActivityCallbackDrop(void **state)
+{
+    SetCallbacks();
+    Encoder_SetActivityCallback(FakeActivityCallback);
+    will_return_always(__wrap_Timer_TimeDifference, 1000);
+    will_return_always(__wrap_Timer_GetMilliseconds, 0);
+
+    will_return(__wrap_driverPEC11_PopRotation, -3);
+    will_return(FakeActivityCallback, false);
+    expect_function_call(FakeActivityCallback);
+    Encoder_Update();
+
+    will_return(__wrap_driverPEC11_PopRotation, 0);
+    will_return(__wrap_driverPEC11_PopBriefPush, true);
+    will_return(FakeActivityCallback, false);
+    expect_function_call(FakeActivityCallback);
+    Encoder_Update();
+}
+
+static void test_Encoder_GetStepSize(void **state)
+{
+    SetCallbacks();
+    will_return_always(__wrap_Timer_GetMilliseconds, 0);
+    assert_int_equal(Encoder_GetStepSize(), 1);
+
+    /* Slow rotation. */
+    will_return(__wrap_driverPEC11_PopRotation, 1);
+    will_return(__wrap_Timer_TimeDifference, 50);
+    expect_function_call(FakeRightCallback);
+    Encoder_Update();
+    assert_int_equal(Encoder_GetStepSize(), 1);
+
+    /* Medium speed, averaged over all detents. */
+    will_return(__wrap_driverPEC11_PopRotation, 2);
+    will_return(__wrap_Timer_TimeDifference, 98);
+    expect_function_calls(FakeRightCallback, 2);
+    Encoder_Update();
+    assert_int_equal(Encoder_GetStepSize(), 2);
+
+    /* Fast rotation. */
+    will_return(__wrap_driverPEC11_PopRotation, 1);
+    will_return(__wrap_Timer_TimeDifference, 19);
+    expect_function_call(FakeRightCallback);
+    Encoder_Update();
+    assert_int_equal(Encoder_GetStepSize(), 5);
+
+    /* Changing direction restarts the acceleration. */
+    will_return(__wrap_driverPEC11_PopRotation, -1);
+    will_return(__wrap_Timer_TimeDifference, 10);
+    expect_function_call(FakeLeftCallback);
+    Encoder_Update();
+    assert_int_equal(Encoder_GetStepSize(), 1);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -218,7 +370,13 @@ int main(int argc, char *argv[])
         cmocka_unit_test_setup(test_Encoder_SetGetCallbacks, Setup),
         cmocka_unit_test_setup(test_Encoder_Update_NoCallbacks, Setup),
         cmocka_unit_test_setup(test_Encoder_Update_NoInput, Setup),
-        cmocka_unit_test_setup(test_Encoder_Update, Setup)
+        cmocka_unit_test_setup(test_Encoder_Update, Setup),
+        cmocka_unit_test_setup(test_Encoder_Update_MultipleDetents, Setup),
+        cmocka_unit_test_setup(test_Encoder_Update_NoRotationCallbacks, Setup),
+        cmocka_unit_test_setup(test_Encoder_Update_OneRotationCallback, Setup),
+        cmocka_unit_test_setup(test_Encoder_Update_ActivityCallback, Setup),
+        cmocka_unit_test_setup(test_Encoder_Update_ActivityCallbackDrop, Setup),
+        cmocka_unit_test_setup(test_Encoder_GetStepSize, Setup)
     };
 
     if (argc >= 2)
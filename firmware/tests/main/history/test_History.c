@@ -0,0 +1,396 @@
+/**
+ * @file   test_History.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Test suite for the History module.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "common.h"
+#include "History.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define NVM_SIZE 256
+#define POLL_INTERVAL_MS 1000
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+static uint8_t nvm[NVM_SIZE];
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//INTERUPT SERVICE ROUTINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+static void Init(void)
+{
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    History_Init();
+}
+
+static int Setup(void **state)
+{
+    memset(nvm, 0, sizeof(nvm));
+    Init();
+
+    return 0;
+}
+
+static const struct history_block_t *GetBlock(size_t index)
+{
+    return (const struct history_block_t *)&nvm[HISTORY_NVM_ADDRESS +
+            index * HISTORY_BLOCK_SIZE];
+}
+
+static size_t Collect(uint8_t source, struct history_sample_t *samples_p,
+                      size_t max_length)
+{
+    struct history_iterator_t iterator;
+    size_t length = 0;
+
+    History_Begin(&iterator, source);
+    while (length < max_length && History_Next(&iterator, &samples_p[length]))
+    {
+        ++length;
+    }
+
+    return length;
+}
+
+static void AssertSample(const struct history_sample_t *sample_p,
+                         uint16_t period, int16_t value)
+{
+    assert_int_equal(sample_p->period, period);
+    assert_int_equal(sample_p->value, value);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//TESTS
+//////////////////////////////////////////////////////////////////////////
+
+static void test_History_Next_Empty(void **state)
+{
+    struct history_sample_t sample;
+    struct history_iterator_t iterator;
+
+    History_Begin(&iterator, 0);
+    assert_false(History_Next(&iterator, &sample));
+}
+
+static void test_History_Append_First(void **state)
+{
+    History_Append(3, 100, 215);
+
+    const struct history_block_t *block_p = GetBlock(0);
+    assert_int_equal(block_p->sequence, 1);
+    assert_int_equal(block_p->source, 3);
+    assert_int_equal(block_p->period, 100);
+    assert_int_equal(block_p->first, 215);
+    assert_int_equal(block_p->count, 1);
+
+    struct history_sample_t samples[2];
+    assert_int_equal(Collect(3, samples, 2), 1);
+    AssertSample(&samples[0], 100, 215);
+
+    assert_int_equal(Collect(2, samples, 2), 0);
+}
+
+static void test_History_Append_Deltas(void **state)
+{
+    const int16_t values[] = {215, 222, 214, 214, 207, 200};
+
+    for (size_t i = 0; i < ElementsIn(values); ++i)
+    {
+        History_Append(0, 10 + i, values[i]);
+    }
+
+    assert_int_equal(GetBlock(0)->count, ElementsIn(values));
+    assert_int_equal(GetBlock(1)->count, 0);
+
+    struct history_sample_t samples[8];
+    assert_int_equal(Collect(0, samples, 8), ElementsIn(values));
+    for (size_t i = 0; i < ElementsIn(values); ++i)
+    {
+        AssertSample(&samples[i], 10 + i, values[i]);
+    }
+}
+
+static void test_History_Append_DeltaOutOfRange(void **state)
+{
+    History_Append(0, 10, 200);
+    History_Append(0, 11, 208);
+    History_Append(0, 12, 199);
+
+    assert_int_equal(GetBlock(0)->count, 1);
+    assert_int_equal(GetBlock(1)->count, 1);
+    assert_int_equal(GetBlock(2)->count, 1);
+
+    struct history_sample_t samples[4];
+    assert_int_equal(Collect(0, samples, 4), 3);
+    AssertSample(&samples[0], 10, 200);
+    AssertSample(&samples[1], 11, 208);
+    AssertSample(&samples[2], 12, 199);
+}
+
+static void test_History_Append_Gap(void **state)
+{
+    History_Append(0, 10, 200);
+    History_Append(0, 11, 201);
+    History_Append(0, 14, 202);
+
+    assert_int_equal(GetBlock(0)->count, 2);
+    assert_int_equal(GetBlock(1)->period, 14);
+
+    struct history_sample_t samples[4];
+    assert_int_equal(Collect(0, samples, 4), 3);
+    AssertSample(&samples[1], 11, 201);
+    AssertSample(&samples[2], 14, 202);
+}
+
+static void test_History_Append_SamePeriod(void **state)
+{
+    History_Append(0, 10, 200);
+    History_Append(0, 10, 300);
+
+    assert_int_equal(GetBlock(0)->count, 1);
+    assert_int_equal(GetBlock(1)->count, 0);
+}
+
+static void test_History_Append_Full(void **state)
+{
+    for (size_t i = 0; i <= HISTORY_MAX_SAMPLES; ++i)
+    {
+        History_Append(0, i, -7 * (int16_t)i);
+    }
+
+    assert_int_equal(GetBlock(0)->count, HISTORY_MAX_SAMPLES);
+    assert_int_equal(GetBlock(1)->count, 1);
+
+    struct history_sample_t samples[HISTORY_MAX_SAMPLES + 2];
+    assert_int_equal(Collect(0, samples, ElementsIn(samples)),
+                     HISTORY_MAX_SAMPLES + 1);
+    for (size_t i = 0; i <= HISTORY_MAX_SAMPLES; ++i)
+    {
+        AssertSample(&samples[i], i, -7 * (int16_t)i);
+    }
+}
+
+static void test_History_Append_Wrap(void **state)
+{
+    for (size_t i = 0; i < HISTORY_NR_BLOCKS + 2; ++i)
+    {
+        History_Append(0, i, 100 * i);
+    }
+
+    assert_int_equal(GetBlock(0)->first, 100 * HISTORY_NR_BLOCKS);
+    assert_int_equal(GetBlock(1)->first, 100 * (HISTORY_NR_BLOCKS + 1));
+
+    struct history_sample_t samples[HISTORY_NR_BLOCKS + 2];
+    assert_int_equal(Collect(0, samples, ElementsIn(samples)), HISTORY_NR_BLOCKS);
+    for (size_t i = 0; i < HISTORY_NR_BLOCKS; ++i)
+    {
+        AssertSample(&samples[i], i + 2, 100 * (i + 2));
+    }
+}
+
+static void test_History_Append_Sources(void **state)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        History_Append(0, i, 200 + i);
+        History_Append(1, i, 500 - i);
+    }
+
+    assert_int_equal(GetBlock(0)->count, 4);
+    assert_int_equal(GetBlock(1)->count, 4);
+
+    struct history_sample_t samples[6];
+    assert_int_equal(Collect(1, samples, 6), 4);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        AssertSample(&samples[i], i, 500 - i);
+    }
+}
+
+static void test_History_Init_Resume(void **state)
+{
+    for (size_t i = 0; i < HISTORY_NR_BLOCKS + 2; ++i)
+    {
+        History_Append(0, i, 100 * i);
+    }
+
+    Init();
+    History_Append(0, HISTORY_NR_BLOCKS + 2, 100 * (HISTORY_NR_BLOCKS + 1) + 1);
+    History_Append(1, 0, 0);
+
+    assert_int_equal(GetBlock(1)->count, 2);
+    assert_int_equal(GetBlock(2)->source, 1);
+    assert_int_equal(GetBlock(2)->sequence, HISTORY_NR_BLOCKS + 3);
+
+    struct history_sample_t samples[HISTORY_NR_BLOCKS + 2];
+    assert_int_equal(Collect(0, samples, ElementsIn(samples)), HISTORY_NR_BLOCKS);
+    AssertSample(&samples[0], 3, 300);
+    AssertSample(&samples[HISTORY_NR_BLOCKS - 1], HISTORY_NR_BLOCKS + 2,
+                 100 * (HISTORY_NR_BLOCKS + 1) + 1);
+}
+
+static void test_History_Init_PartialWrite(void **state)
+{
+    History_Append(0, 10, 200);
+    History_Append(0, 20, 300);
+    History_Append(0, 21, 301);
+
+    //Only the first bytes of the last write reached NVM.
+    nvm[HISTORY_NVM_ADDRESS + HISTORY_BLOCK_SIZE + 6] = 1;
+
+    Init();
+
+    struct history_sample_t samples[4];
+    assert_int_equal(Collect(0, samples, 4), 1);
+    AssertSample(&samples[0], 10, 200);
+
+    History_Append(0, 22, 302);
+    assert_int_equal(GetBlock(1)->sequence, 2);
+    assert_int_equal(GetBlock(1)->count, 1);
+}
+
+static void test_History_IsSampleDue_NULL(void **state)
+{
+    expect_assert_failure(History_IsSampleDue(NULL));
+}
+
+static void test_History_IsSampleDue(void **state)
+{
+    uint16_t period = 0;
+
+    will_return(__wrap_Timer_TimeDifference, POLL_INTERVAL_MS - 1);
+    assert_false(History_IsSampleDue(&period));
+
+    will_return(__wrap_Timer_TimeDifference, POLL_INTERVAL_MS);
+    will_return(__wrap_Timer_GetMilliseconds, POLL_INTERVAL_MS);
+    will_return(__wrap_RTC_GetTimeStamp, false);
+    assert_false(History_IsSampleDue(&period));
+
+    will_return(__wrap_Timer_TimeDifference, POLL_INTERVAL_MS);
+    will_return(__wrap_Timer_GetMilliseconds, 2 * POLL_INTERVAL_MS);
+    will_return(__wrap_RTC_GetTimeStamp, true);
+    will_return(__wrap_RTC_GetTimeStamp, 7 * HISTORY_PERIOD_S + 10);
+    assert_true(History_IsSampleDue(&period));
+    assert_int_equal(period, 7);
+
+    will_return(__wrap_Timer_TimeDifference, POLL_INTERVAL_MS);
+    will_return(__wrap_Timer_GetMilliseconds, 3 * POLL_INTERVAL_MS);
+    will_return(__wrap_RTC_GetTimeStamp, true);
+    will_return(__wrap_RTC_GetTimeStamp, 8 * HISTORY_PERIOD_S - 1);
+    assert_false(History_IsSampleDue(&period));
+
+    will_return(__wrap_Timer_TimeDifference, POLL_INTERVAL_MS);
+    will_return(__wrap_Timer_GetMilliseconds, 4 * POLL_INTERVAL_MS);
+    will_return(__wrap_RTC_GetTimeStamp, true);
+    will_return(__wrap_RTC_GetTimeStamp, 8 * HISTORY_PERIOD_S);
+    assert_true(History_IsSampleDue(&period));
+    assert_int_equal(period, 8);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+bool driverNVM_Write(size_t address, const void *data_p, size_t length)
+{
+    assert_true(address + length <= sizeof(nvm));
+    memcpy(&nvm[address], data_p, length);
+    return true;
+}
+
+bool driverNVM_Read(size_t address, void *data_p, size_t length)
+{
+    assert_true(address + length <= sizeof(nvm));
+    memcpy(data_p, &nvm[address], length);
+    return true;
+}
+
+uint16_t __wrap_CRC_16(const void *data, size_t length)
+{
+    const uint8_t *data_p = data;
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        crc = (crc << 1 | crc >> 15) ^ data_p[i];
+    }
+
+    return crc;
+}
+
+int main(int argc, char *argv[])
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test_setup(test_History_Next_Empty, Setup),
+        cmocka_unit_test_setup(test_History_Append_First, Setup),
+        cmocka_unit_test_setup(test_History_Append_Deltas, Setup),
+        cmocka_unit_test_setup(test_History_Append_DeltaOutOfRange, Setup),
+        cmocka_unit_test_setup(test_History_Append_Gap, Setup),
+        cmocka_unit_test_setup(test_History_Append_SamePeriod, Setup),
+        cmocka_unit_test_setup(test_History_Append_Full, Setup),
+        cmocka_unit_test_setup(test_History_Append_Wrap, Setup),
+        cmocka_unit_test_setup(test_History_Append_Sources, Setup),
+        cmocka_unit_test_setup(test_History_Init_Resume, Setup),
+        cmocka_unit_test_setup(test_History_Init_PartialWrite, Setup),
+        cmocka_unit_test_setup(test_History_IsSampleDue_NULL, Setup),
+        cmocka_unit_test_setup(test_History_IsSampleDue, Setup)
+    };
+
+    if (argc >= 2)
+    {
+        cmocka_set_test_filter(argv[1]);
+    }
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
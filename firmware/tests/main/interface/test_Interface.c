@@ -1,7 +1,7 @@
 /**
  * @file   test_Interface.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Interface module.
  */
 
@@ -119,6 +119,7 @@ void test_InitView(void **state)
 
     assert_ptr_equal(view_ptr(0)->draw_function, MockDrawView);
     assert_ptr_equal(view_ptr(0)->context, context);
+    assert_int_equal(view_ptr(0)->refresh_period, INTERFACE_DEFAULT_REFRESH_PERIOD_MS);
     assert_null(view_ptr(0)->action_function);
     assert_null(view_ptr(0)->child);
     assert_null(view_ptr(0)->prev);
@@ -209,7 +210,6 @@ void test_RemoveView_ActiveView(void **state)
     Interface_AddView(view_ptr(0));
     Interface_AddView(view_ptr(1));
 
-    will_return(__wrap_Timer_GetMilliseconds, 0);
     Interface_NextView();
 
     Interface_RemoveView(view_ptr(1));
@@ -222,7 +222,6 @@ void test_RemoveView_ActiveViewWithParent(void **state)
     Interface_AddChild(view_ptr(0), view_ptr(1));
     Interface_AddView(view_ptr(0));
 
-    will_return(__wrap_Timer_GetMilliseconds, 0);
     Interface_ActivateView();
 
     Interface_RemoveView(view_ptr(1));
@@ -349,8 +348,6 @@ void test_NextView_NoRootView(void **state)
 
 void test_NextView_OneView(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddView(view_ptr(0));
     Interface_NextView();
 
@@ -359,8 +356,6 @@ void test_NextView_OneView(void **state)
 
 void test_NextView_TwoViews(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddView(view_ptr(0));
     Interface_AddView(view_ptr(1));
     Interface_NextView();
@@ -376,8 +371,6 @@ void test_PreviousView_NoRootView(void **state)
 
 void test_PreviousView_OneView(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddView(view_ptr(0));
     Interface_PreviousView();
 
@@ -386,9 +379,6 @@ void test_PreviousView_OneView(void **state)
 
 void test_PreviousView_TwoViews(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddView(view_ptr(0));
     Interface_AddView(view_ptr(1));
     Interface_NextView();
@@ -405,8 +395,6 @@ void test_ActivateView_NoRootView(void **state)
 
 void test_ActivateView_ActivateOnceWithNoChild(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddView(view_ptr(0));
     Interface_ActivateView();
 
@@ -415,8 +403,6 @@ void test_ActivateView_ActivateOnceWithNoChild(void **state)
 
 void test_ActivateView_ActivateOnceWithChild(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddChild(view_ptr(0), view_ptr(1));
     Interface_AddView(view_ptr(0));
     Interface_ActivateView();
@@ -426,9 +412,6 @@ void test_ActivateView_ActivateOnceWithChild(void **state)
 
 void test_ActivateView_ActivateTwiceWithChild(void **state)
 {
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-    will_return(__wrap_Timer_GetMilliseconds, 0);
-
     Interface_AddChild(view_ptr(0), view_ptr(1));
     Interface_AddView(view_ptr(0));
     Interface_ActivateView();
@@ -441,6 +424,7 @@ void test_Update_NoRootView(void **state)
 {
     will_return(__wrap_Timer_TimeDifference, 0);
     will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
 
     Interface_Update();
 }
@@ -449,6 +433,7 @@ void test_Update_ViewWithNoDrawFunction(void **state)
 {
     will_return(__wrap_Timer_TimeDifference, 0);
     will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
 
     Interface_AddView(view_ptr(0));
     Interface_Update();
@@ -465,6 +450,7 @@ void test_Update_ViewWithDrawFunction(void **state)
     Interface_InitView(view_ptr(0), MockDrawView, context);
     Interface_AddView(view_ptr(0));
 
+    expect_function_call(__wrap_libUI_Clear);
     expect_function_call(__wrap_libUI_Update);
     expect_value(MockDrawView, context, context);
     Interface_Update();
@@ -493,10 +479,12 @@ void test_Update_AutoRefresh(void **state)
     Interface_AddView(view_ptr(0));
 
     /* Expect a automatic refresh in the first and third update */
+    expect_function_call(__wrap_libUI_Clear);
     expect_function_call(__wrap_libUI_Update);
     expect_value(MockDrawView, context, context);
     Interface_Update();
     Interface_Update();
+    expect_function_call(__wrap_libUI_Clear);
     expect_function_call(__wrap_libUI_Update);
     expect_value(MockDrawView, context, context);
     Interface_Update();
@@ -528,15 +516,212 @@ void test_Update_ForcedRefresh(void **state)
      *  the third update
      */
     Interface_AddView(view_ptr(0));
+    expect_function_call(__wrap_libUI_Clear);
+    expect_function_call(__wrap_libUI_Update);
+    expect_value(MockDrawView, context, context);
+    Interface_Update();
+    Interface_Update();
+    Interface_Refresh();
+    expect_function_call(__wrap_libUI_Clear);
+    expect_function_call(__wrap_libUI_Update);
+    expect_value(MockDrawView, context, context);
+    Interface_Update();
+    Interface_Update();
+}
+
+void test_Update_RefreshPeriod(void **state)
+{
+    const uint16_t context = 8;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_SetRefreshPeriod(view_ptr(0), 1000);
+    Interface_AddView(view_ptr(0));
+
+    /* First update, the view indicator has timed out. */
+    will_return(__wrap_Timer_TimeDifference, 2000);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_function_call(__wrap_libUI_Clear);
+    expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
+    Interface_Update();
+
+    /* Expect no redraw before the refresh period has expired. */
+    will_return(__wrap_Timer_TimeDifference, 999);
+    Interface_Update();
+
+    will_return(__wrap_Timer_TimeDifference, 1001);
+    Interface_Update();
+
+    will_return(__wrap_Timer_TimeDifference, 3001);
+    will_return(__wrap_Timer_GetMilliseconds, 1001);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
+    Interface_Update();
+}
+
+void test_Update_ClearOnViewChange(void **state)
+{
+    const uint16_t context = 9;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_InitView(view_ptr(1), MockDrawView, context + 1);
+    Interface_AddView(view_ptr(0));
+    Interface_AddView(view_ptr(1));
+
+    will_return(__wrap_Timer_TimeDifference, 2000);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_function_call(__wrap_libUI_Clear);
+    expect_value(MockDrawView, context, context);
     expect_function_call(__wrap_libUI_Update);
+    Interface_Update();
+
+    /* Expect the frame to be kept when the same view is redrawn. */
+    Interface_Refresh();
+    will_return(__wrap_Timer_TimeDifference, 2000);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
     expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
+    Interface_Update();
+
+    Interface_NextView();
+
+    will_return(__wrap_Timer_TimeDifference, 2000);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_function_call(__wrap_libUI_Clear);
+    expect_value(MockDrawView, context, context + 1);
+    expect_function_call(__wrap_libUI_Update);
     Interface_Update();
+}
+
+void test_Update_DimAfterInactivity(void **state)
+{
+    const uint16_t context = 4;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_AddView(view_ptr(0));
+
+    will_return(__wrap_Timer_TimeDifference, 30001);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_value(__wrap_Display_SetBrightness, brightness, 0x08);
+    expect_function_call(__wrap_libUI_Clear);
+    expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
     Interface_Update();
+
+    /* Expect the brightness to be set only once. */
     Interface_Refresh();
+    will_return(__wrap_Timer_TimeDifference, 30100);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
+    Interface_Update();
+}
+
+void test_Update_SleepAfterInactivity(void **state)
+{
+    const uint16_t context = 5;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_AddView(view_ptr(0));
+
+    /* Expect nothing to be drawn once the display is asleep. */
+    will_return(__wrap_Timer_TimeDifference, 120001);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    expect_function_call(__wrap_Display_Off);
+    Interface_Update();
+
+    /* Expect no automatic refresh while asleep. */
+    Interface_Update();
+}
+
+void test_Update_WakeOnActivity(void **state)
+{
+    const uint16_t context = 6;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_InitView(view_ptr(1), MockDrawView, context + 1);
+    Interface_AddView(view_ptr(0));
+    Interface_AddView(view_ptr(1));
+
+    will_return(__wrap_Timer_TimeDifference, 120001);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    expect_function_call(__wrap_Display_Off);
+    Interface_Update();
+
+    /* Expect the first event to only wake the display. */
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    expect_function_call(__wrap_Display_On);
+    expect_value(__wrap_Display_SetBrightness, brightness, 0x80);
+    assert_false(Interface_RegisterActivity());
+
+    will_return(__wrap_Timer_TimeDifference, 0);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_function_call(__wrap_libUI_Clear);
+    expect_value(MockDrawView, context, context);
     expect_function_call(__wrap_libUI_Update);
+    Interface_Update();
+
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    assert_true(Interface_RegisterActivity());
+}
+
+void test_Update_RestoreBrightnessOnActivity(void **state)
+{
+    const uint16_t context = 7;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_InitView(view_ptr(1), MockDrawView, context + 1);
+    Interface_AddView(view_ptr(0));
+    Interface_AddView(view_ptr(1));
+
+    will_return(__wrap_Timer_TimeDifference, 30001);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_value(__wrap_Display_SetBrightness, brightness, 0x08);
+    expect_function_call(__wrap_libUI_Clear);
     expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
     Interface_Update();
+
+    /* Expect the event to be handled while the display is dimmed. */
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    expect_value(__wrap_Display_SetBrightness, brightness, 0x80);
+    assert_true(Interface_RegisterActivity());
+}
+
+void test_Update_NoDimDuringSetTime(void **state)
+{
+    const uint16_t context = 8;
+    Interface_InitView(view_ptr(0), MockDrawView, context);
+    Interface_AddView(view_ptr(0));
+
+    will_return(__wrap_Timer_TimeDifference, 20000);
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    will_return(__wrap_Timer_TimeDifference, 0);
+    expect_function_call(__wrap_libUI_Clear);
+    expect_value(MockDrawView, context, context);
+    expect_function_call(__wrap_libUI_Update);
     Interface_Update();
+
+    /*
+     * The set time view replaces the encoder callbacks, the edits only
+     * reach the interface through the encoder activity callback. Expect
+     * the display to stay bright as long as the edits keep coming.
+     */
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        will_return(__wrap_Timer_GetMilliseconds, 20000 * (i + 1));
+        assert_true(Interface_RegisterActivity());
+
+        will_return(__wrap_Timer_TimeDifference, 20000);
+        will_return(__wrap_Timer_GetMilliseconds, 0);
+        will_return(__wrap_Timer_TimeDifference, 0);
+        expect_value(MockDrawView, context, context);
+        expect_function_call(__wrap_libUI_Update);
+        Interface_Update();
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -587,6 +772,13 @@ int main(int argc, char *argv[])
         cmocka_unit_test_setup(test_Update_ViewWithDrawFunction, Setup),
         cmocka_unit_test_setup(test_Update_AutoRefresh, Setup),
         cmocka_unit_test_setup(test_Update_ForcedRefresh, Setup),
+        cmocka_unit_test_setup(test_Update_RefreshPeriod, Setup),
+        cmocka_unit_test_setup(test_Update_ClearOnViewChange, Setup),
+        cmocka_unit_test_setup(test_Update_DimAfterInactivity, Setup),
+        cmocka_unit_test_setup(test_Update_SleepAfterInactivity, Setup),
+        cmocka_unit_test_setup(test_Update_WakeOnActivity, Setup),
+        cmocka_unit_test_setup(test_Update_RestoreBrightnessOnActivity, Setup),
+        cmocka_unit_test_setup(test_Update_NoDimDuringSetTime, Setup),
     };
 
     if (argc >= 2)
@@ -1,7 +1,7 @@
 /**
  * @file   test_Interface.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-09-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Interface module.
  */
 
@@ -76,5 +76,11 @@ void test_Update_ViewWithNoDrawFunction(void **state);
 void test_Update_ViewWithDrawFunction(void **state);
 void test_Update_AutoRefresh(void **state);
 void test_Update_ForcedRefresh(void **state);
+void test_Update_RefreshPeriod(void **state);
+void test_Update_ClearOnViewChange(void **state);
+void test_Update_DimAfterInactivity(void **state);
+void test_Update_SleepAfterInactivity(void **state);
+void test_Update_WakeOnActivity(void **state);
+void test_Update_RestoreBrightnessOnActivity(void **state);
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   test_PacketHandler.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the Packet handler module.
  */
 
@@ -107,7 +107,9 @@ static void test_PacketHandler_HandleReadingPacket_RTCFailure(void **state)
     expect_function_call(__wrap_Node_ReportActivity);
     expect_any(__wrap_Node_SetRSSI, rssi);
     expect_function_call(__wrap_Node_Update);
+    expect_function_call(__wrap_Interface_Refresh);
 
+    expect_value(__wrap_Channel_Announce, target, source_id);
     will_return_always(__wrap_RTC_GetCurrentTime, false);
     expect_value(__wrap_ErrorHandler_LogError, code, RTC_FAIL);
 
@@ -128,7 +130,9 @@ static void test_PacketHandler_HandleReadingPacket(void **state)
     expect_function_call(__wrap_Node_ReportActivity);
     expect_any(__wrap_Node_SetRSSI, rssi);
     expect_function_call(__wrap_Node_Update);
+    expect_function_call(__wrap_Interface_Refresh);
 
+    expect_value(__wrap_Channel_Announce, target, source_id);
     will_return_always(__wrap_RTC_GetCurrentTime, true);
     expect_value(__wrap_Com_Send, target, source_id);
     expect_value(__wrap_Com_Send, packet_type, COM_PACKET_TYPE_TIME);
@@ -1,7 +1,7 @@
 /**
  * @file   test_Sensor.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-01-16 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Test suite for the sensor module.
  */
 
@@ -36,12 +36,15 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "test_Sensor.h"
 #include "Sensor.h"
+#include "Trend.h"
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
 #define MAX_NUMBER_OF_SENSORS 9
+#define FLUSH_INTERVAL_MS 60000
+#define PERIOD_MS 100
 
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
@@ -57,6 +60,7 @@ struct mock_sensor_t
 //////////////////////////////////////////////////////////////////////////
 
 struct mock_sensor_t mock_sensors[MAX_NUMBER_OF_SENSORS];
+static size_t crc_length;
 
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
@@ -70,11 +74,12 @@ struct mock_sensor_t mock_sensors[MAX_NUMBER_OF_SENSORS];
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
 
-static int Setup(void **state)
+static int SetupWithHistory(void **state)
 {
     for (size_t i = 0; i < MAX_NUMBER_OF_SENSORS; ++i)
     {
         mock_sensors[i] = (struct mock_sensor_t) {0};
+        mock_sensors[i].base.period_ms = PERIOD_MS;
     }
 
     Sensor_Init();
@@ -82,11 +87,24 @@ static int Setup(void **state)
     return 0;
 }
 
+static int Setup(void **state)
+{
+    will_return_maybe(__wrap_History_IsSampleDue, false);
+
+    return SetupWithHistory(state);
+}
+
 static struct sensor_t *GetMockSensor(size_t index)
 {
     return (struct sensor_t *)&mock_sensors[index];
 }
 
+static void UpdateAt(uint32_t time_ms)
+{
+    will_return(__wrap_Timer_GetMilliseconds, time_ms);
+    Sensor_Update();
+}
+
 static void SetSensorValidFlag(struct sensor_t *sensor_p, bool flag)
 {
     sensor_p->valid = flag;
@@ -148,6 +166,13 @@ static void test_Sensor_Register_Full(void **state)
     expect_assert_failure(Sensor_Register(GetMockSensor(index)));
 }
 
+static void test_Sensor_Register_NoPeriod(void **state)
+{
+    GetMockSensor(0)->period_ms = 0;
+
+    expect_assert_failure(Sensor_Register(GetMockSensor(0)));
+}
+
 static void test_Sensor_Register(void **state)
 {
     will_return_maybe(__wrap_CRC_16, 0);
@@ -157,6 +182,18 @@ static void test_Sensor_Register(void **state)
     //TODO: Add test
 }
 
+/**
+ * Expect the CRC to cover the whole record except the CRC itself.
+ */
+static void test_Sensor_Register_CRCCoverage(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    Sensor_Register(GetMockSensor(0));
+
+    assert_int_equal(crc_length, 2 * sizeof(int16_t) + sizeof(bool));
+}
+
 static void test_Sensor_Register_CRCError(void **state)
 {
     /**
@@ -185,24 +222,210 @@ static void test_Sensor_Update(void **state)
     will_return_maybe(__wrap_CRC_16, 0);
 
     /* Nothing should happen here since no sensors are registered. */
-    Sensor_Update();
+    UpdateAt(0);
 
     /**
      * Register a sensor with no update function. Since the sensor values are
      * invalid nothing should happen.
      */
     Sensor_Register(GetMockSensor(0));
-    Sensor_Update();
+    UpdateAt(0);
 
     expect_function_call(BasicMockUpdate);
     GetMockSensor(1)->Update = BasicMockUpdate;
     Sensor_Register(GetMockSensor(1));
-    Sensor_Update();
+    UpdateAt(0);
 
+    /* The first change starts the flush timer. */
     expect_function_call(BasicMockUpdate);
-    expect_function_call(__wrap_driverNVM_Write);
     SetSensorValidFlag(GetMockSensor(1), true);
-    Sensor_Update();
+    UpdateAt(PERIOD_MS);
+
+    /* Changed statistics are written back when the flush interval expires. */
+    expect_function_call(BasicMockUpdate);
+    expect_function_call(__wrap_driverNVM_Write);
+    UpdateAt(PERIOD_MS + FLUSH_INTERVAL_MS);
+}
+
+static void test_Sensor_Update_Schedule(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    GetMockSensor(0)->Update = BasicMockUpdate;
+    GetMockSensor(1)->Update = BasicMockUpdate;
+    GetMockSensor(1)->period_ms = 3 * PERIOD_MS;
+    Sensor_Register(GetMockSensor(1));
+    Sensor_Register(GetMockSensor(0));
+
+    /* Both sensors are due directly after registration. */
+    expect_function_calls(BasicMockUpdate, 2);
+    UpdateAt(0);
+
+    /* Only sensors with an expired period are updated. */
+    UpdateAt(PERIOD_MS - 1);
+
+    expect_function_calls(BasicMockUpdate, 1);
+    UpdateAt(PERIOD_MS);
+
+    expect_function_calls(BasicMockUpdate, 1);
+    UpdateAt(2 * PERIOD_MS);
+
+    expect_function_calls(BasicMockUpdate, 2);
+    UpdateAt(3 * PERIOD_MS);
+
+    /* Missed periods are not caught up. */
+    expect_function_calls(BasicMockUpdate, 2);
+    UpdateAt(10 * PERIOD_MS + 5);
+
+    UpdateAt(11 * PERIOD_MS + 4);
+
+    expect_function_calls(BasicMockUpdate, 1);
+    UpdateAt(11 * PERIOD_MS + 5);
+}
+
+static void test_Sensor_Update_TimerWrap(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    /* Registered sensors are due at the time of the latest update. */
+    UpdateAt(UINT32_MAX - PERIOD_MS / 2);
+
+    GetMockSensor(0)->Update = BasicMockUpdate;
+    Sensor_Register(GetMockSensor(0));
+
+    expect_function_call(BasicMockUpdate);
+    UpdateAt(UINT32_MAX - PERIOD_MS / 2);
+
+    UpdateAt(UINT32_MAX);
+
+    expect_function_call(BasicMockUpdate);
+    UpdateAt(PERIOD_MS / 2);
+}
+
+static void test_Sensor_GetTimeToDeadline(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    assert_int_equal(Sensor_GetTimeToDeadline(), UINT32_MAX);
+
+    GetMockSensor(1)->period_ms = 3 * PERIOD_MS;
+    Sensor_Register(GetMockSensor(0));
+    Sensor_Register(GetMockSensor(1));
+
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    assert_int_equal(Sensor_GetTimeToDeadline(), 0);
+
+    UpdateAt(0);
+
+    will_return(__wrap_Timer_GetMilliseconds, 10);
+    assert_int_equal(Sensor_GetTimeToDeadline(), PERIOD_MS - 10);
+
+    UpdateAt(PERIOD_MS);
+    UpdateAt(2 * PERIOD_MS);
+
+    will_return(__wrap_Timer_GetMilliseconds, 2 * PERIOD_MS + 50);
+    assert_int_equal(Sensor_GetTimeToDeadline(), PERIOD_MS - 50);
+
+    /* Zero when a sensor is overdue. */
+    will_return(__wrap_Timer_GetMilliseconds, 4 * PERIOD_MS);
+    assert_int_equal(Sensor_GetTimeToDeadline(), 0);
+}
+
+static void test_Sensor_Update_WriteBack(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    GetMockSensor(0)->Update = MockUpdate;
+    Sensor_Register(GetMockSensor(0));
+
+    /* The first change starts the flush timer. */
+    will_return(MockUpdate, 16);
+    will_return(MockUpdate, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(0);
+
+    /* Later changes don't restart the timer. */
+    will_return(MockUpdate, 20);
+    will_return(MockUpdate, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(FLUSH_INTERVAL_MS - PERIOD_MS);
+
+    will_return(MockUpdate, 18);
+    will_return(MockUpdate, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    expect_function_call(__wrap_driverNVM_Write);
+    UpdateAt(FLUSH_INTERVAL_MS);
+
+    /* Nothing to write back when max and min are unchanged. */
+    will_return(MockUpdate, 17);
+    will_return(MockUpdate, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(2 * FLUSH_INTERVAL_MS);
+}
+
+static void test_Sensor_Flush(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        GetMockSensor(i)->Update = MockUpdate;
+        Sensor_Register(GetMockSensor(i));
+    }
+
+    will_return(MockUpdate, 1);
+    will_return(MockUpdate, true);
+    will_return(MockUpdate, 0);
+    will_return(MockUpdate, false);
+    will_return(MockUpdate, 3);
+    will_return(MockUpdate, true);
+    expect_function_calls(__wrap_Interface_Refresh, 2);
+    UpdateAt(0);
+
+    expect_function_calls(__wrap_driverNVM_Write, 2);
+    Sensor_Flush();
+
+    /* All records are clean after a flush. */
+    Sensor_Flush();
+}
+
+static void test_Sensor_Update_History(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        GetMockSensor(i)->Update = MockUpdate;
+        Sensor_Register(GetMockSensor(i));
+    }
+
+    will_return(MockUpdate, 1);
+    will_return(MockUpdate, true);
+    will_return(MockUpdate, 0);
+    will_return(MockUpdate, false);
+    will_return(MockUpdate, 3);
+    will_return(MockUpdate, true);
+    expect_function_calls(__wrap_Interface_Refresh, 2);
+
+    /* Invalid sensors are left out of the history. */
+    will_return(__wrap_History_IsSampleDue, true);
+    will_return(__wrap_History_IsSampleDue, 42);
+    expect_value(__wrap_History_Append, source, 0);
+    expect_value(__wrap_History_Append, period, 42);
+    expect_value(__wrap_History_Append, value, 1);
+    expect_value(__wrap_History_Append, source, 2);
+    expect_value(__wrap_History_Append, period, 42);
+    expect_value(__wrap_History_Append, value, 3);
+    UpdateAt(0);
+
+    will_return(MockUpdate, 1);
+    will_return(MockUpdate, true);
+    will_return(MockUpdate, 0);
+    will_return(MockUpdate, false);
+    will_return(MockUpdate, 3);
+    will_return(MockUpdate, true);
+    will_return(__wrap_History_IsSampleDue, false);
+    UpdateAt(PERIOD_MS);
 }
 
 /* TODO: Refactor */
@@ -212,7 +435,6 @@ static void test_Sensor_Update_Statistics(void **state)
      * Trigger a CRC error so that the values from SRAM are not used.
      */
     will_return_maybe(__wrap_CRC_16, 1);
-    ignore_function_calls(__wrap_driverNVM_Write);
 
     GetMockSensor(0)->Update = MockUpdate;
     Sensor_Register(GetMockSensor(0));
@@ -221,7 +443,8 @@ static void test_Sensor_Update_Statistics(void **state)
     will_return(MockUpdate, expected_value);
     will_return(MockUpdate, true);
 
-    Sensor_Update();
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(0);
 
     int16_t value;
     assert_true(Sensor_GetValue(GetMockSensor(0), &value));
@@ -235,7 +458,8 @@ static void test_Sensor_Update_Statistics(void **state)
     will_return(MockUpdate, expected_value);
     will_return(MockUpdate, true);
 
-    Sensor_Update();
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(PERIOD_MS);
 
     assert_true(Sensor_GetValue(GetMockSensor(0), &value));
     assert_int_equal(value, expected_value);
@@ -248,7 +472,8 @@ static void test_Sensor_Update_Statistics(void **state)
     will_return(MockUpdate, expected_value);
     will_return(MockUpdate, true);
 
-    Sensor_Update();
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(2 * PERIOD_MS);
 
     assert_true(Sensor_GetValue(GetMockSensor(0), &value));
     assert_int_equal(value, expected_value);
@@ -260,13 +485,76 @@ static void test_Sensor_Update_Statistics(void **state)
     will_return(MockUpdate, expected_value);
     will_return(MockUpdate, false);
 
-    Sensor_Update();
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(3 * PERIOD_MS);
 
     assert_false(Sensor_GetValue(GetMockSensor(0), &value));
     assert_true(Sensor_GetMaxValue(GetMockSensor(0), &value));
     assert_true(Sensor_GetMinValue(GetMockSensor(0), &value));
 }
 
+static void test_Sensor_Update_Invalidate(void **state)
+{
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    GetMockSensor(0)->Update = MockUpdate;
+    Sensor_Register(GetMockSensor(0));
+
+    will_return(MockUpdate, 16);
+    will_return(MockUpdate, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(0);
+
+    /* Expect no invalidation when the value is unchanged. */
+    will_return(MockUpdate, 16);
+    will_return(MockUpdate, true);
+    UpdateAt(PERIOD_MS);
+}
+
+static void test_Sensor_Update_Trend(void **state)
+{
+    struct trend_t trend;
+
+    will_return_maybe(__wrap_CRC_16, 0);
+
+    GetMockSensor(0)->Update = MockUpdate;
+    Sensor_Register(GetMockSensor(0));
+    Sensor_SetTrend(GetMockSensor(0), &trend);
+
+    will_return(MockUpdate, 16);
+    will_return(MockUpdate, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    expect_value(__wrap_Trend_Update, self_p, &trend);
+    expect_value(__wrap_Trend_Update, value, 16);
+    expect_value(__wrap_Trend_Update, valid, true);
+    will_return(__wrap_Trend_Update, false);
+    UpdateAt(0);
+
+    /* Expect an invalidation when the trend stores a new sample. */
+    will_return(MockUpdate, 16);
+    will_return(MockUpdate, false);
+    expect_function_call(__wrap_Interface_Refresh);
+    expect_value(__wrap_Trend_Update, self_p, &trend);
+    expect_value(__wrap_Trend_Update, value, 16);
+    expect_value(__wrap_Trend_Update, valid, false);
+    will_return(__wrap_Trend_Update, true);
+    expect_function_call(__wrap_Interface_Refresh);
+    UpdateAt(PERIOD_MS);
+
+    Sensor_SetTrend(GetMockSensor(0), NULL);
+
+    will_return(MockUpdate, 16);
+    will_return(MockUpdate, false);
+    UpdateAt(2 * PERIOD_MS);
+}
+
+static void test_Sensor_SetTrend_NULL(void **state)
+{
+    struct trend_t trend;
+
+    expect_assert_failure(Sensor_SetTrend(NULL, &trend));
+}
+
 static void test_Sensor_IsValid(void **state)
 {
     SetSensorValidFlag(GetMockSensor(0), false);
@@ -432,6 +720,7 @@ static void test_Sensor_Reset(void **state)
 
 uint16_t __wrap_CRC_16(const void *data, size_t length)
 {
+    crc_length = length;
     return mock_type(uint16_t);
 }
 
@@ -441,10 +730,21 @@ int main(int argc, char *argv[])
     {
         cmocka_unit_test_setup(test_Sensor_Register_NULL, Setup),
         cmocka_unit_test_setup(test_Sensor_Register_Full, Setup),
+        cmocka_unit_test_setup(test_Sensor_Register_NoPeriod, Setup),
         cmocka_unit_test_setup(test_Sensor_Register, Setup),
         cmocka_unit_test_setup(test_Sensor_Register_CRCError, Setup),
+        cmocka_unit_test_setup(test_Sensor_Register_CRCCoverage, Setup),
         cmocka_unit_test_setup(test_Sensor_Update, Setup),
+        cmocka_unit_test_setup(test_Sensor_Update_Schedule, Setup),
+        cmocka_unit_test_setup(test_Sensor_Update_TimerWrap, Setup),
+        cmocka_unit_test_setup(test_Sensor_GetTimeToDeadline, Setup),
         cmocka_unit_test_setup(test_Sensor_Update_Statistics, Setup),
+        cmocka_unit_test_setup(test_Sensor_Update_Invalidate, Setup),
+        cmocka_unit_test_setup(test_Sensor_Update_Trend, Setup),
+        cmocka_unit_test_setup(test_Sensor_Update_WriteBack, Setup),
+        cmocka_unit_test_setup(test_Sensor_Update_History, SetupWithHistory),
+        cmocka_unit_test_setup(test_Sensor_Flush, Setup),
+        cmocka_unit_test_setup(test_Sensor_SetTrend_NULL, Setup),
         cmocka_unit_test_setup(test_Sensor_IsValid, Setup),
         cmocka_unit_test_setup(test_Sensor_IsStatisticsValid, Setup),
         cmocka_unit_test_setup(test_Sensor_GetValue_NULL, Setup),
@@ -0,0 +1,204 @@
+/**
+ * @file   test_Trend.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Test suite for the Trend module.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "Trend.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define OFFSET      -400
+#define DIVISOR     5
+#define PERIOD_S    10
+#define PERIOD_MS   (PERIOD_S * 1000UL)
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+static struct trend_t trend;
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//INTERUPT SERVICE ROUTINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+static int Setup(void **state)
+{
+    will_return(__wrap_Timer_GetMilliseconds, 0);
+    Trend_Init(&trend, OFFSET, DIVISOR, PERIOD_S);
+
+    return 0;
+}
+
+static bool UpdateAndExpire(int16_t value, bool valid)
+{
+    will_return(__wrap_Timer_TimeDifference, PERIOD_MS);
+    return Trend_Update(&trend, value, valid);
+}
+
+static uint8_t GetNewestSample(void)
+{
+    uint8_t first;
+    const uint8_t *samples_p = Trend_GetSamples(&trend, &first);
+
+    return samples_p[(first + TREND_NR_SAMPLES - 1) % TREND_NR_SAMPLES];
+}
+
+//////////////////////////////////////////////////////////////////////////
+//TESTS
+//////////////////////////////////////////////////////////////////////////
+
+static void test_Trend_Init_NULL(void **state)
+{
+    expect_assert_failure(Trend_Init(NULL, OFFSET, DIVISOR, PERIOD_S));
+    expect_assert_failure(Trend_Init(&trend, OFFSET, 0, PERIOD_S));
+    expect_assert_failure(Trend_Init(&trend, OFFSET, DIVISOR, 0));
+}
+
+static void test_Trend_Init(void **state)
+{
+    uint8_t first;
+    const uint8_t *samples_p = Trend_GetSamples(&trend, &first);
+
+    assert_int_equal(first, 0);
+    for (size_t i = 0; i < TREND_NR_SAMPLES; ++i)
+    {
+        assert_int_equal(samples_p[i], TREND_NO_SAMPLE);
+    }
+
+    int16_t min;
+    int16_t max;
+    assert_false(Trend_GetRange(&trend, &min, &max));
+}
+
+static void test_Trend_Update_Average(void **state)
+{
+    will_return(__wrap_Timer_TimeDifference, PERIOD_MS - 1);
+    assert_false(Trend_Update(&trend, 200, true));
+
+    will_return(__wrap_Timer_TimeDifference, PERIOD_MS - 1);
+    assert_false(Trend_Update(&trend, 999, false));
+
+    assert_true(UpdateAndExpire(220, true));
+    assert_int_equal(GetNewestSample(), (210 - OFFSET) / DIVISOR);
+
+    /* The accumulator is restarted for each period. */
+    assert_true(UpdateAndExpire(-100, true));
+    assert_int_equal(GetNewestSample(), (-100 - OFFSET) / DIVISOR);
+}
+
+static void test_Trend_Update_Gap(void **state)
+{
+    assert_true(UpdateAndExpire(0, false));
+    assert_int_equal(GetNewestSample(), TREND_NO_SAMPLE);
+}
+
+static void test_Trend_Update_Saturate(void **state)
+{
+    assert_true(UpdateAndExpire(INT16_MIN, true));
+    assert_int_equal(GetNewestSample(), 0);
+
+    assert_true(UpdateAndExpire(INT16_MAX, true));
+    assert_int_equal(GetNewestSample(), TREND_MAX_SAMPLE);
+}
+
+static void test_Trend_Update_Wrap(void **state)
+{
+    for (size_t i = 0; i < TREND_NR_SAMPLES + 2; ++i)
+    {
+        assert_true(UpdateAndExpire(OFFSET + (int16_t)i * DIVISOR, true));
+    }
+
+    uint8_t first;
+    const uint8_t *samples_p = Trend_GetSamples(&trend, &first);
+
+    assert_int_equal(first, 2);
+    for (size_t i = 0; i < TREND_NR_SAMPLES; ++i)
+    {
+        assert_int_equal(samples_p[(first + i) % TREND_NR_SAMPLES], i + 2);
+    }
+}
+
+static void test_Trend_GetRange(void **state)
+{
+    assert_true(UpdateAndExpire(215, true));
+    assert_true(UpdateAndExpire(0, false));
+    assert_true(UpdateAndExpire(-52, true));
+    assert_true(UpdateAndExpire(100, true));
+
+    int16_t min;
+    int16_t max;
+    assert_true(Trend_GetRange(&trend, &min, &max));
+    assert_int_equal(min, -55);
+    assert_int_equal(max, 215);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test_setup(test_Trend_Init_NULL, Setup),
+        cmocka_unit_test_setup(test_Trend_Init, Setup),
+        cmocka_unit_test_setup(test_Trend_Update_Average, Setup),
+        cmocka_unit_test_setup(test_Trend_Update_Gap, Setup),
+        cmocka_unit_test_setup(test_Trend_Update_Saturate, Setup),
+        cmocka_unit_test_setup(test_Trend_Update_Wrap, Setup),
+        cmocka_unit_test_setup(test_Trend_GetRange, Setup)
+    };
+
+    if (argc >= 2)
+    {
+        cmocka_set_test_filter(argv[1]);
+    }
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
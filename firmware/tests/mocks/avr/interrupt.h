@@ -1,7 +1,7 @@
 /**
  * @file   interrupt.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-13 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Fake interrupt header.
  */
 
@@ -33,6 +33,8 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //DEFINES
 //////////////////////////////////////////////////////////////////////////
 
+#define ISR(vector) void vector(void)
+
 //////////////////////////////////////////////////////////////////////////
 //TYPE DEFINITIONS
 //////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,67 @@
+/**
+ * @file   io.h
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Fake io header.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FAKEIO_H_
+#define FAKEIO_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+#define SPIE 7
+#define SPE 6
+#define MSTR 4
+#define CPOL 3
+#define CPHA 2
+#define SPIF 7
+#define SPI2X 0
+#define SREG_I 7
+
+#define DDB2 2
+#define DDB3 3
+#define DDB4 4
+#define DDB5 5
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+/* Fake registers, defined by the test suite using them. */
+extern volatile uint8_t SREG;
+extern volatile uint8_t DDRB;
+extern volatile uint8_t SPCR;
+extern volatile uint8_t SPSR;
+extern volatile uint8_t SPDR;
+
+#endif
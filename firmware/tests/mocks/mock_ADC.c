@@ -1,7 +1,7 @@
 /**
  * @file   mock_ADC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the ADC module.
  */
 
@@ -83,6 +83,36 @@ void __wrap_ADC_Convert(struct adc_channel_t *channel,
     }
 }
 
+void __wrap_ADC_InitScanChannel(struct adc_channel_t *channel,
+                                uint8_t index,
+                                uint8_t extra_bits,
+                                driver_adc_callback_t callback)
+{
+    assert_non_null(channel);
+    assert_true(extra_bits <= ADC_MAX_EXTRA_BITS);
+    check_expected(index);
+}
+
+void __wrap_ADC_StartScan(void)
+{
+    function_called();
+}
+
+bool __wrap_ADC_GetScanResult(struct adc_channel_t *channel, uint16_t *value)
+{
+    assert_non_null(channel);
+    assert_non_null(value);
+
+    bool status = mock_type(bool);
+
+    if (status)
+    {
+        *value = mock_type(uint16_t);
+    }
+
+    return status;
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
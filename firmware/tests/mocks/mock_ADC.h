@@ -1,7 +1,7 @@
 /**
  * @file   mock_ADC.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-10-11 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the ADC module.
  */
 
@@ -49,5 +49,11 @@ void __wrap_ADC_Convert(struct adc_channel_t *channel,
                         uint16_t *samples,
                         size_t length
                        );
+void __wrap_ADC_InitScanChannel(struct adc_channel_t *channel,
+                                uint8_t index,
+                                uint8_t extra_bits,
+                                driver_adc_callback_t callback);
+void __wrap_ADC_StartScan(void);
+bool __wrap_ADC_GetScanResult(struct adc_channel_t *channel, uint16_t *value);
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   mock_Display.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for Display module.
  */
 
@@ -99,6 +99,47 @@ void __wrap_Display_SetPixel(uint8_t x, uint8_t y)
     check_expected(y);
 }
 
+void __wrap_Display_DrawBitmap_P(uint8_t x, int8_t y, const uint8_t *data_p,
+                                 uint8_t width, uint8_t height)
+{
+    check_expected(x);
+    check_expected(y);
+    check_expected(data_p);
+    check_expected(width);
+    check_expected(height);
+}
+
+void __wrap_Display_DrawColumn(uint8_t x, int8_t y, uint16_t data)
+{
+    check_expected(x);
+    check_expected(y);
+    check_expected(data);
+}
+
+void __wrap_Display_FillRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    check_expected(x);
+    check_expected(y);
+    check_expected(width);
+    check_expected(height);
+}
+
+void __wrap_Display_ClearRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    check_expected(x);
+    check_expected(y);
+    check_expected(width);
+    check_expected(height);
+}
+
+void __wrap_Display_InvertRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+{
+    check_expected(x);
+    check_expected(y);
+    check_expected(width);
+    check_expected(height);
+}
+
 void __wrap_Display_SetBrightness(uint8_t brightness)
 {
     check_expected(brightness);
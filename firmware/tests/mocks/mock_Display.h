@@ -1,7 +1,7 @@
 /**
  * @file   mock_Display.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for Display module.
  */
 
@@ -52,6 +52,12 @@ void __wrap_Display_ClearVRAM(void);
 void __wrap_Display_Reset(void);
 void __wrap_Display_Flush(void);
 void __wrap_Display_SetPixel(uint8_t x, uint8_t y);
+void __wrap_Display_DrawBitmap_P(uint8_t x, int8_t y, const uint8_t *data_p,
+                                 uint8_t width, uint8_t height);
+void __wrap_Display_DrawColumn(uint8_t x, int8_t y, uint16_t data);
+void __wrap_Display_FillRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+void __wrap_Display_ClearRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+void __wrap_Display_InvertRectangle(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
 void __wrap_Display_SetBrightness(uint8_t brightness);
 void __wrap_Display_Rotate(bool state);
 
@@ -1,7 +1,7 @@
 /**
  * @file   mock_FIFO.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the FIFO module.
  */
 
@@ -73,6 +73,21 @@ bool __wrap_FIFO_Peek(struct fifo_t *self_p, void *item_p)
     mock_type(bool);
 }
 
+bool __wrap_FIFO_Discard(struct fifo_t *self_p)
+{
+    mock_type(bool);
+}
+
+void *__wrap_FIFO_At(struct fifo_t *self_p, uint8_t index)
+{
+    mock_ptr_type(void *);
+}
+
+uint8_t __wrap_FIFO_Count(struct fifo_t *self_p)
+{
+    mock_type(uint8_t);
+}
+
 bool __wrap_FIFO_IsFull(struct fifo_t *self_p)
 {
     mock_type(bool);
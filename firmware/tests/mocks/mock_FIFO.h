@@ -1,7 +1,7 @@
 /**
  * @file   mock_FIFO.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-03-10 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the FIFO module.
  */
 
@@ -48,6 +48,9 @@ bool __wrap_FIFO_IsEmpty(struct fifo_t *self_p);
 void __wrap_FIFO_Clear(struct fifo_t *self_p);
 bool __wrap_FIFO_Pop(struct fifo_t *self_p, void *item_p);
 bool __wrap_FIFO_Peek(struct fifo_t *self_p, void *item_p);
+bool __wrap_FIFO_Discard(struct fifo_t *self_p);
+void *__wrap_FIFO_At(struct fifo_t *self_p, uint8_t index);
+uint8_t __wrap_FIFO_Count(struct fifo_t *self_p);
 bool __wrap_FIFO_IsFull(struct fifo_t *self_p);
 bool __wrap_FIFO_Push(struct fifo_t *self_p, void *item_p);
 
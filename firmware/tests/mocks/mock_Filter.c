@@ -1,7 +1,7 @@
 /**
  * @file   mock_Filter.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the filter module.
  */
 
@@ -76,6 +76,30 @@ int16_t __wrap_Filter_Output(const struct filter_t *self_p)
     mock_type(int16_t);
 }
 
+bool __wrap_Filter_ShiftIsInitialized(const struct filter_shift_t *self_p)
+{
+    assert_non_null(self_p);
+    return mock_type(bool);
+}
+
+void __wrap_Filter_ShiftInit(struct filter_shift_t *self_p, int16_t initial_value, uint8_t shift)
+{
+    assert_non_null(self_p);
+    check_expected(initial_value);
+}
+
+void __wrap_Filter_ShiftProcess(struct filter_shift_t *self_p, int16_t sample)
+{
+    assert_non_null(self_p);
+    function_called();
+}
+
+int16_t __wrap_Filter_ShiftOutput(const struct filter_shift_t *self_p)
+{
+    assert_non_null(self_p);
+    return mock_type(int16_t);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -1,7 +1,7 @@
 /**
  * @file   mock_RTC.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the RTC module.
  */
 
@@ -71,7 +71,14 @@ bool __wrap_RTC_SetCurrentTime(const struct time_t *time_p)
 
 bool __wrap_RTC_GetTimeStamp(uint32_t *timestamp_p)
 {
-    mock_type(bool);
+    const bool status = mock_type(bool);
+
+    if (status)
+    {
+        *timestamp_p = mock_type(uint32_t);
+    }
+
+    return status;
 }
 
 //////////////////////////////////////////////////////////////////////////
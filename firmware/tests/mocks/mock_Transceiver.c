@@ -1,7 +1,7 @@
 /**
  * @file   mock_Transceiver.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the Transceiver module.
  */
 
@@ -66,9 +66,10 @@ bool __wrap_Transceiver_ReceivePacket(packet_frame_type *packet)
     mock_type(bool);
 }
 
-bool __wrap_Transceiver_SendPacket(uint8_t target, packet_content_type *content)
+bool __wrap_Transceiver_SendPacket(uint8_t target, packet_content_type *content, transceiver_priority_type priority)
 {
     check_expected(target);
+    check_expected(priority);
 
     packet_content_type *mock_packet_content_p;
     mock_packet_content_p = mock_ptr_type(packet_content_type *);
@@ -93,6 +94,24 @@ void __wrap_Transceiver_Update(void)
 {
 }
 
+bool __wrap_Transceiver_SetChannel(uint8_t channel)
+{
+    check_expected(channel);
+    return mock_type(bool);
+}
+
+uint8_t __wrap_Transceiver_GetChannel(void)
+{
+    return mock_type(uint8_t);
+}
+
+bool __wrap_Transceiver_MeasureRSSI(uint8_t channel, int8_t *rssi_p)
+{
+    check_expected(channel);
+    *rssi_p = mock_type(int8_t);
+    return mock_type(bool);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -1,7 +1,7 @@
 /**
  * @file   mock_Transceiver.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-10-20 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the Transceiver module.
  */
 
@@ -45,9 +45,12 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 bool __wrap_Transceiver_ReceivePacket(packet_frame_type *packet);
-bool __wrap_Transceiver_SendPacket(uint8_t target, packet_content_type *content);
+bool __wrap_Transceiver_SendPacket(uint8_t target, packet_content_type *content, transceiver_priority_type priority);
 void __wrap_Transceiver_EventHandler(const event_t *event);
 void __wrap_Transceiver_Init(void);
 void __wrap_Transceiver_Update(void);
+bool __wrap_Transceiver_SetChannel(uint8_t channel);
+uint8_t __wrap_Transceiver_GetChannel(void);
+bool __wrap_Transceiver_MeasureRSSI(uint8_t channel, int8_t *rssi_p);
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverNHD223.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-03 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the NHD2.23 display driver.
  */
 
@@ -32,6 +32,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include <setjmp.h>
 #include <cmocka.h>
 #include <stdio.h>
+#include <stdbool.h>
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
@@ -68,6 +69,12 @@ void __wrap_driverNHD223_WriteData(uint8_t data)
     check_expected(data);
 }
 
+void __wrap_driverNHD223_WriteDataBlock(const uint8_t *data_p, size_t length)
+{
+    check_expected(length);
+    check_expected_ptr(data_p);
+}
+
 void __wrap_driverNHD223_ResetDisplay(void)
 {
     function_called();
@@ -78,6 +85,16 @@ void __wrap_driverNHD223_SetHorizontalAddressingMode(void)
     function_called();
 }
 
+void __wrap_driverNHD223_SetMultiplexRatio(uint8_t ratio)
+{
+    check_expected(ratio);
+}
+
+void __wrap_driverNHD223_SetRemap(bool remapped)
+{
+    check_expected(remapped);
+}
+
 void __wrap_driverNHD223_SetPageAddress(uint8_t address)
 {
     check_expected(address);
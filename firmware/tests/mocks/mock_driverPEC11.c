@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverPEC11.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for driverPEC11.
  */
 
@@ -63,13 +63,9 @@ void __wrap_driverPEC11_Init(void)
     function_called();
 }
 
-bool __wrap_driverPEC11_PopLeftRotation(void)
+int8_t __wrap_driverPEC11_PopRotation(void)
 {
-    return mock_type(bool);
-}
-bool __wrap_driverPEC11_PopRightRotation(void)
-{
-    return mock_type(bool);
+    return mock_type(int8_t);
 }
 bool __wrap_driverPEC11_PopBriefPush(void)
 {
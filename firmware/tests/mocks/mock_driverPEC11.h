@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverPEC11.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-09-17 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for driverPEC11.
  */
 
@@ -44,8 +44,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 void __wrap_driverPEC11_Init(void);
-bool __wrap_driverPEC11_PopLeftRotation(void);
-bool __wrap_driverPEC11_PopRightRotation(void);
+int8_t __wrap_driverPEC11_PopRotation(void);
 bool __wrap_driverPEC11_PopBriefPush(void);
 bool __wrap_driverPEC11_PopExtendedPush(void);
 
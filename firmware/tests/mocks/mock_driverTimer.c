@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverTimer.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for timer driver.
  */
 
@@ -83,6 +83,11 @@ uint32_t __wrap_driverTimer_GetMilliseconds(void)
     return mock_type(uint32_t);
 }
 
+uint32_t __wrap_driverTimer_GetTicks(void)
+{
+    return mock_type(uint32_t);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
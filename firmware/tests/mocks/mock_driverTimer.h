@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverTimer.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-27 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for timer driver.
  */
 
@@ -46,5 +46,6 @@ void __wrap_driverTimer_Start(void);
 void __wrap_driverTimer_Stop(void);
 void __wrap_driverTimer_Reset(void);
 uint32_t __wrap_driverTimer_GetMilliseconds(void);
+uint32_t __wrap_driverTimer_GetTicks(void);
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverUART.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the driverUART module.
  */
 
@@ -70,6 +70,11 @@ void __wrap_driverUART_StartTx(void)
 {
 }
 
+bool __wrap_driverUART_IsTxIdle(void)
+{
+    return mock_type(bool);
+}
+
 bool __wrap_driverUART_SetBaudRate(uint32_t baud)
 {
     mock_type(bool);
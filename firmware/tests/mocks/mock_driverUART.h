@@ -1,7 +1,7 @@
 /**
  * @file   mock_driverUART.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2019-06-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the UART module.
  */
 
@@ -48,6 +48,7 @@ void __wrap_driverUART_Init(void) __attribute__((weak));
 void __wrap_driverUART_SetCallbacks(driverUART_isr_callback rx_callback, driverUART_isr_callback tx_callback) __attribute__((weak));
 void __wrap_driverUART_Enable(bool enable) __attribute__((weak));
 void __wrap_driverUART_StartTx(void) __attribute__((weak));
+bool __wrap_driverUART_IsTxIdle(void) __attribute__((weak));
 bool __wrap_driverUART_SetBaudRate(uint32_t baud) __attribute__((weak));
 
 #endif
@@ -1,7 +1,7 @@
 /**
  * @file   mock_libRFM69.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2020-10-21 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for the RFM69HW driver.
  */
 
@@ -233,6 +233,7 @@ void __wrap_libRFM69_Update(void)
 
 void __wrap_libRFM69_SetCarrierFrequency(uint32_t frequency)
 {
+    check_expected(frequency);
 }
 
 void __wrap_libRFM69_SetPowerAmplifierMode(uint8_t mode)
@@ -1,8 +1,8 @@
 /**
  * @file   mock_libSPI.c
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2021-02-13 (Last edit)
- * @brief  Mock functions.
+ * @date   2026-10-18 (Last edit)
+ * @brief  Mock functions for the SPI driver.
  */
 
 /*
@@ -34,7 +34,7 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdio.h>
 #include <string.h>
 
-#include "libSPI.h"
+#include "mock_libSPI.h"
 
 //////////////////////////////////////////////////////////////////////////
 //DEFINES
@@ -48,6 +48,9 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //VARIABLES
 //////////////////////////////////////////////////////////////////////////
 
+static struct libSPI_transaction_t *pending_head_p;
+static struct libSPI_transaction_t *pending_tail_p;
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTION PROTOTYPES
 //////////////////////////////////////////////////////////////////////////
@@ -82,6 +85,82 @@ void __wrap_libSPI_Read(void *data_p, size_t length, libSPI_callback_type pre_ca
     memcpy(data_p, mock_data_p, length);
 }
 
+void __wrap_libSPI_Submit(struct libSPI_transaction_t *transaction_p)
+{
+    assert_non_null(transaction_p);
+
+    const size_t length = transaction_p->length;
+    check_expected(length);
+
+    transaction_p->done = false;
+    transaction_p->next_p = NULL;
+
+    if (pending_head_p == NULL)
+    {
+        pending_head_p = transaction_p;
+    }
+    else
+    {
+        pending_tail_p->next_p = transaction_p;
+    }
+    pending_tail_p = transaction_p;
+}
+
+bool __wrap_libSPI_IsDone(const struct libSPI_transaction_t *transaction_p)
+{
+    assert_non_null(transaction_p);
+
+    return transaction_p->done;
+}
+
+void __wrap_libSPI_Wait(const struct libSPI_transaction_t *transaction_p)
+{
+    assert_non_null(transaction_p);
+
+    while (!transaction_p->done)
+    {
+        assert_true(mock_libSPI_CompleteTransaction());
+    }
+}
+
+bool __wrap_libSPI_IsIdle(void)
+{
+    return pending_head_p == NULL;
+}
+
+bool mock_libSPI_CompleteTransaction(void)
+{
+    struct libSPI_transaction_t *transaction_p = pending_head_p;
+
+    if (transaction_p == NULL)
+    {
+        return false;
+    }
+
+    pending_head_p = transaction_p->next_p;
+
+    if (transaction_p->rx_p != NULL)
+    {
+        const uint8_t *mock_data_p = mock_ptr_type(uint8_t *);
+        memcpy(transaction_p->rx_p, mock_data_p, transaction_p->length);
+    }
+
+    transaction_p->done = true;
+
+    if (transaction_p->complete_callback != NULL)
+    {
+        transaction_p->complete_callback(transaction_p);
+    }
+
+    return true;
+}
+
+void mock_libSPI_Reset(void)
+{
+    pending_head_p = NULL;
+    pending_tail_p = NULL;
+}
+
 void __wrap_libSPI_SetAsMaster(void)
 {
 }
@@ -90,6 +169,14 @@ void __wrap_libSPI_SetMode(uint8_t mode)
 {
 }
 
+void __wrap_libSPI_SetClockDivider(libSPI_clock_divider_type clock_divider)
+{
+}
+
+void __wrap_libSPI_SetProfile(const struct libSPI_profile_t *profile_p)
+{
+}
+
 //////////////////////////////////////////////////////////////////////////
 //LOCAL FUNCTIONS
 //////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,78 @@
+/**
+ * @file   mock_libSPI.h
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Mock functions for the SPI driver.
+ */
+
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WRAP_LIBSPI_H_
+#define WRAP_LIBSPI_H_
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include "libSPI.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+void __wrap_libSPI_Init(uint8_t spi_mode);
+void __wrap_libSPI_WriteByte(uint8_t data, libSPI_callback_type pre_callback, libSPI_callback_type post_callback);
+void __wrap_libSPI_Write(const void *data_p, size_t length, libSPI_callback_type pre_callback, libSPI_callback_type post_callback);
+void __wrap_libSPI_ReadByte(uint8_t *data_p, libSPI_callback_type pre_callback, libSPI_callback_type post_callback);
+void __wrap_libSPI_Read(void *data_p, size_t length, libSPI_callback_type pre_callback, libSPI_callback_type post_callback);
+void __wrap_libSPI_Submit(struct libSPI_transaction_t *transaction_p);
+bool __wrap_libSPI_IsDone(const struct libSPI_transaction_t *transaction_p);
+void __wrap_libSPI_Wait(const struct libSPI_transaction_t *transaction_p);
+bool __wrap_libSPI_IsIdle(void);
+void __wrap_libSPI_SetAsMaster(void);
+void __wrap_libSPI_SetMode(uint8_t mode);
+void __wrap_libSPI_SetClockDivider(libSPI_clock_divider_type clock_divider);
+void __wrap_libSPI_SetProfile(const struct libSPI_profile_t *profile_p);
+
+/**
+ * Complete the oldest submitted transaction.
+ *
+ * The receive buffer, if any, is filled with data supplied with
+ * will_return(mock_libSPI_CompleteTransaction, data_p) and the completion
+ * callback is executed, just like the SPI interrupt would do.
+ *
+ * @return True if a transaction was completed, false if none was pending.
+ */
+bool mock_libSPI_CompleteTransaction(void);
+
+/**
+ * Drop all pending transactions without completing them.
+ */
+void mock_libSPI_Reset(void);
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file   mock_libUI.h
  * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
- * @date   2018-09-18 (Last edit)
+ * @date   2026-10-18 (Last edit)
  * @brief  Mock functions for libUI.
  */
 
@@ -42,10 +42,20 @@ along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
 //////////////////////////////////////////////////////////////////////////
 
 void __wrap_libUI_Update(void);
-void __wrap_libUI_PrintText(const char *buffer, uint8_t x_pos, uint8_t y_pos);
-void __wrap_libUI_Print_P(const char *text, uint8_t x_pos, uint8_t y_pos, ...);
+void __wrap_libUI_Clear(void);
+uint8_t __wrap_libUI_PrintText(const char *buffer, uint8_t x_pos, uint8_t y_pos);
+uint8_t __wrap_libUI_PrintText_P(const char *text, uint8_t x_pos, uint8_t y_pos);
+uint8_t __wrap_libUI_PrintUnsigned(uint32_t value, uint8_t min_digits, uint8_t x_pos, uint8_t y_pos);
+uint8_t __wrap_libUI_PrintSigned(int32_t value, uint8_t x_pos, uint8_t y_pos);
+uint8_t __wrap_libUI_PrintHex(uint32_t value, uint8_t min_digits, uint8_t x_pos, uint8_t y_pos);
+uint8_t __wrap_libUI_PrintFixedPoint(int32_t value, uint8_t x_pos, uint8_t y_pos);
 void __wrap_libUI_DrawLine(uint8_t x_start, uint8_t y_start, uint8_t x_end, uint8_t y_end);
+void __wrap_libUI_DrawHorizontalLine(uint8_t x_pos, uint8_t y_pos, uint8_t length);
+void __wrap_libUI_DrawVerticalLine(uint8_t x_pos, uint8_t y_pos, uint8_t length);
 void __wrap_libUI_DrawRectangle(uint8_t x_start, uint8_t y_start, uint8_t width, uint8_t height);
+void __wrap_libUI_FillRectangle(uint8_t x_pos, uint8_t y_pos, uint8_t width, uint8_t height);
+void __wrap_libUI_InvertRectangle(uint8_t x_pos, uint8_t y_pos, uint8_t width, uint8_t height);
+void __wrap_libUI_DrawIcon_P(const uint8_t *icon_p, uint8_t x_pos, uint8_t y_pos);
 void __wrap_libUI_DrawCircle(uint8_t x_pos, uint8_t y_pos, uint8_t radius);
 
 #endif
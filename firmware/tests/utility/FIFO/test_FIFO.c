@@ -205,6 +205,94 @@ void test_FIFO_Peek_NonEmpty(void **state)
     assert_false(FIFO_IsEmpty(&fifo));
 }
 
+void test_FIFO_Discard_NULL(void **state)
+{
+    expect_assert_failure(FIFO_Discard(NULL));
+}
+
+void test_FIFO_Discard_Empty(void **state)
+{
+    uint8_t buffer[8];
+    struct fifo_t fifo = FIFO_New(buffer);
+
+    // We expect false when discarding from a empty FIFO.
+    assert_false(FIFO_Discard(&fifo));
+}
+
+void test_FIFO_Discard_NonEmpty(void **state)
+{
+    uint8_t buffer[8];
+    uint8_t item;
+    struct fifo_t fifo = FIFO_New(buffer);
+    FillBuffer(&fifo, 2);
+
+    assert_true(FIFO_Discard(&fifo));
+
+    // The oldest item should be gone and the next one should be first.
+    assert_true(FIFO_Pop(&fifo, &item));
+    assert_int_equal(1, item);
+    assert_true(FIFO_IsEmpty(&fifo));
+}
+
+void test_FIFO_At_NULL(void **state)
+{
+    expect_assert_failure(FIFO_At(NULL, 0));
+}
+
+void test_FIFO_At_Empty(void **state)
+{
+    uint8_t buffer[8];
+    struct fifo_t fifo = FIFO_New(buffer);
+
+    assert_null(FIFO_At(&fifo, 0));
+}
+
+void test_FIFO_At_Wrapped(void **state)
+{
+    uint8_t buffer[4];
+    uint8_t item;
+    struct fifo_t fifo = FIFO_New(buffer);
+
+    // Move the tail so that the items wraps around the end of the buffer.
+    FillBuffer(&fifo, 3);
+    FIFO_Pop(&fifo, &item);
+    FIFO_Pop(&fifo, &item);
+    item = 0xAA;
+    FIFO_Push(&fifo, &item);
+    item = 0xBB;
+    FIFO_Push(&fifo, &item);
+
+    assert_int_equal(*(uint8_t *)FIFO_At(&fifo, 0), 2);
+    assert_int_equal(*(uint8_t *)FIFO_At(&fifo, 1), 0xAA);
+    assert_int_equal(*(uint8_t *)FIFO_At(&fifo, 2), 0xBB);
+    assert_null(FIFO_At(&fifo, 3));
+
+    // Modify an item in place.
+    *(uint8_t *)FIFO_At(&fifo, 1) = 0xCC;
+    FIFO_Pop(&fifo, &item);
+    FIFO_Pop(&fifo, &item);
+    assert_int_equal(item, 0xCC);
+}
+
+void test_FIFO_Count_NULL(void **state)
+{
+    expect_assert_failure(FIFO_Count(NULL));
+}
+
+void test_FIFO_Count(void **state)
+{
+    uint8_t buffer[8];
+    struct fifo_t fifo = FIFO_New(buffer);
+
+    assert_int_equal(FIFO_Count(&fifo), 0);
+
+    FillBuffer(&fifo, 3);
+    assert_int_equal(FIFO_Count(&fifo), 3);
+
+    FIFO_Discard(&fifo);
+    assert_int_equal(FIFO_Count(&fifo), 2);
+}
+
 void test_FIFO_IsEmpty_NULL(void **state)
 {
     expect_assert_failure(FIFO_IsEmpty(NULL));
@@ -325,6 +413,14 @@ int main(int argc, char *argv[])
         cmocka_unit_test(test_FIFO_Peek_NULL_arguments),
         cmocka_unit_test(test_FIFO_Peek_Empty),
         cmocka_unit_test(test_FIFO_Peek_NonEmpty),
+        cmocka_unit_test(test_FIFO_Discard_NULL),
+        cmocka_unit_test(test_FIFO_Discard_Empty),
+        cmocka_unit_test(test_FIFO_Discard_NonEmpty),
+        cmocka_unit_test(test_FIFO_At_NULL),
+        cmocka_unit_test(test_FIFO_At_Empty),
+        cmocka_unit_test(test_FIFO_At_Wrapped),
+        cmocka_unit_test(test_FIFO_Count_NULL),
+        cmocka_unit_test(test_FIFO_Count),
         cmocka_unit_test(test_FIFO_IsEmpty_NULL),
         cmocka_unit_test(test_FIFO_IsEmpty_Empty),
         cmocka_unit_test(test_FIFO_IsEmpty_Full),
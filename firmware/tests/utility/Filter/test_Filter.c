@@ -0,0 +1,328 @@
+/**
+ * @file   test_Filter.c
+ * @Author Andreas Dahlberg (andreas.dahlberg90@gmail.com)
+ * @date   2026-10-18 (Last edit)
+ * @brief  Test suite for the Filter utility.
+ */
+
+/*
+This file is part of SillyCat firmware.
+
+SillyCat firmware is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+SillyCat firmware is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with SillyCat firmware.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+//////////////////////////////////////////////////////////////////////////
+//INCLUDES
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "Filter.h"
+
+//////////////////////////////////////////////////////////////////////////
+//DEFINES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//TYPE DEFINITIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//VARIABLES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTION PROTOTYPES
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//LOCAL FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////
+//TESTS
+//////////////////////////////////////////////////////////////////////////
+
+static void test_Filter_Process(void **state)
+{
+    struct filter_t filter = {0};
+
+    assert_false(Filter_IsInitialized(&filter));
+
+    Filter_Init(&filter, 100, FILTER_ALPHA(0.5));
+    assert_true(Filter_IsInitialized(&filter));
+    assert_int_equal(Filter_Output(&filter), 100);
+
+    Filter_Process(&filter, 200);
+    assert_int_equal(Filter_Output(&filter), 150);
+}
+
+static void test_Filter_ShiftInit_InvalidArguments(void **state)
+{
+    struct filter_shift_t filter;
+
+    expect_assert_failure(Filter_ShiftInit(NULL, 0, 1));
+    expect_assert_failure(Filter_ShiftInit(&filter, 0, FILTER_SHIFT_MAX + 1));
+}
+
+static void test_Filter_ShiftInit(void **state)
+{
+    struct filter_shift_t filter = {0};
+
+    assert_false(Filter_ShiftIsInitialized(&filter));
+
+    Filter_ShiftInit(&filter, -250, 3);
+    assert_true(Filter_ShiftIsInitialized(&filter));
+    assert_int_equal(Filter_ShiftOutput(&filter), -250);
+}
+
+static void test_Filter_ShiftProcess(void **state)
+{
+    struct filter_shift_t filter;
+
+    Filter_ShiftInit(&filter, 0, 2);
+
+    /* Each sample moves the output a quarter of the remaining distance. */
+    Filter_ShiftProcess(&filter, 400);
+    assert_int_equal(Filter_ShiftOutput(&filter), 100);
+
+    Filter_ShiftProcess(&filter, 400);
+    assert_int_equal(Filter_ShiftOutput(&filter), 175);
+
+    for (size_t i = 0; i < 100; ++i)
+    {
+        Filter_ShiftProcess(&filter, 400);
+    }
+
+    assert_int_equal(Filter_ShiftOutput(&filter), 400);
+}
+
+static void test_Filter_ShiftProcess_Negative(void **state)
+{
+    struct filter_shift_t filter;
+
+    Filter_ShiftInit(&filter, 100, FILTER_SHIFT_MAX);
+
+    for (size_t i = 0; i < 4000; ++i)
+    {
+        Filter_ShiftProcess(&filter, -100);
+    }
+
+    assert_int_equal(Filter_ShiftOutput(&filter), -100);
+}
+
+static void test_Filter_ShiftProcess_NoShift(void **state)
+{
+    struct filter_shift_t filter;
+
+    Filter_ShiftInit(&filter, 0, 0);
+
+    Filter_ShiftProcess(&filter, INT16_MAX);
+    assert_int_equal(Filter_ShiftOutput(&filter), INT16_MAX);
+
+    Filter_ShiftProcess(&filter, INT16_MIN);
+    assert_int_equal(Filter_ShiftOutput(&filter), INT16_MIN);
+}
+
+static void test_Filter_MedianInit_InvalidArguments(void **state)
+{
+    struct filter_median_t filter;
+
+    expect_assert_failure(Filter_MedianInit(NULL, 0, 3));
+    expect_assert_failure(Filter_MedianInit(&filter, 0, 1));
+    expect_assert_failure(Filter_MedianInit(&filter, 0, 4));
+    expect_assert_failure(Filter_MedianInit(&filter, 0, FILTER_MEDIAN_MAX + 1));
+}
+
+static void test_Filter_MedianProcess_RejectSpike(void **state)
+{
+    struct filter_median_t filter;
+
+    Filter_MedianInit(&filter, 3700, 3);
+    assert_int_equal(Filter_MedianOutput(&filter), 3700);
+
+    Filter_MedianProcess(&filter, 0);
+    assert_int_equal(Filter_MedianOutput(&filter), 3700);
+
+    Filter_MedianProcess(&filter, 3710);
+    assert_int_equal(Filter_MedianOutput(&filter), 3700);
+
+    Filter_MedianProcess(&filter, 3720);
+    assert_int_equal(Filter_MedianOutput(&filter), 3710);
+}
+
+static void test_Filter_MedianProcess_RejectDoubleSpike(void **state)
+{
+    struct filter_median_t filter;
+
+    Filter_MedianInit(&filter, 3700, 5);
+
+    Filter_MedianProcess(&filter, -3000);
+    Filter_MedianProcess(&filter, -3000);
+    assert_int_equal(Filter_MedianOutput(&filter), 3700);
+
+    Filter_MedianProcess(&filter, -3000);
+    assert_int_equal(Filter_MedianOutput(&filter), -3000);
+}
+
+static void test_Filter_MedianProcess_Unordered(void **state)
+{
+    const int16_t samples[] = {5, -1, 3, 9, 2};
+    struct filter_median_t filter;
+
+    Filter_MedianInit(&filter, 0, 5);
+
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i)
+    {
+        Filter_MedianProcess(&filter, samples[i]);
+    }
+
+    assert_int_equal(Filter_MedianOutput(&filter), 3);
+}
+
+static void test_Filter_AverageInit_InvalidArguments(void **state)
+{
+    struct filter_average_t filter;
+    int16_t samples[4];
+
+    expect_assert_failure(Filter_AverageInit(NULL, samples, 2, 0));
+    expect_assert_failure(Filter_AverageInit(&filter, NULL, 2, 0));
+    expect_assert_failure(Filter_AverageInit(&filter, samples, FILTER_SHIFT_MAX + 1, 0));
+}
+
+static void test_Filter_AverageProcess(void **state)
+{
+    struct filter_average_t filter;
+    int16_t samples[4];
+
+    Filter_AverageInit(&filter, samples, 2, 10);
+    assert_int_equal(Filter_AverageOutput(&filter), 10);
+
+    Filter_AverageProcess(&filter, 30);
+    assert_int_equal(Filter_AverageOutput(&filter), 15);
+
+    Filter_AverageProcess(&filter, 30);
+    Filter_AverageProcess(&filter, 30);
+    Filter_AverageProcess(&filter, 30);
+    assert_int_equal(Filter_AverageOutput(&filter), 30);
+
+    /* The window wraps around, the oldest sample is replaced. */
+    Filter_AverageProcess(&filter, -30);
+    assert_int_equal(Filter_AverageOutput(&filter), 15);
+}
+
+static void test_Filter_AverageProcess_Rounding(void **state)
+{
+    struct filter_average_t filter;
+    int16_t samples[2];
+
+    Filter_AverageInit(&filter, samples, 1, 0);
+
+    Filter_AverageProcess(&filter, 3);
+    assert_int_equal(Filter_AverageOutput(&filter), 2);
+
+    Filter_AverageProcess(&filter, 4);
+    assert_int_equal(Filter_AverageOutput(&filter), 4);
+}
+
+static void test_Filter_AverageProcess_LargeWindow(void **state)
+{
+    struct filter_average_t filter;
+    int16_t samples[1 << FILTER_SHIFT_MAX];
+
+    Filter_AverageInit(&filter, samples, FILTER_SHIFT_MAX, INT16_MAX);
+
+    for (size_t i = 0; i < (1 << FILTER_SHIFT_MAX) - 1; ++i)
+    {
+        Filter_AverageProcess(&filter, INT16_MIN);
+    }
+
+    assert_int_equal(Filter_AverageOutput(&filter), INT16_MIN + 256);
+
+    Filter_AverageProcess(&filter, INT16_MIN);
+    assert_int_equal(Filter_AverageOutput(&filter), INT16_MIN);
+}
+
+static void test_Filter_CascadeProcess_InvalidArguments(void **state)
+{
+    struct filter_shift_t shift;
+    const struct filter_stage_t stages[] = {FILTER_STAGE_SHIFT(&shift)};
+
+    expect_assert_failure(Filter_CascadeProcess(NULL, 1, 0));
+    expect_assert_failure(Filter_CascadeProcess(stages, 0, 0));
+}
+
+static void test_Filter_CascadeProcess(void **state)
+{
+    struct filter_median_t median;
+    struct filter_average_t average;
+    struct filter_shift_t shift;
+    int16_t samples[2];
+
+    const struct filter_stage_t stages[] =
+    {
+        FILTER_STAGE_MEDIAN(&median),
+        FILTER_STAGE_AVERAGE(&average),
+        FILTER_STAGE_SHIFT(&shift)
+    };
+
+    Filter_MedianInit(&median, 100, 3);
+    Filter_AverageInit(&average, samples, 1, 100);
+    Filter_ShiftInit(&shift, 100, 1);
+
+    /* The spike is removed by the median before reaching the other stages. */
+    assert_int_equal(Filter_CascadeProcess(stages, 3, 1000), 100);
+
+    /* Median 200, average 150, EMA halfway from 100 to 150. */
+    assert_int_equal(Filter_CascadeProcess(stages, 3, 200), 125);
+}
+
+//////////////////////////////////////////////////////////////////////////
+//FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char *argv[])
+{
+    const struct CMUnitTest tests[] =
+    {
+        cmocka_unit_test(test_Filter_Process),
+        cmocka_unit_test(test_Filter_ShiftInit_InvalidArguments),
+        cmocka_unit_test(test_Filter_ShiftInit),
+        cmocka_unit_test(test_Filter_ShiftProcess),
+        cmocka_unit_test(test_Filter_ShiftProcess_Negative),
+        cmocka_unit_test(test_Filter_ShiftProcess_NoShift),
+        cmocka_unit_test(test_Filter_MedianInit_InvalidArguments),
+        cmocka_unit_test(test_Filter_MedianProcess_RejectSpike),
+        cmocka_unit_test(test_Filter_MedianProcess_RejectDoubleSpike),
+        cmocka_unit_test(test_Filter_MedianProcess_Unordered),
+        cmocka_unit_test(test_Filter_AverageInit_InvalidArguments),
+        cmocka_unit_test(test_Filter_AverageProcess),
+        cmocka_unit_test(test_Filter_AverageProcess_Rounding),
+        cmocka_unit_test(test_Filter_AverageProcess_LargeWindow),
+        cmocka_unit_test(test_Filter_CascadeProcess_InvalidArguments),
+        cmocka_unit_test(test_Filter_CascadeProcess),
+    };
+
+    if (argc >= 2)
+    {
+        cmocka_set_test_filter(argv[1]);
+    }
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
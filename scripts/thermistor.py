@@ -14,6 +14,8 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+import argparse
+import datetime
 import math
 
 # All temperatures are in kelvin if nothing else is specified.
@@ -23,6 +25,13 @@ T0 = 298.15
 R2 = 10000.0
 VIN = 3.3
 
+# Thermistors in a voltage divider with R2 to ground. Each one gets a
+# breakpoint table covering the given range of 10-bit ADC values.
+THERMISTORS = [
+    {'name': 'GENERIC', 'b': B, 'r0': R0, 't0': T0, 'r2': R2, 'adc_range': (120, 938)},
+    {'name': 'MF52', 'b': 3950.0, 'r0': 10000.0, 't0': 298.15, 'r2': 10000.0, 'adc_range': (147, 965)},
+]
+
 
 def kelvin_to_celsius(temperature):
     assert temperature >= -273.15
@@ -36,6 +45,15 @@ def adc_value_to_voltage(adc_value):
     return VIN / 1023.0 * adc_value
 
 
+def adc_value_to_temperature(adc_value, thermistor):
+    """Temperature in celsius for a, possibly fractional, 10-bit ADC value."""
+    rinf = thermistor['r0'] * math.pow(math.e, -thermistor['b'] / thermistor['t0'])
+    divider_voltage = adc_value_to_voltage(adc_value)
+    ri = VIN * thermistor['r2'] / divider_voltage - thermistor['r2']
+
+    return kelvin_to_celsius(thermistor['b'] / math.log(ri / rinf))
+
+
 def create_lookup_table(start, stop, step):
     rinf = R0 * math.pow(math.e, -B / T0)
 
@@ -62,6 +80,47 @@ def create_lookup_table(start, stop, step):
     return lut
 
 
+def interpolate(start, end, value):
+    """Same fixed-point interpolation as the firmware, start <= value <= end."""
+    x0, y0 = start
+    x1, y1 = end
+    dx = x1 - x0
+
+    if dx == 0:
+        return y0
+
+    return y0 + ((y1 - y0) * (value - x0) + dx // 2) // dx
+
+
+def create_breakpoints(thermistor, extra_bits, max_error):
+    """Greedily create the fewest piecewise linear segments, in tenths of a
+    degree, that stay within max_error of the model for every oversampled
+    ADC value in the range."""
+    scale = 1 << extra_bits
+    first = thermistor['adc_range'][0] * scale
+    last = thermistor['adc_range'][1] * scale + scale - 1
+
+    exact = {x: adc_value_to_temperature(x / scale, thermistor) * 10 for x in range(first, last + 1)}
+    point = lambda x: (x, round(exact[x]))
+
+    def fits(start, end):
+        return all(abs(interpolate(start, end, x) - exact[x]) <= max_error * 10
+                   for x in range(start[0], end[0] + 1))
+
+    breakpoints = [point(first)]
+
+    while breakpoints[-1][0] < last:
+        start = breakpoints[-1]
+        end = start[0] + 1
+
+        while end < last and fits(start, point(end + 1)):
+            end = end + 1
+
+        breakpoints.append(point(end))
+
+    return breakpoints
+
+
 def print_lut_stats(lut):
     print('-----------------------')
     print('Lookup table statistics')
@@ -70,10 +129,70 @@ def print_lut_stats(lut):
     print('Range: {:.1f} °C to {:.1f} °C'.format(min(lut) / 10, max(lut) / 10))
 
 
+def generate_file(data, template):
+    with open(template, 'r') as template_file:
+        template_data = template_file.read()
+
+    return template_data.format(**data)
+
+
+def generate(args):
+    now = datetime.datetime.now()
+    breakpoint_lines = []
+    first_lines = []
+    type_lines = []
+    nr_breakpoints = 0
+
+    for thermistor in THERMISTORS:
+        breakpoints = create_breakpoints(thermistor, args.extra_bits, args.max_error)
+
+        type_lines.append('    NTC_TYPE_{},\n'.format(thermistor['name']))
+        first_lines.append('    {}, // {}\n'.format(nr_breakpoints, thermistor['name']))
+        breakpoint_lines.append('    // {}, B = {:.0f} K\n'.format(thermistor['name'], thermistor['b']))
+
+        for adc_value, temperature in breakpoints:
+            breakpoint_lines.append('    {{{}, {}}},\n'.format(adc_value, temperature))
+
+        nr_breakpoints = nr_breakpoints + len(breakpoints)
+
+    first_lines.append('    {}\n'.format(nr_breakpoints))
+
+    data = {}
+    data['author'] = 'Andreas Dahlberg'
+    data['date'] = now.strftime("%Y-%m-%d %H:%M")
+    data['brief'] = 'NTC thermistor breakpoint tables.'
+    data['extra_bits'] = args.extra_bits
+    data['nr_breakpoints'] = nr_breakpoints
+    data['ntc_types'] = ''.join(type_lines)
+    data['breakpoints'] = ''.join(breakpoint_lines)
+    data['table_first'] = ''.join(first_lines)
+
+    content = generate_file(data, args.template)
+    with open(args.output, 'w') as f:
+        f.write(content)
+
+    return 0
+
+
 def _main():
-    lut = create_lookup_table(120, 939, 1)
-    print_lut_stats(lut)
+    parser = argparse.ArgumentParser(
+        description='Print a thermistor lookup table, or generate breakpoint tables from a template.')
+    parser.add_argument('template', nargs='?', help='Template for the generated file.')
+    parser.add_argument('output', nargs='?', help='Path of the generated file.')
+    parser.add_argument('-e', '--extra-bits', type=int, default=2,
+        help='Bits of oversampling in the ADC values used as table input.')
+    parser.add_argument('-m', '--max-error', type=float, default=0.1,
+        help='Largest allowed interpolation error in degrees celsius.')
+
+    args = parser.parse_args()
+
+    if args.template is None or args.output is None:
+        lut = create_lookup_table(120, 939, 1)
+        print_lut_stats(lut)
+        return 0
+
+    return generate(args)
 
 
 if __name__ == '__main__':
-    _main()
+    exit(_main())
@@ -32,6 +32,41 @@ VRAM_COLUMNS = 128
 VRAM_SIZE = (VRAM_PAGES * VRAM_COLUMNS)
 
 
+def decode_compressed_vram(payload, vram):
+    """Apply a compressed <VRZ> frame payload to a VRAM bytearray.
+
+    The payload starts with a page mask, bit n set if page n is included.
+    Each included page is run length coded, a zero byte is followed by the
+    length of the zero run and all other bytes are literals. Pages that are
+    not included are left unchanged.
+    """
+    page_mask = payload[0]
+    index = 1
+
+    for page in range(VRAM_PAGES):
+        if not page_mask & (1 << page):
+            continue
+
+        column = page * VRAM_COLUMNS
+        end = column + VRAM_COLUMNS
+        while column < end:
+            data = payload[index]
+            index += 1
+            if data == 0:
+                run = payload[index]
+                index += 1
+                vram[column:column + run] = bytes(run)
+                column += run
+            else:
+                vram[column] = data
+                column += 1
+
+        if column != end:
+            raise ValueError('Page {} decoded to wrong length'.format(page))
+
+    return vram
+
+
 def create_bitmap_image(rows, w):
     mult4 = lambda n: int(math.ceil(n / 4)) * 4
     mult8 = lambda n: int(math.ceil(n / 8)) * 8
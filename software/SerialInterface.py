@@ -22,6 +22,7 @@ import glob
 import serial
 from PyQt5 import QtCore
 from DevToolUtil import platform_is_windows
+from DisplayView import VRAM_SIZE, decode_compressed_vram
 
 __author__ = 'andreas.dahlberg90@gmail.com (Andreas Dahlberg)'
 __version__ = '0.1.0'
@@ -39,6 +40,7 @@ class SerialInterface(QtCore.QThread):
         QtCore.QThread.__init__(self)
         self._running = False
         self._ser = None
+        self._vram = bytearray(VRAM_SIZE)
 
     def open_port(self, port, baudrate, timeout=0.1):
         """Connect the interface to a serial port"""
@@ -75,7 +77,10 @@ class SerialInterface(QtCore.QThread):
             if rx_data:
                 if rx_data[:6] == b'<VRAM>':
                     rx_data += (self._ser.read(520 - len(rx_data)))
-                    self.new_vram.emit(rx_data[6:-2])
+                    self._vram[:] = rx_data[6:-2]
+                    self.new_vram.emit(bytes(self._vram))
+                elif rx_data[:5] == b'<VRZ>':
+                    self.read_compressed_vram(rx_data)
                 elif rx_data[:5] == b'<PCK>':
                     self.new_pck.emit(rx_data[5:].decode('utf-8').rstrip('\r\n'))
                 else:
@@ -85,6 +90,24 @@ class SerialInterface(QtCore.QThread):
                         pass
         self.exit_cleanup()
 
+    def read_compressed_vram(self, rx_data):
+        """Read the rest of a compressed frame and emit the updated VRAM"""
+        header_size = 7
+        if len(rx_data) < header_size:
+            rx_data += self._ser.read(header_size - len(rx_data))
+
+        length = rx_data[5] | (rx_data[6] << 8)
+        frame_size = header_size + length + 2
+        rx_data += self._ser.read(frame_size - len(rx_data))
+        if len(rx_data) != frame_size:
+            return
+
+        try:
+            decode_compressed_vram(rx_data[header_size:-2], self._vram)
+        except (IndexError, ValueError):
+            return
+        self.new_vram.emit(bytes(self._vram))
+
     def stop(self):
         """Stop listen for new data and kill thread"""
         self._running = False